@@ -0,0 +1,1021 @@
+#include "my_vector.h"
+#include "bit_vector.h"
+#include "concurrent_vector.h"
+#include "cow_vector.h"
+#include "my_vector_default_init_allocator.h"
+#include "my_vector_mmap_allocator.h"
+#include "my_vector_parallel.h"
+#include "my_vector_simd.h"
+#include "segmented_vector.h"
+#include "soa_vector.h"
+#include "static_vector.h"
+#include "test-object.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+// test_object only owns a pointer, so moving its bytes is a valid move.
+template <>
+struct my_vector::is_trivially_relocatable<test_object> : std::true_type
+{};
+
+namespace vector_bench
+{
+	using clock_type = std::chrono::steady_clock;
+
+	// Best wall time of several runs, in seconds
+	template <class F>
+	double measure_seconds(F&& body, int repeats)
+	{
+		double best = 0;
+		for (int i = 0; i < repeats; ++i)
+		{
+			const auto start = clock_type::now();
+			body();
+			const double elapsed = std::chrono::duration<double>(clock_type::now() - start).count();
+			if (i == 0 || elapsed < best)
+			{
+				best = elapsed;
+			}
+		}
+		return best;
+	}
+
+	// As above, but each run gets fresh state from setup; building and destroying it is not timed
+	template <class Setup, class F>
+	double measure_seconds(Setup&& setup, F&& body, int repeats)
+	{
+		double best = 0;
+		for (int i = 0; i < repeats; ++i)
+		{
+			auto state = setup();
+			const auto start = clock_type::now();
+			body(state);
+			const double elapsed = std::chrono::duration<double>(clock_type::now() - start).count();
+			if (i == 0 || elapsed < best)
+			{
+				best = elapsed;
+			}
+		}
+		return best;
+	}
+
+	// Keeps the optimizer from discarding a computed value
+	template <class T>
+	void do_not_optimize(const T& value)
+	{
+		asm volatile("" : : "r,m"(value) : "memory");
+	}
+
+	// Collects results and prints them as one JSON document:
+	// {"results": [{"benchmark", "container", "element", "size", "seconds", "ns_per_op"}, ...]}
+	// Results measured with a stats policy also carry "reallocations", "bytes_allocated",
+	// "peak_capacity" and "slack_bytes".
+	class json_report
+	{
+		bool first_ = true;
+
+	public:
+		json_report()
+		{
+			std::printf("{\n  \"results\": [");
+		}
+
+		~json_report()
+		{
+			std::printf("\n  ]\n}\n");
+		}
+
+		json_report(const json_report&) = delete;
+		json_report& operator=(const json_report&) = delete;
+
+		// ops is what ns_per_op divides by: elements touched, or accesses made
+		void add(const char* benchmark, const char* container, const char* element, size_t ops, double seconds)
+		{
+			begin(benchmark, container, element, ops, seconds);
+			end();
+		}
+
+		void add(const char* benchmark, const char* container, const char* element, size_t ops, double seconds,
+			const my_vector::vector_stats& memory)
+		{
+			begin(benchmark, container, element, ops, seconds);
+			std::printf(", \"reallocations\": %llu, \"bytes_allocated\": %llu, \"peak_capacity\": %zu, \"slack_bytes\": %zu",
+				static_cast<unsigned long long>(memory.reallocations), static_cast<unsigned long long>(memory.bytes_allocated),
+				memory.peak_capacity, memory.slack_bytes);
+			end();
+		}
+
+	private:
+		void begin(const char* benchmark, const char* container, const char* element, size_t ops, double seconds)
+		{
+			std::printf("%s\n    {\"benchmark\": \"%s\", \"container\": \"%s\", \"element\": \"%s\", "
+				"\"size\": %zu, \"seconds\": %.9f, \"ns_per_op\": %.4f",
+				first_ ? "" : ",", benchmark, container, element, ops, seconds,
+				seconds * 1e9 / static_cast<double>(ops == 0 ? 1 : ops));
+		}
+
+		void end()
+		{
+			std::printf("}");
+			std::fflush(stdout);
+			first_ = false;
+		}
+	};
+
+	struct pod64
+	{
+		uint64_t words[8];
+	};
+	static_assert(sizeof(pod64) == 64);
+
+	template <class T>
+	struct element_traits;
+
+	template <>
+	struct element_traits<int>
+	{
+		static constexpr const char* name = "int";
+
+		static int make(size_t i)
+		{
+			return static_cast<int>(i);
+		}
+
+		static uint64_t key(int value)
+		{
+			return static_cast<uint64_t>(value);
+		}
+	};
+
+	template <>
+	struct element_traits<pod64>
+	{
+		static constexpr const char* name = "pod64";
+
+		static pod64 make(size_t i)
+		{
+			pod64 result{};
+			result.words[0] = i;
+			return result;
+		}
+
+		static uint64_t key(const pod64& value)
+		{
+			return value.words[0];
+		}
+	};
+
+	template <>
+	struct element_traits<test_object>
+	{
+		static constexpr const char* name = "test_object";
+
+		static test_object make(size_t i)
+		{
+			return test_object(static_cast<int>(i));
+		}
+
+		static uint64_t key(const test_object& value)
+		{
+			return static_cast<uint64_t>(*value.get_id());
+		}
+	};
+
+	template <class Container>
+	struct container_traits;
+
+	template <class T>
+	struct container_traits<my_vector::vector<T>>
+	{
+		using element_type = T;
+		static constexpr const char* name = "my_vector";
+	};
+
+	template <class T>
+	struct container_traits<std::vector<T>>
+	{
+		using element_type = T;
+		static constexpr const char* name = "std::vector";
+	};
+
+	template <class Container>
+	Container make_filled(size_t count)
+	{
+		using element = element_traits<typename container_traits<Container>::element_type>;
+		Container result;
+		result.reserve(count);
+		for (size_t i = 0; i < count; ++i)
+		{
+			result.push_back(element::make(i));
+		}
+		return result;
+	}
+
+	// Runs every container case for one container type
+	template <class Container>
+	void bench_container(json_report& report, size_t count, const std::vector<size_t>& indices)
+	{
+		using T = typename container_traits<Container>::element_type;
+		using element = element_traits<T>;
+		const char* container = container_traits<Container>::name;
+		constexpr int repeats = 5;
+
+		const auto record = [&](const char* benchmark, size_t ops, double seconds)
+		{
+			report.add(benchmark, container, element::name, ops, seconds);
+		};
+
+		record("push_back_growth", count, measure_seconds([&]
+		{
+			Container vec;
+			for (size_t i = 0; i < count; ++i)
+			{
+				vec.push_back(element::make(i));
+			}
+			do_not_optimize(vec.data());
+		}, repeats));
+
+		record("emplace_back_growth", count, measure_seconds([&]
+		{
+			Container vec;
+			for (size_t i = 0; i < count; ++i)
+			{
+				vec.emplace_back(element::make(i));
+			}
+			do_not_optimize(vec.data());
+		}, repeats));
+
+		record("reserve_fill", count, measure_seconds([&]
+		{
+			Container vec;
+			vec.reserve(count);
+			for (size_t i = 0; i < count; ++i)
+			{
+				vec.push_back(element::make(i));
+			}
+			do_not_optimize(vec.data());
+		}, repeats));
+
+		const Container source = make_filled<Container>(count);
+
+		record("copy_construct", count, measure_seconds([&]
+		{
+			const Container copy(source);
+			do_not_optimize(copy.data());
+		}, repeats));
+
+		// the moved-to vector lives in the state, so destroying the elements is not timed
+		record("move_construct", 1, measure_seconds(
+			[&] { return std::pair<Container, std::optional<Container>>(make_filled<Container>(count), std::nullopt); },
+			[&](std::pair<Container, std::optional<Container>>& state)
+			{
+				state.second.emplace(std::move(state.first));
+				do_not_optimize(state.second->data());
+			}, repeats));
+
+		// the target already holds count elements, so both can reuse its storage
+		record("copy_assign", count, measure_seconds(
+			[&] { return make_filled<Container>(count); },
+			[&](Container& target)
+			{
+				target = source;
+				do_not_optimize(target.data());
+			}, repeats));
+
+		record("iterate", count, measure_seconds([&]
+		{
+			uint64_t sum = 0;
+			for (const T& value : source)
+			{
+				sum += element::key(value);
+			}
+			do_not_optimize(sum);
+		}, repeats));
+
+		record("random_access", indices.size(), measure_seconds([&]
+		{
+			uint64_t sum = 0;
+			for (const size_t index : indices)
+			{
+				sum += element::key(source[index]);
+			}
+			do_not_optimize(sum);
+		}, repeats));
+
+		// half the capacity is spare when shrinking
+		record("shrink_to_fit", count, measure_seconds(
+			[&]
+			{
+				Container vec;
+				vec.reserve(count * 2);
+				for (size_t i = 0; i < count; ++i)
+				{
+					vec.push_back(element::make(i));
+				}
+				return vec;
+			},
+			[&](Container& vec)
+			{
+				vec.shrink_to_fit();
+				do_not_optimize(vec.data());
+			}, repeats));
+	}
+
+	template <class T>
+	void bench_element(json_report& report, size_t count)
+	{
+		std::vector<size_t> indices(count);
+		uint64_t state = 1;
+		for (size_t& index : indices)
+		{
+			state = state * 6364136223846793005ULL + 1442695040888963407ULL;
+			index = (state >> 17) % count;
+		}
+
+		bench_container<my_vector::vector<T>>(report, count, indices);
+		bench_container<std::vector<T>>(report, count, indices);
+	}
+
+	// Latency distribution of single pushes: a contiguous vector occasionally relocates
+	// everything, a segmented one only ever allocates
+	template <class Container>
+	void bench_push_latency(json_report& report, const char* container, size_t count)
+	{
+		using element = element_traits<pod64>;
+		std::vector<double> latencies(count);
+		Container vec;
+		for (size_t i = 0; i < count; ++i)
+		{
+			const auto start = clock_type::now();
+			vec.push_back(element::make(i));
+			latencies[i] = std::chrono::duration<double>(clock_type::now() - start).count();
+		}
+		do_not_optimize(&vec[0]);
+
+		std::sort(latencies.begin(), latencies.end());
+		const auto percentile = [&](double fraction)
+		{
+			return latencies[static_cast<size_t>(fraction * static_cast<double>(count - 1))];
+		};
+		report.add("push_latency_p50", container, element::name, 1, percentile(0.5));
+		report.add("push_latency_p99", container, element::name, 1, percentile(0.99));
+		report.add("push_latency_p99.9", container, element::name, 1, percentile(0.999));
+		report.add("push_latency_max", container, element::name, 1, latencies.back());
+	}
+
+	// Runs body(thread_index) on threads threads at once and returns the wall time
+	template <class F>
+	double run_threads(unsigned threads, F&& body)
+	{
+		std::vector<std::thread> workers;
+		const auto start = clock_type::now();
+		for (unsigned t = 0; t < threads; ++t)
+		{
+			workers.emplace_back(body, t);
+		}
+		for (std::thread& worker : workers)
+		{
+			worker.join();
+		}
+		return std::chrono::duration<double>(clock_type::now() - start).count();
+	}
+
+	// Many threads appending to one shared container: concurrent_vector against a vector
+	// behind a mutex, from one thread up to every hardware thread
+	void bench_concurrent_append(json_report& report, size_t count)
+	{
+		const unsigned max_threads = std::thread::hardware_concurrency() > 0 ? std::thread::hardware_concurrency() : 1;
+		std::vector<unsigned> thread_counts;
+		for (unsigned threads = 1; threads < max_threads; threads *= 2)
+		{
+			thread_counts.push_back(threads);
+		}
+		thread_counts.push_back(max_threads);
+
+		for (const unsigned threads : thread_counts)
+		{
+			const std::string name = "concurrent_append_t" + std::to_string(threads);
+			const size_t per_thread = count / threads;
+
+			double best = 0;
+			for (int repeat = 0; repeat < 3; ++repeat)
+			{
+				my_vector::concurrent_vector<uint64_t> shared;
+				const double elapsed = run_threads(threads, [&](unsigned t)
+				{
+					for (size_t i = 0; i < per_thread; ++i)
+					{
+						shared.emplace_back(uint64_t{ t } << 32 | i);
+					}
+				});
+				best = repeat == 0 || elapsed < best ? elapsed : best;
+			}
+			report.add(name.c_str(), "concurrent_vector", "uint64_t", per_thread * threads, best);
+
+			best = 0;
+			for (int repeat = 0; repeat < 3; ++repeat)
+			{
+				my_vector::vector<uint64_t> shared;
+				std::mutex lock;
+				const double elapsed = run_threads(threads, [&](unsigned t)
+				{
+					for (size_t i = 0; i < per_thread; ++i)
+					{
+						std::lock_guard guard(lock);
+						shared.emplace_back(uint64_t{ t } << 32 | i);
+					}
+				});
+				best = repeat == 0 || elapsed < best ? elapsed : best;
+			}
+			report.add(name.c_str(), "mutex+my_vector", "uint64_t", per_thread * threads, best);
+		}
+	}
+
+	// Sequential algorithms against their my_vector::par versions on the default pool
+	void bench_parallel(json_report& report, size_t count)
+	{
+		my_vector::vector<uint64_t> source;
+		source.reserve(count);
+		uint64_t state = 1;
+		for (size_t i = 0; i < count; ++i)
+		{
+			state = state * 6364136223846793005ULL + 1442695040888963407ULL;
+			source.push_back(state >> 11);
+		}
+		my_vector::vector<uint64_t> vec = source;
+
+		report.add("fill", "sequential", "uint64_t", count, measure_seconds([&]
+		{
+			std::fill(vec.begin(), vec.end(), uint64_t{ 7 });
+			do_not_optimize(vec.data());
+		}, 5));
+		report.add("fill", "par", "uint64_t", count, measure_seconds([&]
+		{
+			my_vector::par::fill(vec, uint64_t{ 7 });
+			do_not_optimize(vec.data());
+		}, 5));
+
+		report.add("reduce", "sequential", "uint64_t", count, measure_seconds([&]
+		{
+			uint64_t sum = 0;
+			for (const uint64_t value : source)
+			{
+				sum += value;
+			}
+			do_not_optimize(sum);
+		}, 5));
+		report.add("reduce", "par", "uint64_t", count, measure_seconds([&]
+		{
+			do_not_optimize(my_vector::par::reduce(source, uint64_t{ 0 }));
+		}, 5));
+
+		const auto fresh_copy = [&] { return source; };
+		report.add("sort", "sequential", "uint64_t", count, measure_seconds(fresh_copy, [](my_vector::vector<uint64_t>& data)
+		{
+			std::sort(data.begin(), data.end());
+			do_not_optimize(data.data());
+		}, 3));
+		report.add("sort", "par", "uint64_t", count, measure_seconds(fresh_copy, [](my_vector::vector<uint64_t>& data)
+		{
+			my_vector::par::sort(data);
+			do_not_optimize(data.data());
+		}, 3));
+	}
+
+	// Scans written as plain loops over the iterators against my_vector::simd on every
+	// instruction set this machine supports
+	template <class T>
+	void bench_simd(json_report& report, const char* element, size_t count)
+	{
+		my_vector::vector<T> left;
+		my_vector::vector<T> right;
+		for (size_t i = 0; i < count; ++i)
+		{
+			left.push_back(static_cast<T>(i % 251));
+			right.push_back(static_cast<T>(i % 13));
+		}
+		const T missing = static_cast<T>(-1);
+
+		report.add("find", "loop", element, count, measure_seconds([&]
+		{
+			do_not_optimize(std::find(left.begin(), left.end(), missing));
+		}, 5));
+		report.add("count", "loop", element, count, measure_seconds([&]
+		{
+			size_t found = 0;
+			for (const T value : left)
+			{
+				found += value == missing ? 1 : 0;
+			}
+			do_not_optimize(found);
+		}, 5));
+		report.add("sum", "loop", element, count, measure_seconds([&]
+		{
+			T total = T();
+			for (const T value : left)
+			{
+				total += value;
+			}
+			do_not_optimize(total);
+		}, 5));
+		report.add("minmax", "loop", element, count, measure_seconds([&]
+		{
+			const auto [low, high] = std::minmax_element(left.begin(), left.end());
+			do_not_optimize(*low + *high);
+		}, 5));
+		report.add("dot", "loop", element, count, measure_seconds([&]
+		{
+			T total = T();
+			for (size_t i = 0; i < count; ++i)
+			{
+				total += left[i] * right[i];
+			}
+			do_not_optimize(total);
+		}, 5));
+
+		using my_vector::simd::instruction_set;
+		const instruction_set detected = my_vector::simd::detected_instruction_set();
+		const std::pair<instruction_set, const char*> sets[] = {
+			{ instruction_set::scalar, "simd-scalar" },
+			{ instruction_set::sse4_2, "simd-sse4.2" },
+			{ instruction_set::avx2, "simd-avx2" },
+			{ instruction_set::avx512, "simd-avx512" }
+		};
+		for (const auto& [set, name] : sets)
+		{
+			if (set > detected)
+			{
+				break;
+			}
+			my_vector::simd::limit_instruction_set(set);
+			report.add("find", name, element, count, measure_seconds([&]
+			{
+				do_not_optimize(my_vector::simd::find(left, missing));
+			}, 5));
+			report.add("count", name, element, count, measure_seconds([&]
+			{
+				do_not_optimize(my_vector::simd::count(left, missing));
+			}, 5));
+			report.add("sum", name, element, count, measure_seconds([&]
+			{
+				do_not_optimize(my_vector::simd::sum(left));
+			}, 5));
+			report.add("minmax", name, element, count, measure_seconds([&]
+			{
+				const auto [low, high] = my_vector::simd::minmax(left);
+				do_not_optimize(low + high);
+			}, 5));
+			report.add("dot", name, element, count, measure_seconds([&]
+			{
+				do_not_optimize(my_vector::simd::dot(left, right));
+			}, 5));
+		}
+		my_vector::simd::limit_instruction_set(detected);
+	}
+
+	// push_back growth under one growth policy: the time, and what it costs in reallocations
+	// and unused capacity
+	template <class Growth_T>
+	void bench_growth_policy(json_report& report, const char* policy, size_t count)
+	{
+		using container = my_vector::vector<uint64_t, std::allocator<uint64_t>, my_vector::counting_stats, Growth_T>;
+		const double seconds = measure_seconds([&]
+		{
+			container vec;
+			for (size_t i = 0; i < count; ++i)
+			{
+				vec.push_back(i);
+			}
+			do_not_optimize(vec.data());
+		}, 3);
+
+		container vec;
+		for (size_t i = 0; i < count; ++i)
+		{
+			vec.push_back(i);
+		}
+		report.add("push_back_growth", policy, "uint64_t", count, seconds, vec.stats());
+	}
+
+	void bench_growth(json_report& report, size_t count)
+	{
+		bench_growth_policy<my_vector::default_growth>(report, "factor-1.5", count);
+		bench_growth_policy<my_vector::factor_growth<2>>(report, "factor-2", count);
+		bench_growth_policy<my_vector::additive_growth<4096>>(report, "additive-4096", count);
+		bench_growth_policy<my_vector::page_rounded_growth<4096>>(report, "page-rounded-4k", count);
+		bench_growth_policy<my_vector::huge_page_rounded_growth<>>(report, "page-rounded-2m", count);
+		bench_growth_policy<my_vector::capped_geometric_growth<size_t{ 1 } << 20>>(report, "capped-geometric-1m", count);
+	}
+
+	// Handing one large vector to many readers: a full copy per reader against a shared
+	// cow_vector snapshot, and the clone a cow_vector pays on its first write
+	void bench_snapshots(json_report& report, size_t count)
+	{
+		constexpr size_t readers = 32;
+		my_vector::vector<uint64_t> source;
+		for (size_t i = 0; i < count; ++i)
+		{
+			source.push_back(i);
+		}
+
+		report.add("fan_out_copy", "my_vector", "uint64_t", readers, measure_seconds([&]
+		{
+			std::vector<my_vector::vector<uint64_t>> copies;
+			copies.reserve(readers);
+			for (size_t i = 0; i < readers; ++i)
+			{
+				copies.push_back(source);
+			}
+			do_not_optimize(copies.data());
+		}, 3));
+
+		const my_vector::cow_vector<uint64_t> shared(source);
+		report.add("fan_out_copy", "cow_vector", "uint64_t", readers, measure_seconds([&]
+		{
+			std::vector<my_vector::cow_vector<uint64_t>> copies;
+			copies.reserve(readers);
+			for (size_t i = 0; i < readers; ++i)
+			{
+				copies.push_back(shared);
+			}
+			do_not_optimize(copies.data());
+		}, 3));
+
+		report.add("first_write", "cow_vector", "uint64_t", count, measure_seconds([&]
+		{
+			return my_vector::cow_vector<uint64_t>(shared);
+		}, [](my_vector::cow_vector<uint64_t>& copy)
+		{
+			copy[0] = 1;
+			do_not_optimize(copy.use_count());
+		}, 3));
+	}
+
+	// Seven-field record of which the scans below read one or two fields
+	struct record
+	{
+		uint64_t id;
+		double price;
+		double quantity;
+		uint32_t flags;
+		uint32_t region;
+		uint64_t timestamp;
+		uint64_t owner;
+	};
+	static_assert(sizeof(record) == 48);
+
+	// Single- and two-field passes over array-of-structs and structure-of-arrays storage
+	void bench_soa(json_report& report, size_t count)
+	{
+		my_vector::vector<record> aos;
+		my_vector::soa_vector<uint64_t, double, double, uint32_t, uint32_t, uint64_t, uint64_t> soa;
+		for (size_t i = 0; i < count; ++i)
+		{
+			const record row{ i, static_cast<double>(i % 100), static_cast<double>(i % 7), 0, static_cast<uint32_t>(i % 16), i, i };
+			aos.push_back(row);
+			soa.emplace_back(row.id, row.price, row.quantity, row.flags, row.region, row.timestamp, row.owner);
+		}
+
+		report.add("scan_one_field", "aos", "record", count, measure_seconds([&]
+		{
+			double total = 0;
+			for (const record& row : aos)
+			{
+				total += row.price;
+			}
+			do_not_optimize(total);
+		}, 5));
+		report.add("scan_one_field", "soa", "record", count, measure_seconds([&]
+		{
+			double total = 0;
+			for (const double price : soa.column<1>())
+			{
+				total += price;
+			}
+			do_not_optimize(total);
+		}, 5));
+
+		report.add("scan_two_fields", "aos", "record", count, measure_seconds([&]
+		{
+			double total = 0;
+			for (const record& row : aos)
+			{
+				total += row.price * row.quantity;
+			}
+			do_not_optimize(total);
+		}, 5));
+		report.add("scan_two_fields", "soa", "record", count, measure_seconds([&]
+		{
+			const std::span<const double> prices = std::as_const(soa).column<1>();
+			const std::span<const double> quantities = std::as_const(soa).column<2>();
+			double total = 0;
+			for (size_t i = 0; i < prices.size(); ++i)
+			{
+				total += prices[i] * quantities[i];
+			}
+			do_not_optimize(total);
+		}, 5));
+
+		report.add("push_back_growth", "aos", "record", count, measure_seconds([&]
+		{
+			my_vector::vector<record> rows;
+			for (size_t i = 0; i < count; ++i)
+			{
+				rows.push_back(record{ i, 1.0, 1.0, 0, 0, i, i });
+			}
+			do_not_optimize(rows.data());
+		}, 3));
+		report.add("push_back_growth", "soa", "record", count, measure_seconds([&]
+		{
+			my_vector::soa_vector<uint64_t, double, double, uint32_t, uint32_t, uint64_t, uint64_t> rows;
+			for (size_t i = 0; i < count; ++i)
+			{
+				rows.emplace_back(i, 1.0, 1.0, 0u, 0u, i, i);
+			}
+			do_not_optimize(rows.size());
+		}, 3));
+	}
+
+	// Bit sets packed 64 to a word against one bool per byte
+	void bench_bits(json_report& report, size_t count)
+	{
+		my_vector::bit_vector<> bits(count);
+		my_vector::bit_vector<> mask(count);
+		my_vector::vector<bool> bools(count, false);
+		my_vector::vector<bool> bool_mask(count, false);
+		for (size_t i = 0; i < count; i += 7)
+		{
+			bits[i] = true;
+			bools[i] = true;
+		}
+		for (size_t i = 0; i < count; i += 3)
+		{
+			mask[i] = true;
+			bool_mask[i] = true;
+		}
+
+		report.add("count", "bit_vector", "bool", count, measure_seconds([&]
+		{
+			do_not_optimize(bits.count());
+		}, 5));
+		report.add("count", "vector", "bool", count, measure_seconds([&]
+		{
+			do_not_optimize(std::count(bools.begin(), bools.end(), true));
+		}, 5));
+
+		// sparse set: one bit in 4096
+		my_vector::bit_vector<> sparse(count);
+		my_vector::vector<bool> sparse_bools(count, false);
+		for (size_t i = 0; i < count; i += 4096)
+		{
+			sparse[i] = true;
+			sparse_bools[i] = true;
+		}
+		report.add("iterate_set_bits", "bit_vector", "bool", count, measure_seconds([&]
+		{
+			size_t total = 0;
+			for (size_t i = sparse.find_first(); i != sparse.npos; i = sparse.find_next(i))
+			{
+				total += i;
+			}
+			do_not_optimize(total);
+		}, 5));
+		report.add("iterate_set_bits", "vector", "bool", count, measure_seconds([&]
+		{
+			size_t total = 0;
+			for (size_t i = 0; i < sparse_bools.size(); ++i)
+			{
+				if (sparse_bools[i])
+				{
+					total += i;
+				}
+			}
+			do_not_optimize(total);
+		}, 5));
+
+		report.add("and_assign", "bit_vector", "bool", count, measure_seconds([&]
+		{
+			bits &= mask;
+			do_not_optimize(bits.words().data());
+		}, 5));
+		report.add("and_assign", "vector", "bool", count, measure_seconds([&]
+		{
+			for (size_t i = 0; i < bools.size(); ++i)
+			{
+				bools[i] = bools[i] && bool_mask[i];
+			}
+			do_not_optimize(bools.data());
+		}, 5));
+	}
+
+	// Fills a reused 1 MiB receive buffer in 64 KiB reads (memcpy standing in for read()),
+	// growing its size before each read the way parsers do
+	void bench_read_buffer(json_report& report)
+	{
+		constexpr size_t buffer_bytes = size_t{ 1 } << 20;
+		constexpr size_t chunk = size_t{ 64 } << 10;
+		constexpr int rounds = 64;
+		const std::vector<char> source(chunk, 'x');
+
+		const auto fill = [&](auto& buffer, auto grow)
+		{
+			return measure_seconds([&]
+			{
+				for (int round = 0; round < rounds; ++round)
+				{
+					buffer.clear();
+					while (buffer.size() < buffer_bytes)
+					{
+						grow(buffer);
+					}
+					do_not_optimize(buffer.data());
+				}
+			}, 5);
+		};
+		const auto read_after_resize = [&](auto& buffer, auto resize)
+		{
+			const size_t old_size = buffer.size();
+			resize(buffer, old_size + chunk);
+			std::memcpy(buffer.data() + old_size, source.data(), chunk);
+		};
+
+		my_vector::vector<char> buffer;
+		buffer.reserve(buffer_bytes);
+		my_vector::vector<char, my_vector::default_init_allocator<char>> default_init_buffer;
+		default_init_buffer.reserve(buffer_bytes);
+		const size_t bytes = buffer_bytes * rounds;
+
+		report.add("read_into_buffer", "resize", "char", bytes, fill(buffer, [&](auto& vec)
+		{
+			read_after_resize(vec, [](auto& v, size_t n) { v.resize(n); });
+		}));
+		report.add("read_into_buffer", "resize_for_overwrite", "char", bytes, fill(buffer, [&](auto& vec)
+		{
+			read_after_resize(vec, [](auto& v, size_t n) { v.resize_for_overwrite(n); });
+		}));
+		report.add("read_into_buffer", "reserve_and_append", "char", bytes, fill(buffer, [&](auto& vec)
+		{
+			vec.reserve_and_append(chunk, [&](char* dest, size_t count)
+			{
+				std::memcpy(dest, source.data(), count);
+				return count;
+			});
+		}));
+		report.add("read_into_buffer", "default_init_allocator", "char", bytes, fill(default_init_buffer, [&](auto& vec)
+		{
+			read_after_resize(vec, [](auto& v, size_t n) { v.resize(n); });
+		}));
+	}
+
+	// Short-lived containers with a known bound of 16 elements, built once per operation
+	void bench_bounded(json_report& report, size_t count)
+	{
+		constexpr size_t bound = 16;
+		report.add("build_bounded", "vector_reserved", "uint32_t", count, measure_seconds([&]
+		{
+			uint64_t total = 0;
+			for (size_t i = 0; i < count; ++i)
+			{
+				my_vector::vector<uint32_t> routes;
+				routes.reserve(bound);
+				for (uint32_t route = 0; route < i % bound + 1; ++route)
+				{
+					routes.push_back(route);
+				}
+				total += routes.back();
+			}
+			do_not_optimize(total);
+		}, 3));
+		report.add("build_bounded", "static_vector", "uint32_t", count, measure_seconds([&]
+		{
+			uint64_t total = 0;
+			for (size_t i = 0; i < count; ++i)
+			{
+				my_vector::static_vector<uint32_t, bound> routes;
+				for (uint32_t route = 0; route < i % bound + 1; ++route)
+				{
+					routes.push_back(route);
+				}
+				total += routes.back();
+			}
+			do_not_optimize(total);
+		}, 3));
+	}
+
+	// An eviction sweep: about 30% of the entries, scattered at random, are marked expired (0)
+	void bench_evict(json_report& report, size_t count)
+	{
+		const auto fresh_entries = [&]
+		{
+			my_vector::vector<int32_t> entries;
+			entries.reserve(count);
+			uint32_t state = 1;
+			for (size_t i = 0; i < count; ++i)
+			{
+				state = state * 1664525 + 1013904223;
+				entries.push_back(state % 10 < 3 ? 0 : static_cast<int32_t>(i | 1));
+			}
+			return entries;
+		};
+		const auto expired = [](int32_t entry) { return entry == 0; };
+
+		report.add("evict", "rebuild", "int32_t", count, measure_seconds(fresh_entries, [&](my_vector::vector<int32_t>& entries)
+		{
+			my_vector::vector<int32_t> live;
+			for (const int32_t entry : entries)
+			{
+				if (!expired(entry))
+				{
+					live.push_back(entry);
+				}
+			}
+			entries = std::move(live);
+		}, 3));
+		report.add("evict", "erase_if", "int32_t", count, measure_seconds(fresh_entries, [&](my_vector::vector<int32_t>& entries)
+		{
+			entries.erase_if(expired);
+		}, 3));
+		report.add("evict", "unordered_erase_if", "int32_t", count, measure_seconds(fresh_entries, [&](my_vector::vector<int32_t>& entries)
+		{
+			entries.unordered_erase_if(expired);
+		}, 3));
+		report.add("evict", "erase_value", "int32_t", count, measure_seconds(fresh_entries, [](my_vector::vector<int32_t>& entries)
+		{
+			entries.erase_value(0);
+		}, 3));
+	}
+
+	template <my_vector::huge_pages Pages>
+	void bench_scan(json_report& report, const char* name, size_t bytes)
+	{
+		constexpr my_vector::mmap_options options{ .pages = Pages, .populate = true };
+		using allocator = my_vector::mmap_allocator<uint64_t, options>;
+
+		const size_t count = bytes / sizeof(uint64_t);
+		my_vector::vector<uint64_t, allocator> vec(count, 1);
+
+		report.add("sequential_scan", name, "uint64_t", count, measure_seconds([&]
+		{
+			uint64_t sum = 0;
+			for (const uint64_t value : vec)
+			{
+				sum += value;
+			}
+			do_not_optimize(sum);
+		}, 5));
+
+		// dependent pseudo-random walk: every access is a likely TLB miss
+		const size_t steps = count / 8;
+		report.add("random_walk", name, "uint64_t", steps, measure_seconds([&]
+		{
+			uint64_t state = 1;
+			uint64_t sum = 0;
+			for (size_t i = 0; i < steps; ++i)
+			{
+				state = state * 6364136223846793005ULL + 1442695040888963407ULL + sum;
+				sum += vec[(state >> 17) % count];
+			}
+			do_not_optimize(sum);
+		}, 3));
+	}
+}
+
+// usage: bench [elements per container case] [scan size in MiB]
+int main(int argc, char** argv)
+{
+	const size_t count = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 1000000;
+	const size_t mib = argc > 2 ? std::strtoull(argv[2], nullptr, 10) : 256;
+
+	vector_bench::json_report report;
+	vector_bench::bench_element<int>(report, count);
+	vector_bench::bench_element<vector_bench::pod64>(report, count);
+	vector_bench::bench_element<test_object>(report, count);
+	vector_bench::bench_growth(report, count);
+	vector_bench::bench_read_buffer(report);
+	vector_bench::bench_concurrent_append(report, count);
+	vector_bench::bench_snapshots(report, count);
+	vector_bench::bench_soa(report, count);
+	vector_bench::bench_bounded(report, count);
+	vector_bench::bench_bits(report, count);
+	vector_bench::bench_evict(report, count * 10);
+	vector_bench::bench_parallel(report, count);
+	vector_bench::bench_simd<int32_t>(report, "int32_t", count);
+	vector_bench::bench_simd<float>(report, "float", count);
+	vector_bench::bench_simd<double>(report, "double", count);
+	vector_bench::bench_push_latency<my_vector::vector<vector_bench::pod64>>(report, "my_vector", count * 4);
+	vector_bench::bench_push_latency<my_vector::segmented_vector<vector_bench::pod64>>(report, "segmented_vector", count * 4);
+
+	vector_bench::bench_scan<my_vector::huge_pages::none>(report, "mmap-4k-pages", mib << 20);
+	vector_bench::bench_scan<my_vector::huge_pages::transparent>(report, "mmap-huge-pages", mib << 20);
+}
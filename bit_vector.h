@@ -0,0 +1,572 @@
+#pragma once
+#include "my_vector.h"
+#include "my_vector_segments.h"
+#include "my_vector_simd.h"
+#include <bit>
+#include <cstdint>
+#include <initializer_list>
+#include <span>
+
+namespace my_vector
+{
+	// Vector of bools packed 64 to a word: an eighth of the memory and bandwidth of
+	// vector<bool>, with the same interface through proxy references. Fills, resizes and the
+	// bitwise operators work a word at a time, count() uses popcnt where the CPU has it, and
+	// find_first/find_next skip clear words whole.
+	//
+	// Bits past size() in the last word are always zero, so whole-word operations never see
+	// stale bits.
+	template <class Alloc_T = std::allocator<uint64_t>>
+	class bit_vector
+	{
+		static constexpr size_t word_bits = 64;
+
+		vector<uint64_t, Alloc_T> words_;
+		size_t size_;
+
+	public:
+		// Proxy for one bit, returned by the mutable accessors
+		class reference
+		{
+		public:
+			reference(uint64_t* word, uint64_t mask) noexcept : word_(word), mask_(mask)
+			{}
+
+			reference(const reference& other) = default;
+
+			operator bool() const noexcept
+			{
+				return (*word_ & mask_) != 0;
+			}
+
+			reference& operator=(bool value) noexcept
+			{
+				*word_ = value ? *word_ | mask_ : *word_ & ~mask_;
+				return *this;
+			}
+
+			reference& operator=(const reference& other) noexcept
+			{
+				return *this = static_cast<bool>(other);
+			}
+
+			bool operator~() const noexcept
+			{
+				return !static_cast<bool>(*this);
+			}
+
+			void flip() noexcept
+			{
+				*word_ ^= mask_;
+			}
+
+		private:
+			uint64_t* word_;
+			uint64_t mask_;
+		};
+
+		using iterator = detail::indexed_iterator<bit_vector, bool, reference>;
+		using constant_iterator = detail::indexed_iterator<const bit_vector, const bool, bool>;
+
+		// Returned by the find functions when no set bit remains
+		static constexpr size_t npos = static_cast<size_t>(-1);
+
+		bit_vector()noexcept;
+
+		explicit bit_vector(const Alloc_T& allocator)noexcept;
+
+		explicit bit_vector(size_t size, bool value = false, const Alloc_T& allocator = Alloc_T());
+
+		bit_vector(std::initializer_list<bool> list, const Alloc_T& allocator = Alloc_T());
+
+		void clear()noexcept;
+
+		// Makes room for new_capacity bits
+		void reserve(size_t new_capacity);
+
+		void resize(size_t new_size, bool value = false);
+
+		void shrink_to_fit();
+
+		void push_back(bool value);
+
+		void pop_back();
+
+		// Sets every bit to value
+		void assign(bool value)noexcept;
+
+		// Inverts every bit
+		void flip()noexcept;
+
+		[[nodiscard]] bool at(size_t index)const;
+
+		reference at(size_t index);
+
+		bool operator[](size_t index)const noexcept;
+
+		reference operator[](size_t index)noexcept;
+
+		[[nodiscard]] bool front()const;
+
+		reference front();
+
+		[[nodiscard]] bool back()const;
+
+		reference back();
+
+		// Number of set bits
+		[[nodiscard]] size_t count()const noexcept;
+
+		[[nodiscard]] bool any()const noexcept;
+
+		[[nodiscard]] bool all()const noexcept;
+
+		[[nodiscard]] bool none()const noexcept;
+
+		// Index of the first set bit, or npos
+		[[nodiscard]] size_t find_first()const noexcept;
+
+		// Index of the first set bit after position, or npos
+		[[nodiscard]] size_t find_next(size_t position)const noexcept;
+
+		// The packed words; bit i lives in words()[i / 64] at bit i % 64
+		[[nodiscard]] std::span<const uint64_t> words()const noexcept;
+
+		// Bitwise operations with an equally sized vector; throw if the sizes differ
+		bit_vector& operator&=(const bit_vector& other);
+
+		bit_vector& operator|=(const bit_vector& other);
+
+		bit_vector& operator^=(const bit_vector& other);
+
+		// Clears the bits set in other
+		bit_vector& subtract(const bit_vector& other);
+
+		bit_vector operator~()const;
+
+		bool operator==(const bit_vector& other)const noexcept;
+
+		[[nodiscard]] bool empty()const noexcept;
+
+		[[nodiscard]] size_t size()const noexcept;
+
+		[[nodiscard]] size_t capacity()const noexcept;
+
+		void swap(bit_vector& other)noexcept;
+
+		iterator begin();
+
+		iterator end();
+
+		[[nodiscard]] constant_iterator begin()const;
+
+		[[nodiscard]] constant_iterator end()const;
+
+		[[nodiscard]] constant_iterator cbegin()const;
+
+		[[nodiscard]] constant_iterator cend()const;
+
+	private:
+		static size_t words_for(size_t bits) noexcept;
+
+		// Zeroes the bits of the last word beyond size_
+		void clear_tail() noexcept;
+
+		template <class Op>
+		bit_vector& combine(const bit_vector& other, Op op);
+	};
+
+	template <class Alloc_T>
+	bit_vector<Alloc_T> operator&(bit_vector<Alloc_T> left, const bit_vector<Alloc_T>& right)
+	{
+		return left &= right;
+	}
+
+	template <class Alloc_T>
+	bit_vector<Alloc_T> operator|(bit_vector<Alloc_T> left, const bit_vector<Alloc_T>& right)
+	{
+		return left |= right;
+	}
+
+	template <class Alloc_T>
+	bit_vector<Alloc_T> operator^(bit_vector<Alloc_T> left, const bit_vector<Alloc_T>& right)
+	{
+		return left ^= right;
+	}
+
+
+	template <class Alloc_T>
+	bit_vector<Alloc_T>::bit_vector() noexcept : bit_vector(Alloc_T())
+	{}
+
+	template <class Alloc_T>
+	bit_vector<Alloc_T>::bit_vector(const Alloc_T& allocator) noexcept : words_(allocator), size_(0)
+	{}
+
+	template <class Alloc_T>
+	bit_vector<Alloc_T>::bit_vector(size_t size, bool value, const Alloc_T& allocator)
+		: words_(words_for(size), value ? ~uint64_t{ 0 } : uint64_t{ 0 }, allocator), size_(size)
+	{
+		clear_tail();
+	}
+
+	template <class Alloc_T>
+	bit_vector<Alloc_T>::bit_vector(std::initializer_list<bool> list, const Alloc_T& allocator)
+		: words_(words_for(list.size()), uint64_t{ 0 }, allocator), size_(list.size())
+	{
+		size_t index = 0;
+		for (const bool value : list)
+		{
+			words_[index / word_bits] |= uint64_t{ value } << index % word_bits;
+			++index;
+		}
+	}
+
+	template <class Alloc_T>
+	void bit_vector<Alloc_T>::clear() noexcept
+	{
+		words_.clear();
+		size_ = 0;
+	}
+
+	template <class Alloc_T>
+	void bit_vector<Alloc_T>::reserve(size_t new_capacity)
+	{
+		words_.reserve(words_for(new_capacity));
+	}
+
+	template <class Alloc_T>
+	void bit_vector<Alloc_T>::resize(size_t new_size, bool value)
+	{
+		if (new_size > size_ && value && size_ % word_bits != 0)
+		{
+			// the rest of the current last word, before whole words are appended
+			words_[size_ / word_bits] |= ~uint64_t{ 0 } << size_ % word_bits;
+		}
+		words_.resize(words_for(new_size), value && new_size > size_ ? ~uint64_t{ 0 } : uint64_t{ 0 });
+		size_ = new_size;
+		clear_tail();
+	}
+
+	template <class Alloc_T>
+	void bit_vector<Alloc_T>::shrink_to_fit()
+	{
+		words_.shrink_to_fit();
+	}
+
+	template <class Alloc_T>
+	void bit_vector<Alloc_T>::push_back(bool value)
+	{
+		if (size_ % word_bits == 0)
+		{
+			words_.push_back(0);
+		}
+		words_[size_ / word_bits] |= uint64_t{ value } << size_ % word_bits;
+		++size_;
+	}
+
+	template <class Alloc_T>
+	void bit_vector<Alloc_T>::pop_back()
+	{
+		if (size_ == 0)
+		{
+			throw my_vector_exception("Vector is empty");
+		}
+		--size_;
+		if (size_ % word_bits == 0)
+		{
+			words_.pop_back();
+		}
+		else
+		{
+			clear_tail();
+		}
+	}
+
+	template <class Alloc_T>
+	void bit_vector<Alloc_T>::assign(bool value) noexcept
+	{
+		std::fill(words_.begin(), words_.end(), value ? ~uint64_t{ 0 } : uint64_t{ 0 });
+		clear_tail();
+	}
+
+	template <class Alloc_T>
+	void bit_vector<Alloc_T>::flip() noexcept
+	{
+		for (uint64_t& word : words_)
+		{
+			word = ~word;
+		}
+		clear_tail();
+	}
+
+	template <class Alloc_T>
+	bool bit_vector<Alloc_T>::at(size_t index) const
+	{
+		if (index >= size_)
+		{
+			throw my_vector_exception("index out of range");
+		}
+		return (*this)[index];
+	}
+
+	template <class Alloc_T>
+	typename bit_vector<Alloc_T>::reference bit_vector<Alloc_T>::at(size_t index)
+	{
+		if (index >= size_)
+		{
+			throw my_vector_exception("index out of range");
+		}
+		return (*this)[index];
+	}
+
+	template <class Alloc_T>
+	bool bit_vector<Alloc_T>::operator[](size_t index) const noexcept
+	{
+		return (words_[index / word_bits] >> index % word_bits & 1) != 0;
+	}
+
+	template <class Alloc_T>
+	typename bit_vector<Alloc_T>::reference bit_vector<Alloc_T>::operator[](size_t index) noexcept
+	{
+		return reference(&words_[index / word_bits], uint64_t{ 1 } << index % word_bits);
+	}
+
+	template <class Alloc_T>
+	bool bit_vector<Alloc_T>::front() const
+	{
+		if (empty())
+		{
+			throw my_vector_exception("Vector is empty!");
+		}
+		return (*this)[0];
+	}
+
+	template <class Alloc_T>
+	typename bit_vector<Alloc_T>::reference bit_vector<Alloc_T>::front()
+	{
+		if (empty())
+		{
+			throw my_vector_exception("Vector is empty!");
+		}
+		return (*this)[0];
+	}
+
+	template <class Alloc_T>
+	bool bit_vector<Alloc_T>::back() const
+	{
+		if (empty())
+		{
+			throw my_vector_exception("Vector is empty!");
+		}
+		return (*this)[size_ - 1];
+	}
+
+	template <class Alloc_T>
+	typename bit_vector<Alloc_T>::reference bit_vector<Alloc_T>::back()
+	{
+		if (empty())
+		{
+			throw my_vector_exception("Vector is empty!");
+		}
+		return (*this)[size_ - 1];
+	}
+
+	template <class Alloc_T>
+	size_t bit_vector<Alloc_T>::count() const noexcept
+	{
+		return simd::popcount(words_.data(), words_.size());
+	}
+
+	template <class Alloc_T>
+	bool bit_vector<Alloc_T>::any() const noexcept
+	{
+		return find_first() != npos;
+	}
+
+	template <class Alloc_T>
+	bool bit_vector<Alloc_T>::all() const noexcept
+	{
+		return count() == size_;
+	}
+
+	template <class Alloc_T>
+	bool bit_vector<Alloc_T>::none() const noexcept
+	{
+		return !any();
+	}
+
+	template <class Alloc_T>
+	size_t bit_vector<Alloc_T>::find_first() const noexcept
+	{
+		for (size_t word = 0; word < words_.size(); ++word)
+		{
+			if (words_[word] != 0)
+			{
+				return word * word_bits + static_cast<size_t>(std::countr_zero(words_[word]));
+			}
+		}
+		return npos;
+	}
+
+	template <class Alloc_T>
+	size_t bit_vector<Alloc_T>::find_next(size_t position) const noexcept
+	{
+		const size_t start = position + 1;
+		if (position == npos || start >= size_)
+		{
+			return npos;
+		}
+		size_t word = start / word_bits;
+		// bits of the first word below start are masked off
+		uint64_t bits = words_[word] & ~uint64_t{ 0 } << start % word_bits;
+		while (bits == 0)
+		{
+			if (++word == words_.size())
+			{
+				return npos;
+			}
+			bits = words_[word];
+		}
+		return word * word_bits + static_cast<size_t>(std::countr_zero(bits));
+	}
+
+	template <class Alloc_T>
+	std::span<const uint64_t> bit_vector<Alloc_T>::words() const noexcept
+	{
+		return { words_.data(), words_.size() };
+	}
+
+	template <class Alloc_T>
+	bit_vector<Alloc_T>& bit_vector<Alloc_T>::operator&=(const bit_vector& other)
+	{
+		return combine(other, [](uint64_t a, uint64_t b) { return a & b; });
+	}
+
+	template <class Alloc_T>
+	bit_vector<Alloc_T>& bit_vector<Alloc_T>::operator|=(const bit_vector& other)
+	{
+		return combine(other, [](uint64_t a, uint64_t b) { return a | b; });
+	}
+
+	template <class Alloc_T>
+	bit_vector<Alloc_T>& bit_vector<Alloc_T>::operator^=(const bit_vector& other)
+	{
+		return combine(other, [](uint64_t a, uint64_t b) { return a ^ b; });
+	}
+
+	template <class Alloc_T>
+	bit_vector<Alloc_T>& bit_vector<Alloc_T>::subtract(const bit_vector& other)
+	{
+		return combine(other, [](uint64_t a, uint64_t b) { return a & ~b; });
+	}
+
+	template <class Alloc_T>
+	bit_vector<Alloc_T> bit_vector<Alloc_T>::operator~() const
+	{
+		bit_vector result = *this;
+		result.flip();
+		return result;
+	}
+
+	template <class Alloc_T>
+	bool bit_vector<Alloc_T>::operator==(const bit_vector& other) const noexcept
+	{
+		// the tail invariant makes equal vectors equal word for word
+		return size_ == other.size_ && std::equal(words_.begin(), words_.end(), other.words_.begin());
+	}
+
+	template <class Alloc_T>
+	bool bit_vector<Alloc_T>::empty() const noexcept
+	{
+		return size_ == 0;
+	}
+
+	template <class Alloc_T>
+	size_t bit_vector<Alloc_T>::size() const noexcept
+	{
+		return size_;
+	}
+
+	template <class Alloc_T>
+	size_t bit_vector<Alloc_T>::capacity() const noexcept
+	{
+		return words_.capacity() * word_bits;
+	}
+
+	template <class Alloc_T>
+	void bit_vector<Alloc_T>::swap(bit_vector& other) noexcept
+	{
+		words_.swap(other.words_);
+		std::swap(size_, other.size_);
+	}
+
+	template <class Alloc_T>
+	typename bit_vector<Alloc_T>::iterator bit_vector<Alloc_T>::begin()
+	{
+		return iterator(this, 0);
+	}
+
+	template <class Alloc_T>
+	typename bit_vector<Alloc_T>::iterator bit_vector<Alloc_T>::end()
+	{
+		return iterator(this, size_);
+	}
+
+	template <class Alloc_T>
+	typename bit_vector<Alloc_T>::constant_iterator bit_vector<Alloc_T>::begin() const
+	{
+		return constant_iterator(this, 0);
+	}
+
+	template <class Alloc_T>
+	typename bit_vector<Alloc_T>::constant_iterator bit_vector<Alloc_T>::end() const
+	{
+		return constant_iterator(this, size_);
+	}
+
+	template <class Alloc_T>
+	typename bit_vector<Alloc_T>::constant_iterator bit_vector<Alloc_T>::cbegin() const
+	{
+		return begin();
+	}
+
+	template <class Alloc_T>
+	typename bit_vector<Alloc_T>::constant_iterator bit_vector<Alloc_T>::cend() const
+	{
+		return end();
+	}
+
+	template <class Alloc_T>
+	size_t bit_vector<Alloc_T>::words_for(size_t bits) noexcept
+	{
+		return (bits + word_bits - 1) / word_bits;
+	}
+
+	template <class Alloc_T>
+	void bit_vector<Alloc_T>::clear_tail() noexcept
+	{
+		if (size_ % word_bits != 0)
+		{
+			words_[size_ / word_bits] &= (uint64_t{ 1 } << size_ % word_bits) - 1;
+		}
+	}
+
+	template <class Alloc_T>
+	template <class Op>
+	bit_vector<Alloc_T>& bit_vector<Alloc_T>::combine(const bit_vector& other, Op op)
+	{
+		if (size_ != other.size_)
+		{
+			throw my_vector_exception("Vector sizes differ");
+		}
+		// plain word loops, which the compiler vectorizes
+		uint64_t* words = words_.data();
+		const uint64_t* other_words = other.words_.data();
+		for (size_t i = 0; i < words_.size(); ++i)
+		{
+			words[i] = op(words[i], other_words[i]);
+		}
+		return *this;
+	}
+}
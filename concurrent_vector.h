@@ -0,0 +1,358 @@
+#pragma once
+#include "my_vector_exception.h"
+#include "my_vector_segments.h"
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <type_traits>
+#include <utility>
+
+namespace my_vector
+{
+	// Append-only vector that many threads can grow at once without a lock. Each append
+	// claims its slot with one atomic fetch_add; the elements live in segments that double
+	// in size and never move, so references returned by emplace_back stay valid and readers
+	// never see a reallocation. size() covers the longest prefix of fully constructed
+	// elements: each append marks its slot ready and then advances that prefix over every
+	// ready slot, so no thread ever waits for a slower one.
+	//
+	// Appends, size(), operator[] and iteration may run concurrently; reserve() may too.
+	// Destruction is not thread-safe. If allocating a segment throws, the claimed slot stays
+	// empty and size() stops short of it from then on.
+	template <class T, class Alloc_T = std::allocator<T>>
+	class concurrent_vector
+	{
+		using layout = detail::segment_layout<5>;
+		using allocator_traits = std::allocator_traits<Alloc_T>;
+
+		using ready_flag = std::atomic<uint8_t>;
+		using flag_allocator = typename allocator_traits::template rebind_alloc<ready_flag>;
+
+		Alloc_T allocator_;
+		std::atomic<T*> segments_[layout::max_segments];
+		// one flag per slot, set once its element is constructed; installed before the segment
+		std::atomic<ready_flag*> ready_[layout::max_segments];
+		// slots handed out to appenders
+		std::atomic<size_t> claimed_;
+		// prefix of slots holding constructed elements
+		std::atomic<size_t> published_;
+
+	public:
+		using iterator = detail::indexed_iterator<concurrent_vector, T>;
+		using constant_iterator = detail::indexed_iterator<const concurrent_vector, const T>;
+
+		concurrent_vector()noexcept;
+
+		explicit concurrent_vector(const Alloc_T& allocator)noexcept;
+
+		concurrent_vector(const concurrent_vector& other) = delete;
+
+		concurrent_vector& operator=(const concurrent_vector& other) = delete;
+
+		~concurrent_vector();
+
+		// Allocates the segments needed for new_capacity elements up front
+		void reserve(size_t new_capacity);
+
+		void push_back(T&& value);
+
+		void push_back(const T& value);
+
+		// Appends an element and returns a reference that stays valid until destruction
+		template <typename... Ts>
+		T& emplace_back(Ts&&... args);
+
+		[[nodiscard]] const T& at(size_t index)const;
+
+		T& at(size_t index);
+
+		const T& operator[](size_t index)const noexcept;
+
+		T& operator[](size_t index)noexcept;
+
+		[[nodiscard]] bool empty()const noexcept;
+
+		// Number of published elements
+		[[nodiscard]] size_t size()const noexcept;
+
+		[[nodiscard]] size_t capacity()const noexcept;
+
+		// Iteration covers the elements published when begin()/end() was called
+		iterator begin();
+
+		iterator end();
+
+		[[nodiscard]] constant_iterator begin()const;
+
+		[[nodiscard]] constant_iterator end()const;
+
+		[[nodiscard]] constant_iterator cbegin()const;
+
+		[[nodiscard]] constant_iterator cend()const;
+
+	private:
+		// Returns segment, allocating it if no thread has yet
+		T* ensure_segment(size_t segment);
+
+		// Marks index constructed and extends the published prefix as far as it can
+		void publish(size_t index) noexcept;
+
+		[[nodiscard]] bool is_ready(size_t index) const noexcept;
+	};
+
+
+	template <class T, class Alloc_T>
+	concurrent_vector<T, Alloc_T>::concurrent_vector() noexcept : concurrent_vector(Alloc_T())
+	{}
+
+	template <class T, class Alloc_T>
+	concurrent_vector<T, Alloc_T>::concurrent_vector(const Alloc_T& allocator) noexcept
+		: allocator_(allocator), claimed_(0), published_(0)
+	{
+		for (size_t segment = 0; segment < layout::max_segments; ++segment)
+		{
+			segments_[segment].store(nullptr, std::memory_order_relaxed);
+			ready_[segment].store(nullptr, std::memory_order_relaxed);
+		}
+	}
+
+	template <class T, class Alloc_T>
+	concurrent_vector<T, Alloc_T>::~concurrent_vector()
+	{
+		flag_allocator flags(allocator_);
+		for (size_t segment = 0; segment < layout::max_segments; ++segment)
+		{
+			T* elements = segments_[segment].load(std::memory_order_acquire);
+			ready_flag* ready = ready_[segment].load(std::memory_order_acquire);
+			const size_t count = layout::segment_size(segment);
+			if (elements != nullptr)
+			{
+				// slots past a failed allocation may hold elements beyond size()
+				for (size_t i = 0; i < count; ++i)
+				{
+					if (ready[i].load(std::memory_order_relaxed) != 0)
+					{
+						std::destroy_at(elements + i);
+					}
+				}
+				allocator_traits::deallocate(allocator_, elements, count);
+			}
+			if (ready != nullptr)
+			{
+				std::destroy_n(ready, count);
+				std::allocator_traits<flag_allocator>::deallocate(flags, ready, count);
+			}
+		}
+	}
+
+	template <class T, class Alloc_T>
+	void concurrent_vector<T, Alloc_T>::reserve(size_t new_capacity)
+	{
+		if (new_capacity == 0)
+		{
+			return;
+		}
+		const size_t last = layout::locate(new_capacity - 1).segment;
+		for (size_t segment = 0; segment <= last; ++segment)
+		{
+			ensure_segment(segment);
+		}
+	}
+
+	template <class T, class Alloc_T>
+	void concurrent_vector<T, Alloc_T>::push_back(T&& value)
+	{
+		emplace_back(std::move(value));
+	}
+
+	template <class T, class Alloc_T>
+	void concurrent_vector<T, Alloc_T>::push_back(const T& value)
+	{
+		emplace_back(value);
+	}
+
+	template <class T, class Alloc_T>
+	template <typename ... Ts>
+	T& concurrent_vector<T, Alloc_T>::emplace_back(Ts&&... args)
+	{
+		if constexpr (!std::is_nothrow_constructible_v<T, Ts&&...>)
+		{
+			// build the element before claiming a slot, so a throwing constructor leaves no gap
+			static_assert(std::is_nothrow_move_constructible_v<T>,
+				"concurrent_vector needs nothrow move construction for elements whose construction may throw");
+			T value(std::forward<Ts>(args)...);
+			return emplace_back(std::move(value));
+		}
+		else
+		{
+			const size_t index = claimed_.fetch_add(1, std::memory_order_relaxed);
+			const auto [segment, offset] = layout::locate(index);
+			T* elements = segments_[segment].load(std::memory_order_acquire);
+			if (elements == nullptr)
+			{
+				elements = ensure_segment(segment);
+			}
+			T* slot = std::construct_at(elements + offset, std::forward<Ts>(args)...);
+			publish(index);
+			return *slot;
+		}
+	}
+
+	template <class T, class Alloc_T>
+	const T& concurrent_vector<T, Alloc_T>::at(size_t index) const
+	{
+		if (index >= size())
+		{
+			throw my_vector_exception("Index is out of range");
+		}
+		return (*this)[index];
+	}
+
+	template <class T, class Alloc_T>
+	T& concurrent_vector<T, Alloc_T>::at(size_t index)
+	{
+		if (index >= size())
+		{
+			throw my_vector_exception("Index is out of range");
+		}
+		return (*this)[index];
+	}
+
+	template <class T, class Alloc_T>
+	const T& concurrent_vector<T, Alloc_T>::operator[](size_t index) const noexcept
+	{
+		const auto [segment, offset] = layout::locate(index);
+		return segments_[segment].load(std::memory_order_acquire)[offset];
+	}
+
+	template <class T, class Alloc_T>
+	T& concurrent_vector<T, Alloc_T>::operator[](size_t index) noexcept
+	{
+		const auto [segment, offset] = layout::locate(index);
+		return segments_[segment].load(std::memory_order_acquire)[offset];
+	}
+
+	template <class T, class Alloc_T>
+	bool concurrent_vector<T, Alloc_T>::empty() const noexcept
+	{
+		return size() == 0;
+	}
+
+	template <class T, class Alloc_T>
+	size_t concurrent_vector<T, Alloc_T>::size() const noexcept
+	{
+		return published_.load(std::memory_order_acquire);
+	}
+
+	template <class T, class Alloc_T>
+	size_t concurrent_vector<T, Alloc_T>::capacity() const noexcept
+	{
+		size_t result = 0;
+		for (size_t segment = 0; segment < layout::max_segments; ++segment)
+		{
+			if (segments_[segment].load(std::memory_order_acquire) == nullptr)
+			{
+				break;
+			}
+			result += layout::segment_size(segment);
+		}
+		return result;
+	}
+
+	template <class T, class Alloc_T>
+	typename concurrent_vector<T, Alloc_T>::iterator concurrent_vector<T, Alloc_T>::begin()
+	{
+		return iterator(this, 0);
+	}
+
+	template <class T, class Alloc_T>
+	typename concurrent_vector<T, Alloc_T>::iterator concurrent_vector<T, Alloc_T>::end()
+	{
+		return iterator(this, size());
+	}
+
+	template <class T, class Alloc_T>
+	typename concurrent_vector<T, Alloc_T>::constant_iterator concurrent_vector<T, Alloc_T>::begin() const
+	{
+		return constant_iterator(this, 0);
+	}
+
+	template <class T, class Alloc_T>
+	typename concurrent_vector<T, Alloc_T>::constant_iterator concurrent_vector<T, Alloc_T>::end() const
+	{
+		return constant_iterator(this, size());
+	}
+
+	template <class T, class Alloc_T>
+	typename concurrent_vector<T, Alloc_T>::constant_iterator concurrent_vector<T, Alloc_T>::cbegin() const
+	{
+		return begin();
+	}
+
+	template <class T, class Alloc_T>
+	typename concurrent_vector<T, Alloc_T>::constant_iterator concurrent_vector<T, Alloc_T>::cend() const
+	{
+		return end();
+	}
+
+	template <class T, class Alloc_T>
+	T* concurrent_vector<T, Alloc_T>::ensure_segment(size_t segment)
+	{
+		T* elements = segments_[segment].load(std::memory_order_acquire);
+		if (elements != nullptr)
+		{
+			return elements;
+		}
+
+		// racing threads may each allocate; the first to install wins and the rest free theirs
+		const size_t count = layout::segment_size(segment);
+		if (ready_[segment].load(std::memory_order_acquire) == nullptr)
+		{
+			flag_allocator flags(allocator_);
+			ready_flag* fresh = std::allocator_traits<flag_allocator>::allocate(flags, count);
+			std::uninitialized_value_construct_n(fresh, count);
+			ready_flag* expected = nullptr;
+			if (!ready_[segment].compare_exchange_strong(expected, fresh, std::memory_order_acq_rel))
+			{
+				std::destroy_n(fresh, count);
+				std::allocator_traits<flag_allocator>::deallocate(flags, fresh, count);
+			}
+		}
+
+		Alloc_T allocator = allocator_;
+		T* fresh = allocator_traits::allocate(allocator, count);
+		if (segments_[segment].compare_exchange_strong(elements, fresh, std::memory_order_acq_rel, std::memory_order_acquire))
+		{
+			return fresh;
+		}
+		allocator_traits::deallocate(allocator, fresh, count);
+		return elements;
+	}
+
+	template <class T, class Alloc_T>
+	void concurrent_vector<T, Alloc_T>::publish(size_t index) noexcept
+	{
+		const auto [segment, offset] = layout::locate(index);
+		// sequentially consistent with the reads in is_ready: of two appenders finishing
+		// out of order, at least one sees the other's flag and carries the prefix past both
+		ready_[segment].load(std::memory_order_acquire)[offset].store(1, std::memory_order_seq_cst);
+
+		// stops at the first slot still being constructed; its appender carries on from there
+		size_t published = published_.load(std::memory_order_seq_cst);
+		while (is_ready(published))
+		{
+			if (published_.compare_exchange_weak(published, published + 1, std::memory_order_seq_cst))
+			{
+				++published;
+			}
+		}
+	}
+
+	template <class T, class Alloc_T>
+	bool concurrent_vector<T, Alloc_T>::is_ready(size_t index) const noexcept
+	{
+		const auto [segment, offset] = layout::locate(index);
+		const ready_flag* ready = ready_[segment].load(std::memory_order_acquire);
+		return ready != nullptr && ready[offset].load(std::memory_order_seq_cst) != 0;
+	}
+}
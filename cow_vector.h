@@ -0,0 +1,492 @@
+#pragma once
+#include "my_vector.h"
+#include <atomic>
+#include <initializer_list>
+#include <memory>
+#include <utility>
+
+namespace my_vector
+{
+	// Vector whose copies share one reference-counted buffer, so handing the same contents to
+	// many readers costs an atomic increment instead of an allocation and per-element copy.
+	// The first mutating call on a copy that still shares its buffer clones the elements
+	// first; a copy that owns its buffer alone mutates it in place.
+	//
+	// Like std::shared_ptr, distinct cow_vector objects may be copied, read, mutated and
+	// destroyed from different threads even while they share a buffer; one object is not
+	// safe to mutate from several threads at once. References, pointers and iterators
+	// obtained through a mutating accessor must not be used for writing after the vector has
+	// been copied again, since the copy shares the memory they point into.
+	template <class T, class Alloc_T = std::allocator<T>>
+	class cow_vector
+	{
+		using storage = vector<T, Alloc_T>;
+
+		struct shared_block
+		{
+			std::atomic<size_t> refs;
+			storage items;
+
+			template <typename... Ts>
+			explicit shared_block(Ts&&... args) : refs(1), items(std::forward<Ts>(args)...)
+			{}
+		};
+
+		using block_allocator = typename std::allocator_traits<Alloc_T>::template rebind_alloc<shared_block>;
+		using block_traits = std::allocator_traits<block_allocator>;
+
+		Alloc_T allocator_;
+		// null while empty and never mutated
+		shared_block* block_;
+
+	public:
+		using iterator = typename storage::iterator;
+		using constant_iterator = typename storage::constant_iterator;
+
+		cow_vector()noexcept;
+
+		explicit cow_vector(const Alloc_T& allocator)noexcept;
+
+		// Takes over the contents of items without copying them
+		explicit cow_vector(storage&& items);
+
+		explicit cow_vector(const storage& items);
+
+		cow_vector(std::initializer_list<T> list, const Alloc_T& allocator = Alloc_T());
+
+		explicit cow_vector(size_t size, const T& default_val, const Alloc_T& allocator = Alloc_T());
+
+		// O(1): shares the buffer of other
+		cow_vector(const cow_vector& other)noexcept;
+
+		cow_vector(cow_vector&& other)noexcept;
+
+		~cow_vector();
+
+		cow_vector& operator=(const cow_vector& other)noexcept;
+
+		cow_vector& operator=(cow_vector&& other)noexcept;
+
+		// Number of cow_vector objects sharing this buffer, 0 if there is none
+		[[nodiscard]] size_t use_count()const noexcept;
+
+		// Gives the buffer an owner of its own, cloning it if shared
+		void detach();
+
+		// Releases the buffer without cloning a shared one
+		void clear()noexcept;
+
+		void reserve(size_t new_capacity);
+
+		void resize(size_t new_size);
+
+		void resize(size_t new_size, const T& default_val);
+
+		void push_back(T&& value);
+
+		void push_back(const T& value);
+
+		template <typename... Ts>
+		T& emplace_back(Ts&&... args);
+
+		void pop_back();
+
+		[[nodiscard]] const T& at(size_t index)const;
+
+		T& at(size_t index);
+
+		const T& operator[](size_t index)const noexcept;
+
+		T& operator[](size_t index);
+
+		[[nodiscard]] const T* data()const noexcept;
+
+		T* data();
+
+		[[nodiscard]] bool empty()const noexcept;
+
+		[[nodiscard]] size_t size()const noexcept;
+
+		[[nodiscard]] size_t capacity()const noexcept;
+
+		T& front();
+
+		[[nodiscard]] const T& front()const;
+
+		T& back();
+
+		[[nodiscard]] const T& back()const;
+
+		void swap(cow_vector& other)noexcept;
+
+		iterator begin();
+
+		iterator end();
+
+		[[nodiscard]] constant_iterator begin()const;
+
+		[[nodiscard]] constant_iterator end()const;
+
+		[[nodiscard]] constant_iterator cbegin()const;
+
+		[[nodiscard]] constant_iterator cend()const;
+
+	private:
+		template <typename... Ts>
+		shared_block* make_block(Ts&&... args);
+
+		void release()noexcept;
+
+		// The buffer, owned by this object alone
+		storage& unique_items();
+	};
+
+
+	template <class T, class Alloc_T>
+	cow_vector<T, Alloc_T>::cow_vector() noexcept : cow_vector(Alloc_T())
+	{}
+
+	template <class T, class Alloc_T>
+	cow_vector<T, Alloc_T>::cow_vector(const Alloc_T& allocator) noexcept : allocator_(allocator), block_(nullptr)
+	{}
+
+	template <class T, class Alloc_T>
+	cow_vector<T, Alloc_T>::cow_vector(storage&& items) : allocator_(items.get_allocator()), block_(nullptr)
+	{
+		block_ = make_block(std::move(items));
+	}
+
+	template <class T, class Alloc_T>
+	cow_vector<T, Alloc_T>::cow_vector(const storage& items) : allocator_(items.get_allocator()), block_(nullptr)
+	{
+		block_ = make_block(items);
+	}
+
+	template <class T, class Alloc_T>
+	cow_vector<T, Alloc_T>::cow_vector(std::initializer_list<T> list, const Alloc_T& allocator)
+		: allocator_(allocator), block_(nullptr)
+	{
+		block_ = make_block(list, allocator);
+	}
+
+	template <class T, class Alloc_T>
+	cow_vector<T, Alloc_T>::cow_vector(size_t size, const T& default_val, const Alloc_T& allocator)
+		: allocator_(allocator), block_(nullptr)
+	{
+		block_ = make_block(size, default_val, allocator);
+	}
+
+	template <class T, class Alloc_T>
+	cow_vector<T, Alloc_T>::cow_vector(const cow_vector& other) noexcept
+		: allocator_(other.allocator_), block_(other.block_)
+	{
+		if (block_ != nullptr)
+		{
+			// a new owner only needs the count to go up; ordering comes from how other reached us
+			block_->refs.fetch_add(1, std::memory_order_relaxed);
+		}
+	}
+
+	template <class T, class Alloc_T>
+	cow_vector<T, Alloc_T>::cow_vector(cow_vector&& other) noexcept
+		: allocator_(other.allocator_), block_(std::exchange(other.block_, nullptr))
+	{}
+
+	template <class T, class Alloc_T>
+	cow_vector<T, Alloc_T>::~cow_vector()
+	{
+		release();
+	}
+
+	template <class T, class Alloc_T>
+	cow_vector<T, Alloc_T>& cow_vector<T, Alloc_T>::operator=(const cow_vector& other) noexcept
+	{
+		if (block_ != other.block_)
+		{
+			cow_vector copy(other);
+			swap(copy);
+		}
+		return *this;
+	}
+
+	template <class T, class Alloc_T>
+	cow_vector<T, Alloc_T>& cow_vector<T, Alloc_T>::operator=(cow_vector&& other) noexcept
+	{
+		if (this != &other)
+		{
+			release();
+			allocator_ = other.allocator_;
+			block_ = std::exchange(other.block_, nullptr);
+		}
+		return *this;
+	}
+
+	template <class T, class Alloc_T>
+	size_t cow_vector<T, Alloc_T>::use_count() const noexcept
+	{
+		return block_ == nullptr ? 0 : block_->refs.load(std::memory_order_relaxed);
+	}
+
+	template <class T, class Alloc_T>
+	void cow_vector<T, Alloc_T>::detach()
+	{
+		unique_items();
+	}
+
+	template <class T, class Alloc_T>
+	void cow_vector<T, Alloc_T>::clear() noexcept
+	{
+		release();
+		block_ = nullptr;
+	}
+
+	template <class T, class Alloc_T>
+	void cow_vector<T, Alloc_T>::reserve(size_t new_capacity)
+	{
+		if (new_capacity > capacity() || use_count() > 1)
+		{
+			unique_items().reserve(new_capacity);
+		}
+	}
+
+	template <class T, class Alloc_T>
+	void cow_vector<T, Alloc_T>::resize(size_t new_size)
+	{
+		if (new_size != size())
+		{
+			unique_items().resize(new_size);
+		}
+	}
+
+	template <class T, class Alloc_T>
+	void cow_vector<T, Alloc_T>::resize(size_t new_size, const T& default_val)
+	{
+		if (new_size != size())
+		{
+			unique_items().resize(new_size, default_val);
+		}
+	}
+
+	template <class T, class Alloc_T>
+	void cow_vector<T, Alloc_T>::push_back(T&& value)
+	{
+		unique_items().push_back(std::move(value));
+	}
+
+	template <class T, class Alloc_T>
+	void cow_vector<T, Alloc_T>::push_back(const T& value)
+	{
+		unique_items().push_back(value);
+	}
+
+	template <class T, class Alloc_T>
+	template <typename ... Ts>
+	T& cow_vector<T, Alloc_T>::emplace_back(Ts&&... args)
+	{
+		return unique_items().emplace_back(std::forward<Ts>(args)...);
+	}
+
+	template <class T, class Alloc_T>
+	void cow_vector<T, Alloc_T>::pop_back()
+	{
+		if (empty())
+		{
+			throw my_vector_exception("Vector is empty");
+		}
+		unique_items().pop_back();
+	}
+
+	template <class T, class Alloc_T>
+	const T& cow_vector<T, Alloc_T>::at(size_t index) const
+	{
+		if (index >= size())
+		{
+			throw my_vector_exception("index out of range");
+		}
+		return block_->items[index];
+	}
+
+	template <class T, class Alloc_T>
+	T& cow_vector<T, Alloc_T>::at(size_t index)
+	{
+		if (index >= size())
+		{
+			throw my_vector_exception("index out of range");
+		}
+		return unique_items()[index];
+	}
+
+	template <class T, class Alloc_T>
+	const T& cow_vector<T, Alloc_T>::operator[](size_t index) const noexcept
+	{
+		return block_->items[index];
+	}
+
+	template <class T, class Alloc_T>
+	T& cow_vector<T, Alloc_T>::operator[](size_t index)
+	{
+		return unique_items()[index];
+	}
+
+	template <class T, class Alloc_T>
+	const T* cow_vector<T, Alloc_T>::data() const noexcept
+	{
+		return block_ == nullptr ? nullptr : block_->items.data();
+	}
+
+	template <class T, class Alloc_T>
+	T* cow_vector<T, Alloc_T>::data()
+	{
+		return block_ == nullptr ? nullptr : unique_items().data();
+	}
+
+	template <class T, class Alloc_T>
+	bool cow_vector<T, Alloc_T>::empty() const noexcept
+	{
+		return size() == 0;
+	}
+
+	template <class T, class Alloc_T>
+	size_t cow_vector<T, Alloc_T>::size() const noexcept
+	{
+		return block_ == nullptr ? 0 : block_->items.size();
+	}
+
+	template <class T, class Alloc_T>
+	size_t cow_vector<T, Alloc_T>::capacity() const noexcept
+	{
+		return block_ == nullptr ? 0 : block_->items.capacity();
+	}
+
+	template <class T, class Alloc_T>
+	T& cow_vector<T, Alloc_T>::front()
+	{
+		if (empty())
+		{
+			throw my_vector_exception("Vector is empty!");
+		}
+		return unique_items().front();
+	}
+
+	template <class T, class Alloc_T>
+	const T& cow_vector<T, Alloc_T>::front() const
+	{
+		if (empty())
+		{
+			throw my_vector_exception("Vector is empty!");
+		}
+		return block_->items.front();
+	}
+
+	template <class T, class Alloc_T>
+	T& cow_vector<T, Alloc_T>::back()
+	{
+		if (empty())
+		{
+			throw my_vector_exception("Vector is empty!");
+		}
+		return unique_items().back();
+	}
+
+	template <class T, class Alloc_T>
+	const T& cow_vector<T, Alloc_T>::back() const
+	{
+		if (empty())
+		{
+			throw my_vector_exception("Vector is empty!");
+		}
+		return block_->items.back();
+	}
+
+	template <class T, class Alloc_T>
+	void cow_vector<T, Alloc_T>::swap(cow_vector& other) noexcept
+	{
+		std::swap(allocator_, other.allocator_);
+		std::swap(block_, other.block_);
+	}
+
+	template <class T, class Alloc_T>
+	typename cow_vector<T, Alloc_T>::iterator cow_vector<T, Alloc_T>::begin()
+	{
+		return iterator(data());
+	}
+
+	template <class T, class Alloc_T>
+	typename cow_vector<T, Alloc_T>::iterator cow_vector<T, Alloc_T>::end()
+	{
+		T* elements = data();
+		return iterator(elements + size());
+	}
+
+	template <class T, class Alloc_T>
+	typename cow_vector<T, Alloc_T>::constant_iterator cow_vector<T, Alloc_T>::begin() const
+	{
+		return constant_iterator(data());
+	}
+
+	template <class T, class Alloc_T>
+	typename cow_vector<T, Alloc_T>::constant_iterator cow_vector<T, Alloc_T>::end() const
+	{
+		return constant_iterator(data() + size());
+	}
+
+	template <class T, class Alloc_T>
+	typename cow_vector<T, Alloc_T>::constant_iterator cow_vector<T, Alloc_T>::cbegin() const
+	{
+		return begin();
+	}
+
+	template <class T, class Alloc_T>
+	typename cow_vector<T, Alloc_T>::constant_iterator cow_vector<T, Alloc_T>::cend() const
+	{
+		return end();
+	}
+
+	template <class T, class Alloc_T>
+	template <typename ... Ts>
+	typename cow_vector<T, Alloc_T>::shared_block* cow_vector<T, Alloc_T>::make_block(Ts&&... args)
+	{
+		block_allocator blocks(allocator_);
+		shared_block* block = block_traits::allocate(blocks, 1);
+		try
+		{
+			block_traits::construct(blocks, block, std::forward<Ts>(args)...);
+		}
+		catch (...)
+		{
+			block_traits::deallocate(blocks, block, 1);
+			throw;
+		}
+		return block;
+	}
+
+	template <class T, class Alloc_T>
+	void cow_vector<T, Alloc_T>::release() noexcept
+	{
+		// release publishes this owner's reads and writes; the last owner acquires them all
+		// before destroying the elements
+		if (block_ != nullptr && block_->refs.fetch_sub(1, std::memory_order_acq_rel) == 1)
+		{
+			block_allocator blocks(allocator_);
+			block_traits::destroy(blocks, block_);
+			block_traits::deallocate(blocks, block_, 1);
+		}
+	}
+
+	template <class T, class Alloc_T>
+	typename cow_vector<T, Alloc_T>::storage& cow_vector<T, Alloc_T>::unique_items()
+	{
+		if (block_ == nullptr)
+		{
+			block_ = make_block(allocator_);
+		}
+		// acquire pairs with the release of owners that let go, so their reads are done
+		else if (block_->refs.load(std::memory_order_acquire) != 1)
+		{
+			shared_block* copy = make_block(std::as_const(block_->items));
+			release();
+			block_ = copy;
+		}
+		return block_->items;
+	}
+}
@@ -0,0 +1,570 @@
+#pragma once
+#include "my_vector.h"
+#include <cerrno>
+#include <cstdint>
+#include <cstring>
+#include <fcntl.h>
+#include <limits>
+#include <string>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <type_traits>
+#include <unistd.h>
+
+namespace my_vector
+{
+	// On-disk layout of an mmap_vector file: this header, padded to data_offset bytes,
+	// followed by the elements. The file may be longer than needed for count elements;
+	// the rest is spare capacity.
+	struct mmap_vector_header
+	{
+		static constexpr uint64_t expected_magic = 0x524556504d4d594dULL;	// "MYMMPVER"
+		static constexpr uint32_t current_version = 1;
+		static constexpr size_t data_offset = 64;
+
+		uint64_t magic;
+		uint32_t version;
+		uint32_t element_size;
+		uint32_t element_alignment;
+		uint32_t reserved;
+		uint64_t count;
+	};
+
+	// Vector of trivially copyable elements stored in a memory-mapped file. Opening an
+	// existing file maps it in one call instead of rebuilding the contents; growth extends
+	// the file with ftruncate and remaps it. The element count is kept in the file header,
+	// so every change is visible to the next process that opens the file.
+	template <class T>
+	class mmap_vector
+	{
+		static_assert(std::is_trivially_copyable_v<T>, "mmap_vector stores elements as raw bytes");
+		static_assert(alignof(T) <= mmap_vector_header::data_offset, "element alignment exceeds the data offset");
+
+		int fd_;
+		unsigned char* map_;
+		size_t map_length_;
+		size_t capacity_;
+
+	public:
+		using iterator = typename vector<T>::iterator;
+		using constant_iterator = typename vector<T>::constant_iterator;
+
+		enum class open_mode
+		{
+			open_existing,	// fail if the file does not exist
+			open_or_create,	// reuse the file's contents, or start empty
+			truncate	// always start empty
+		};
+
+		explicit mmap_vector(const std::string& path, open_mode mode = open_mode::open_or_create);
+
+		mmap_vector(const mmap_vector& other) = delete;
+
+		mmap_vector(mmap_vector&& other) noexcept;
+
+		~mmap_vector();
+
+		mmap_vector& operator=(const mmap_vector& other) = delete;
+
+		mmap_vector& operator=(mmap_vector&& other) noexcept;
+
+		void clear()noexcept;
+
+		void reserve(size_t new_capacity);
+
+		void resize(size_t new_size);
+
+		void resize(size_t new_size, const T& default_val);
+
+		// Truncates the file to the space the current elements need
+		void shrink_to_fit();
+
+		void push_back(const T& value);
+
+		template <typename... Ts>
+		T& emplace_back(Ts&&... args);
+
+		void pop_back();
+
+		// Writes dirty pages back to the file (msync)
+		void flush();
+
+		[[nodiscard]] const T& at(size_t index)const;
+
+		T& at(size_t index);
+
+		const T& operator[](size_t index)const noexcept;
+
+		T& operator[](size_t index)noexcept;
+
+		[[nodiscard]] const T* data()const noexcept;
+
+		T* data()noexcept;
+
+		[[nodiscard]] bool empty()const noexcept;
+
+		// The most elements a mapping can hold without its byte length overflowing size_t
+		[[nodiscard]] size_t max_size()const noexcept;
+
+		[[nodiscard]] size_t size()const noexcept;
+
+		[[nodiscard]] size_t capacity()const noexcept;
+
+		T& front();
+
+		[[nodiscard]] const T& front()const;
+
+		T& back();
+
+		[[nodiscard]] const T& back()const;
+
+		iterator begin();
+
+		iterator end();
+
+		[[nodiscard]] constant_iterator begin()const;
+
+		[[nodiscard]] constant_iterator end()const;
+
+		[[nodiscard]] constant_iterator cbegin()const;
+
+		[[nodiscard]] constant_iterator cend()const;
+
+	private:
+		[[nodiscard]] mmap_vector_header& header()const noexcept;
+
+		[[nodiscard]] size_t calculate_capacity(const size_t new_size) const;
+
+		// Resizes the file to hold new_capacity elements and maps the new length
+		void remap(size_t new_capacity);
+
+		void validate_header(size_t file_length) const;
+
+		void close()noexcept;
+	};
+
+
+	template <class T>
+	mmap_vector<T>::mmap_vector(const std::string& path, open_mode mode)
+		: fd_(-1), map_(nullptr), map_length_(0), capacity_(0)
+	{
+		int flags = O_RDWR | O_CLOEXEC;
+		if (mode != open_mode::open_existing)
+		{
+			flags |= O_CREAT;
+		}
+		if (mode == open_mode::truncate)
+		{
+			flags |= O_TRUNC;
+		}
+		fd_ = ::open(path.c_str(), flags, 0644);
+		if (fd_ < 0)
+		{
+			throw my_vector_exception("cannot open " + path + ": " + std::strerror(errno));
+		}
+
+		struct stat info {};
+		if (fstat(fd_, &info) != 0)
+		{
+			close();
+			throw my_vector_exception("cannot stat " + path);
+		}
+
+		const size_t file_length = static_cast<size_t>(info.st_size);
+		if (file_length == 0)
+		{
+			try
+			{
+				remap(0);
+			}
+			catch (...)
+			{
+				close();
+				throw;
+			}
+			mmap_vector_header& fresh = header();
+			fresh.magic = mmap_vector_header::expected_magic;
+			fresh.version = mmap_vector_header::current_version;
+			fresh.element_size = sizeof(T);
+			fresh.element_alignment = alignof(T);
+			fresh.count = 0;
+			return;
+		}
+
+		void* mapped = file_length >= sizeof(mmap_vector_header)
+			? mmap(nullptr, file_length, PROT_READ | PROT_WRITE, MAP_SHARED, fd_, 0)
+			: MAP_FAILED;
+		if (mapped == MAP_FAILED)
+		{
+			close();
+			throw my_vector_exception("cannot map " + path);
+		}
+		map_ = static_cast<unsigned char*>(mapped);
+		map_length_ = file_length;
+		try
+		{
+			validate_header(file_length);
+		}
+		catch (...)
+		{
+			close();
+			throw;
+		}
+		capacity_ = (file_length - mmap_vector_header::data_offset) / sizeof(T);
+	}
+
+	template <class T>
+	mmap_vector<T>::mmap_vector(mmap_vector&& other) noexcept
+		: fd_(other.fd_), map_(other.map_), map_length_(other.map_length_), capacity_(other.capacity_)
+	{
+		other.fd_ = -1;
+		other.map_ = nullptr;
+		other.map_length_ = other.capacity_ = 0;
+	}
+
+	template <class T>
+	mmap_vector<T>::~mmap_vector()
+	{
+		close();
+	}
+
+	template <class T>
+	mmap_vector<T>& mmap_vector<T>::operator=(mmap_vector&& other) noexcept
+	{
+		if (this == &other) return *this;
+
+		close();
+		fd_ = other.fd_;
+		map_ = other.map_;
+		map_length_ = other.map_length_;
+		capacity_ = other.capacity_;
+		other.fd_ = -1;
+		other.map_ = nullptr;
+		other.map_length_ = other.capacity_ = 0;
+		return *this;
+	}
+
+	template <class T>
+	void mmap_vector<T>::clear() noexcept
+	{
+		if (map_ != nullptr)
+		{
+			header().count = 0;
+		}
+	}
+
+	template <class T>
+	void mmap_vector<T>::reserve(size_t new_capacity)
+	{
+		if (capacity_ >= new_capacity)
+		{
+			return;
+		}
+		if (new_capacity > max_size())
+		{
+			throw my_vector_exception("Capacity is too large");
+		}
+		remap(new_capacity);
+	}
+
+	template <class T>
+	void mmap_vector<T>::resize(size_t new_size)
+	{
+		reserve(new_size);
+		if (new_size > size())
+		{
+			construct_default_n(data() + size(), new_size - size());
+		}
+		header().count = new_size;
+	}
+
+	template <class T>
+	void mmap_vector<T>::resize(size_t new_size, const T& default_val)
+	{
+		const T value = default_val;
+		reserve(new_size);
+		if (new_size > size())
+		{
+			construct_fill_n(data() + size(), new_size - size(), value);
+		}
+		header().count = new_size;
+	}
+
+	template <class T>
+	void mmap_vector<T>::shrink_to_fit()
+	{
+		if (size() == capacity_)
+		{
+			return;
+		}
+		remap(size());
+	}
+
+	template <class T>
+	void mmap_vector<T>::push_back(const T& value)
+	{
+		emplace_back(value);
+	}
+
+	template <class T>
+	template <typename ... Ts>
+	T& mmap_vector<T>::emplace_back(Ts&&... args)
+	{
+		// built up front: the arguments may refer into the mapping, which growth can move
+		const T value(std::forward<Ts>(args)...);
+		const size_t count = size();
+		if (count == capacity_)
+		{
+			reserve(calculate_capacity(count + 1));
+		}
+
+		T* element = std::construct_at(data() + count, value);
+		header().count = count + 1;
+		return *element;
+	}
+
+	template <class T>
+	void mmap_vector<T>::pop_back()
+	{
+		if (size() == 0)
+		{
+			throw my_vector_exception("Vector is empty");
+		}
+		--header().count;
+	}
+
+	template <class T>
+	void mmap_vector<T>::flush()
+	{
+		if (map_ != nullptr && msync(map_, map_length_, MS_SYNC) != 0)
+		{
+			throw my_vector_exception(std::string("msync failed: ") + std::strerror(errno));
+		}
+	}
+
+	template <class T>
+	const T& mmap_vector<T>::at(size_t index) const
+	{
+		if (index >= size())
+		{
+			throw my_vector_exception("index out of range");
+		}
+		return data()[index];
+	}
+
+	template <class T>
+	T& mmap_vector<T>::at(size_t index)
+	{
+		if (index >= size())
+		{
+			throw my_vector_exception("index out of range");
+		}
+		return data()[index];
+	}
+
+	template <class T>
+	const T& mmap_vector<T>::operator[](size_t index) const noexcept
+	{
+		return data()[index];
+	}
+
+	template <class T>
+	T& mmap_vector<T>::operator[](size_t index) noexcept
+	{
+		return data()[index];
+	}
+
+	template <class T>
+	const T* mmap_vector<T>::data() const noexcept
+	{
+		return reinterpret_cast<const T*>(map_ + mmap_vector_header::data_offset);
+	}
+
+	template <class T>
+	T* mmap_vector<T>::data() noexcept
+	{
+		return reinterpret_cast<T*>(map_ + mmap_vector_header::data_offset);
+	}
+
+	template <class T>
+	bool mmap_vector<T>::empty() const noexcept
+	{
+		return size() == 0;
+	}
+
+	template <class T>
+	size_t mmap_vector<T>::max_size() const noexcept
+	{
+		return (std::numeric_limits<size_t>::max() - mmap_vector_header::data_offset) / sizeof(T);
+	}
+
+	template <class T>
+	size_t mmap_vector<T>::size() const noexcept
+	{
+		return map_ == nullptr ? 0 : header().count;
+	}
+
+	template <class T>
+	size_t mmap_vector<T>::capacity() const noexcept
+	{
+		return capacity_;
+	}
+
+	template <class T>
+	T& mmap_vector<T>::front()
+	{
+		if (size() == 0)
+		{
+			throw my_vector_exception("Vector is empty!");
+		}
+		return data()[0];
+	}
+
+	template <class T>
+	const T& mmap_vector<T>::front() const
+	{
+		if (size() == 0)
+		{
+			throw my_vector_exception("Vector is empty!");
+		}
+		return data()[0];
+	}
+
+	template <class T>
+	T& mmap_vector<T>::back()
+	{
+		if (size() == 0)
+		{
+			throw my_vector_exception("Vector is empty!");
+		}
+		return data()[size() - 1];
+	}
+
+	template <class T>
+	const T& mmap_vector<T>::back() const
+	{
+		if (size() == 0)
+		{
+			throw my_vector_exception("Vector is empty!");
+		}
+		return data()[size() - 1];
+	}
+
+	template <class T>
+	typename mmap_vector<T>::iterator mmap_vector<T>::begin()
+	{
+		return iterator(data());
+	}
+
+	template <class T>
+	typename mmap_vector<T>::iterator mmap_vector<T>::end()
+	{
+		return iterator(data() + size());
+	}
+
+	template <class T>
+	typename mmap_vector<T>::constant_iterator mmap_vector<T>::begin()const
+	{
+		return constant_iterator(data());
+	}
+
+	template <class T>
+	typename mmap_vector<T>::constant_iterator mmap_vector<T>::end()const
+	{
+		return constant_iterator(data() + size());
+	}
+
+	template <class T>
+	typename mmap_vector<T>::constant_iterator mmap_vector<T>::cbegin()const
+	{
+		return constant_iterator(data());
+	}
+
+	template <class T>
+	typename mmap_vector<T>::constant_iterator mmap_vector<T>::cend()const
+	{
+		return constant_iterator(data() + size());
+	}
+
+	template <class T>
+	mmap_vector_header& mmap_vector<T>::header() const noexcept
+	{
+		return *reinterpret_cast<mmap_vector_header*>(map_);
+	}
+
+	template <class T>
+	size_t mmap_vector<T>::calculate_capacity(const size_t new_size) const
+	{
+		if (new_size > max_size())
+		{
+			throw my_vector_exception("Capacity is too large");
+		}
+		return default_growth::grow(capacity_, new_size, max_size(), sizeof(T));
+	}
+
+	template <class T>
+	void mmap_vector<T>::remap(size_t new_capacity)
+	{
+		const size_t page = static_cast<size_t>(sysconf(_SC_PAGESIZE));
+		const size_t bytes = mmap_vector_header::data_offset + new_capacity * sizeof(T);
+		if (bytes > std::numeric_limits<size_t>::max() - (page - 1))
+		{
+			throw my_vector_exception("Capacity is too large");
+		}
+		const size_t new_length = (bytes + page - 1) / page * page;
+
+		if (ftruncate(fd_, static_cast<off_t>(new_length)) != 0)
+		{
+			throw my_vector_exception(std::string("cannot resize file: ") + std::strerror(errno));
+		}
+		void* mapped = map_ == nullptr
+			? mmap(nullptr, new_length, PROT_READ | PROT_WRITE, MAP_SHARED, fd_, 0)
+			: mremap(map_, map_length_, new_length, MREMAP_MAYMOVE);
+		if (mapped == MAP_FAILED)
+		{
+			throw my_vector_exception(std::string("cannot map file: ") + std::strerror(errno));
+		}
+		map_ = static_cast<unsigned char*>(mapped);
+		map_length_ = new_length;
+		capacity_ = (new_length - mmap_vector_header::data_offset) / sizeof(T);
+	}
+
+	template <class T>
+	void mmap_vector<T>::validate_header(size_t file_length) const
+	{
+		const mmap_vector_header& existing = header();
+		if (existing.magic != mmap_vector_header::expected_magic)
+		{
+			throw my_vector_exception("not an mmap_vector file");
+		}
+		if (existing.version != mmap_vector_header::current_version)
+		{
+			throw my_vector_exception("unsupported mmap_vector file version");
+		}
+		if (existing.element_size != sizeof(T) || existing.element_alignment != alignof(T))
+		{
+			throw my_vector_exception("mmap_vector file holds a different element type");
+		}
+		if (file_length < mmap_vector_header::data_offset
+			|| existing.count > (file_length - mmap_vector_header::data_offset) / sizeof(T))
+		{
+			throw my_vector_exception("mmap_vector file is truncated");
+		}
+	}
+
+	template <class T>
+	void mmap_vector<T>::close() noexcept
+	{
+		if (map_ != nullptr)
+		{
+			munmap(map_, map_length_);
+			map_ = nullptr;
+		}
+		if (fd_ >= 0)
+		{
+			::close(fd_);
+			fd_ = -1;
+		}
+		map_length_ = capacity_ = 0;
+	}
+}
@@ -1,16 +1,59 @@
 #pragma once
+#include "my_vector_allocation.h"
 #include "my_vector_exception.h"
+#include "my_vector_fill.h"
+#include "my_vector_growth.h"
+#include "my_vector_relocation.h"
+#include "my_vector_simd.h"
+#include "my_vector_stats.h"
+#include <algorithm>
+#include <array>
+#include <compare>
+#include <iterator>
 #include <memory>
+#include <ranges>
+#include <span>
+#include <utility>
 
 namespace my_vector
 {
-	template <class T, class Alloc_T = std::allocator<T>>
+	// Tag selecting the range constructor, as std::from_range does in C++23
+	struct from_range_t
+	{
+		explicit from_range_t() = default;
+	};
+	inline constexpr from_range_t from_range{};
+
+	// Ranges whose length is known before the first element is read, so they can be
+	// constructed in one pass after a single allocation
+	template <class R, class T>
+	concept sized_or_forward_range = std::ranges::input_range<R>
+		&& (std::ranges::forward_range<R> || std::ranges::sized_range<R>)
+		&& std::constructible_from<T, std::ranges::range_reference_t<R>>;
+
+	namespace detail
+	{
+		// Grants library extensions (I/O, parallel construction) access to a vector's
+		// uninitialized capacity
+		struct vector_access;
+	}
+
+	template <class T, class Alloc_T = std::allocator<T>, class Stats_T = no_stats, class Growth_T = default_growth>
 	class vector
 	{
+		friend struct detail::vector_access;
+
 		Alloc_T allocator_;
 		T* arr_;
 		size_t size_;
 		size_t capacity_;
+		[[no_unique_address]] Stats_T stats_;
+
+		using allocator_traits = std::allocator_traits<Alloc_T>;
+
+		// Move assignment can take over the other buffer instead of moving elements one by one
+		static constexpr bool propagates_on_move_assignment =
+			allocator_traits::propagate_on_container_move_assignment::value || allocator_traits::is_always_equal::value;
 
 	public:
 		class iterator
@@ -19,25 +62,48 @@ namespace my_vector
 			using iterator_category = std::contiguous_iterator_tag;
 			using difference_type = std::ptrdiff_t;
 			using value_type = T;
+			using element_type = value_type;
 			using pointer = value_type*;
 			using reference = value_type&;
 
-			iterator(pointer ptr);
+			constexpr iterator() noexcept = default;
 
-			reference operator*() const;
-			pointer operator->();
+			constexpr iterator(pointer ptr);
+
+			constexpr reference operator*() const;
+			constexpr pointer operator->() const;
+			constexpr reference operator[](difference_type offset) const;
 
 			// Prefix increment
-			iterator& operator++();
+			constexpr iterator& operator++();
 
 			// Postfix increment
-			iterator operator++(int);
+			constexpr iterator operator++(int);
+
+			// Prefix decrement
+			constexpr iterator& operator--();
+
+			// Postfix decrement
+			constexpr iterator operator--(int);
+
+			constexpr iterator& operator+=(difference_type offset);
+			constexpr iterator& operator-=(difference_type offset);
+
+			constexpr iterator operator+(difference_type offset) const;
+			constexpr iterator operator-(difference_type offset) const;
+			constexpr difference_type operator-(const iterator& b) const;
 
-			bool operator== (const iterator& b)const;
-			bool operator!= (const iterator& b)const;
+			friend constexpr iterator operator+(difference_type offset, const iterator& it)
+			{
+				return it + offset;
+			}
+
+			constexpr bool operator== (const iterator& b)const;
+			constexpr bool operator!= (const iterator& b)const;
+			constexpr std::strong_ordering operator<=> (const iterator& b)const;
 
 		private:
-			pointer m_ptr;
+			pointer m_ptr = nullptr;
 		};
 		class constant_iterator
 		{
@@ -45,254 +111,517 @@ namespace my_vector
 			using iterator_category = std::contiguous_iterator_tag;
 			using difference_type = std::ptrdiff_t;
 			using value_type = T;
-			using pointer = T*;
-			using reference = T&;
+			using element_type = const value_type;
+			using pointer = const T*;
+			using reference = const T&;
 			using const_reference = const T&;
 			using const_pointer = const T*;
 
-			explicit constant_iterator(pointer ptr);
+			constexpr constant_iterator() noexcept = default;
+
+			constexpr explicit constant_iterator(const_pointer ptr);
+
+			constexpr constant_iterator(const iterator& it);
 
-			const_reference operator*() const;
-			const_pointer operator->();
+			constexpr const_reference operator*() const;
+			constexpr const_pointer operator->() const;
+			constexpr const_reference operator[](difference_type offset) const;
 
 			// Prefix increment
-			constant_iterator& operator++();
+			constexpr constant_iterator& operator++();
 
 			// Postfix increment
-			constant_iterator operator++(int);
+			constexpr constant_iterator operator++(int);
+
+			// Prefix decrement
+			constexpr constant_iterator& operator--();
+
+			// Postfix decrement
+			constexpr constant_iterator operator--(int);
 
-			bool operator== (const constant_iterator& b)const;
-			bool operator!= (const constant_iterator& b)const;
+			constexpr constant_iterator& operator+=(difference_type offset);
+			constexpr constant_iterator& operator-=(difference_type offset);
+
+			constexpr constant_iterator operator+(difference_type offset) const;
+			constexpr constant_iterator operator-(difference_type offset) const;
+			constexpr difference_type operator-(const constant_iterator& b) const;
+
+			friend constexpr constant_iterator operator+(difference_type offset, const constant_iterator& it)
+			{
+				return it + offset;
+			}
+
+			constexpr bool operator== (const constant_iterator& b)const;
+			constexpr bool operator!= (const constant_iterator& b)const;
+			constexpr std::strong_ordering operator<=> (const constant_iterator& b)const;
 
 		private:
-			pointer m_ptr;
+			const_pointer m_ptr = nullptr;
 		};
 
-		explicit vector(size_t size, const T& default_val);
+		constexpr explicit vector(size_t size, const T& default_val, const Alloc_T& allocator = Alloc_T());
+
+		constexpr explicit vector(size_t size, const Alloc_T& allocator = Alloc_T());
+
+		constexpr vector(std::initializer_list<T> list, const Alloc_T& allocator = Alloc_T());
 
-		explicit vector(size_t size);
+		template <std::forward_iterator It>
+		constexpr vector(It first, It last, const Alloc_T& allocator = Alloc_T());
 
-		vector(std::initializer_list<T> list);
+		template <sized_or_forward_range<T> R>
+		constexpr vector(from_range_t, R&& range, const Alloc_T& allocator = Alloc_T());
 
-		vector()noexcept;
+		constexpr vector()noexcept;
 
-		vector(const vector& other);
+		constexpr explicit vector(const Alloc_T& allocator)noexcept;
 
-		vector(vector&& other) noexcept;
+		constexpr vector(const vector& other);
 
-		~vector();
+		constexpr vector(vector&& other) noexcept;
 
-		vector& operator=(vector&& other) noexcept;
+		constexpr ~vector();
 
-		vector& operator=(const vector& other);
+		constexpr vector& operator=(vector&& other) noexcept(propagates_on_move_assignment);
 
-		vector& operator=(std::initializer_list<T> list);
+		constexpr vector& operator=(const vector& other);
 
-		void clear()noexcept;
+		constexpr vector& operator=(std::initializer_list<T> list);
 
-		void reserve(size_t new_capacity);
+		constexpr void clear()noexcept;
 
-		void resize(size_t new_size);
+		constexpr void reserve(size_t new_capacity);
 
-		void resize(size_t new_size, const T& default_val);
+		constexpr void resize(size_t new_size);
 
-		void shrink_to_fit();
+		constexpr void resize(size_t new_size, const T& default_val);
 
-		void push_back(T&& value);
+		// Like resize, but new elements are default-initialized: trivially default constructible
+		// ones are left unwritten, for callers about to overwrite them
+		constexpr void resize_for_overwrite(size_t new_size);
 
-		void push_back(const T& value);
+		// Makes room for count more elements and calls writer(T* dest, size_t count), which fills
+		// a prefix of [dest, dest + count) and returns its length; that many elements are appended.
+		// Returns the number appended. If writer throws or reports more than count, or count
+		// would take the size past max_size(), the size is unchanged.
+		template <class Writer>
+			requires std::is_trivially_default_constructible_v<T>
+		constexpr size_t reserve_and_append(size_t count, Writer&& writer);
+
+		constexpr void shrink_to_fit();
+
+		constexpr void push_back(T&& value);
+
+		constexpr void push_back(const T& value);
 
 		template <typename... Ts>
-		T& emplace_back(Ts&&... args);
+		constexpr T& emplace_back(Ts&&... args);
+
+		constexpr void pop_back();
+
+		template <std::forward_iterator It>
+		constexpr iterator insert(constant_iterator pos, It first, It last);
+
+		template <std::ranges::forward_range R>
+		constexpr iterator insert_range(constant_iterator pos, R&& range);
+
+		template <sized_or_forward_range<T> R>
+		constexpr void append_range(R&& range);
+
+		template <sized_or_forward_range<T> R>
+		constexpr void assign_range(R&& range);
+
+		// Replace the contents. Like copy assignment they copy-assign over live elements,
+		// construct or destroy only the difference, and keep the storage when it is large enough.
+		// A throwing copy leaves a valid vector holding part of the new contents.
+		constexpr void assign(size_t count, const T& value);
+
+		template <std::forward_iterator It>
+		constexpr void assign(It first, It last);
+
+		constexpr iterator erase(constant_iterator pos);
+
+		constexpr iterator erase(constant_iterator first, constant_iterator last);
+
+		// Erase every element for which pred returns true in one pass, keeping the order of the
+		// rest and never allocating. Return the number erased. If pred throws, the elements it
+		// already rejected are gone and all others remain, in order.
+		template <class Pred>
+		constexpr size_t erase_if(Pred pred);
+
+		// Like erase_if with element == value; for T with simd kernels (int32_t, float, double)
+		// the survivors are packed with simd::remove. value must not refer to an element of
+		// this vector.
+		constexpr size_t erase_value(const T& value);
+
+		// Erase the element at index by moving the last one into its place: O(1), but the
+		// order of the elements is not kept. Throws if index is out of range.
+		constexpr void unordered_erase(size_t index);
 
-		void pop_back();
+		// Erase every element for which pred returns true, filling each hole with the last
+		// element that stays. Moves fewer elements than erase_if at the cost of their order.
+		template <class Pred>
+		constexpr size_t unordered_erase_if(Pred pred);
 
-		[[nodiscard]] const Alloc_T& get_allocator()const noexcept;
+		[[nodiscard]] constexpr const Alloc_T& get_allocator()const noexcept;
 
-		[[nodiscard]] const T& at(size_t index)const;
+		[[nodiscard]] constexpr const T& at(size_t index)const;
 
-		T& at(size_t index);
+		constexpr T& at(size_t index);
 
-		const T& operator[](size_t index)const noexcept;
+		constexpr const T& operator[](size_t index)const noexcept;
 
-		T& operator[](size_t index)noexcept;
+		constexpr T& operator[](size_t index)noexcept;
 
-		[[nodiscard]] const T* data()const noexcept;
+		[[nodiscard]] constexpr const T* data()const noexcept;
 
-		T* data()noexcept;
+		constexpr T* data()noexcept;
 
-		[[nodiscard]] bool empty()const noexcept;
+		[[nodiscard]] constexpr bool empty()const noexcept;
 
-		[[nodiscard]] size_t max_size()const noexcept;
+		[[nodiscard]] constexpr size_t max_size()const noexcept;
 
-		[[nodiscard]] size_t size()const noexcept;
+		[[nodiscard]] constexpr size_t size()const noexcept;
 
-		[[nodiscard]] size_t capacity()const noexcept;
+		[[nodiscard]] constexpr size_t capacity()const noexcept;
 
-		T& front();
+		// Memory activity recorded by the Stats_T policy, plus the current slack
+		[[nodiscard]] constexpr vector_stats stats()const noexcept;
 
-		[[nodiscard]] const T& front()const;
+		constexpr T& front();
 
-		T& back();
+		[[nodiscard]] constexpr const T& front()const;
 
-		[[nodiscard]] const T& back()const;
+		constexpr T& back();
 
-		void swap(vector& other) noexcept;
+		[[nodiscard]] constexpr const T& back()const;
 
-		iterator begin();
+		constexpr void swap(vector& other) noexcept;
 
-		iterator end();
+		constexpr iterator begin();
 
-		[[nodiscard]] constant_iterator begin()const;
+		constexpr iterator end();
 
-		[[nodiscard]] constant_iterator end()const;
+		[[nodiscard]] constexpr constant_iterator begin()const;
 
-		[[nodiscard]] constant_iterator cbegin()const;
+		[[nodiscard]] constexpr constant_iterator end()const;
 
-		[[nodiscard]] constant_iterator cend()const;
+		[[nodiscard]] constexpr constant_iterator cbegin()const;
+
+		[[nodiscard]] constexpr constant_iterator cend()const;
 
 
 	private:
-		[[nodiscard]] size_t calculate_capacity(const size_t new_size) const;
+		[[nodiscard]] constexpr size_t calculate_capacity(const size_t new_size) const;
+
+		[[nodiscard]] constexpr allocation_result<T*> allocate_storage(size_t count);
+		constexpr void deallocate_storage(T* ptr, size_t count) noexcept;
+		constexpr void init_storage(size_t count);
+		constexpr bool try_grow_in_place(size_t new_capacity);
+
+		constexpr void construct_with_value(size_t start, size_t end, const T& val);
+		constexpr void construct_default(size_t start, size_t end);
+
+		template <class It>
+		constexpr void insert_n(size_t index, size_t count, It first);
+
+		template <class It>
+		constexpr void assign_n(size_t count, It first);
 
-		void construct_with_value(int start, int end, const T& val);
-		void construct_default(int start, int end);
+		// Swaps in a block of exactly count elements built by construct(block), releasing the
+		// old one afterwards, so construct may still read from it
+		template <class Construct>
+		constexpr void rebuild(size_t count, Construct construct);
 
-		void free()noexcept;
+		// Moves the element at from into the erased one at hole, leaving from without a live object
+		constexpr void fill_hole(size_t hole, size_t from);
+
+		template <class R>
+		static constexpr size_t range_length(R&& range);
+
+		constexpr void free()noexcept;
+
+		constexpr void note_usage() noexcept;
 	};
 
 
-	template <class T, class Alloc_T>
-	vector<T, Alloc_T>::iterator::iterator(pointer ptr) : m_ptr(ptr)
+	template <class T, class Alloc_T, class Stats_T, class Growth_T>
+	constexpr vector<T, Alloc_T, Stats_T, Growth_T>::iterator::iterator(pointer ptr) : m_ptr(ptr)
 	{}
 
-	template <class T, class Alloc_T>
-	typename vector<T, Alloc_T>::iterator::reference vector<T, Alloc_T>::iterator::operator*() const
+	template <class T, class Alloc_T, class Stats_T, class Growth_T>
+	constexpr typename vector<T, Alloc_T, Stats_T, Growth_T>::iterator::reference vector<T, Alloc_T, Stats_T, Growth_T>::iterator::operator*() const
 	{
 		return *m_ptr;
 	}
 
-	template <class T, class Alloc_T>
-	typename vector<T, Alloc_T>::iterator::pointer vector<T, Alloc_T>::iterator::operator->()
+	template <class T, class Alloc_T, class Stats_T, class Growth_T>
+	constexpr typename vector<T, Alloc_T, Stats_T, Growth_T>::iterator::pointer vector<T, Alloc_T, Stats_T, Growth_T>::iterator::operator->() const
 	{
 		return m_ptr;
 	}
 
-	template <class T, class Alloc_T>
-	typename vector<T, Alloc_T>::iterator& vector<T, Alloc_T>::iterator::operator++()
+	template <class T, class Alloc_T, class Stats_T, class Growth_T>
+	constexpr typename vector<T, Alloc_T, Stats_T, Growth_T>::iterator::reference vector<T, Alloc_T, Stats_T, Growth_T>::iterator::operator[](difference_type offset) const
+	{
+		return m_ptr[offset];
+	}
+
+	template <class T, class Alloc_T, class Stats_T, class Growth_T>
+	constexpr typename vector<T, Alloc_T, Stats_T, Growth_T>::iterator& vector<T, Alloc_T, Stats_T, Growth_T>::iterator::operator++()
 	{
 		++m_ptr; return *this;
 	}
 
-	template <class T, class Alloc_T>
-	typename vector<T, Alloc_T>::iterator vector<T, Alloc_T>::iterator::operator++(int)
+	template <class T, class Alloc_T, class Stats_T, class Growth_T>
+	constexpr typename vector<T, Alloc_T, Stats_T, Growth_T>::iterator vector<T, Alloc_T, Stats_T, Growth_T>::iterator::operator++(int)
 	{
 		iterator tmp = *this; ++(*this); return tmp;
 	}
 
-	template <class T, class Alloc_T>
-	bool vector<T, Alloc_T>::iterator::operator==(const iterator& b) const
+	template <class T, class Alloc_T, class Stats_T, class Growth_T>
+	constexpr typename vector<T, Alloc_T, Stats_T, Growth_T>::iterator& vector<T, Alloc_T, Stats_T, Growth_T>::iterator::operator--()
+	{
+		--m_ptr; return *this;
+	}
+
+	template <class T, class Alloc_T, class Stats_T, class Growth_T>
+	constexpr typename vector<T, Alloc_T, Stats_T, Growth_T>::iterator vector<T, Alloc_T, Stats_T, Growth_T>::iterator::operator--(int)
+	{
+		iterator tmp = *this; --(*this); return tmp;
+	}
+
+	template <class T, class Alloc_T, class Stats_T, class Growth_T>
+	constexpr typename vector<T, Alloc_T, Stats_T, Growth_T>::iterator& vector<T, Alloc_T, Stats_T, Growth_T>::iterator::operator+=(difference_type offset)
+	{
+		m_ptr += offset; return *this;
+	}
+
+	template <class T, class Alloc_T, class Stats_T, class Growth_T>
+	constexpr typename vector<T, Alloc_T, Stats_T, Growth_T>::iterator& vector<T, Alloc_T, Stats_T, Growth_T>::iterator::operator-=(difference_type offset)
+	{
+		m_ptr -= offset; return *this;
+	}
+
+	template <class T, class Alloc_T, class Stats_T, class Growth_T>
+	constexpr typename vector<T, Alloc_T, Stats_T, Growth_T>::iterator vector<T, Alloc_T, Stats_T, Growth_T>::iterator::operator+(difference_type offset) const
+	{
+		iterator tmp = *this; return tmp += offset;
+	}
+
+	template <class T, class Alloc_T, class Stats_T, class Growth_T>
+	constexpr typename vector<T, Alloc_T, Stats_T, Growth_T>::iterator vector<T, Alloc_T, Stats_T, Growth_T>::iterator::operator-(difference_type offset) const
+	{
+		iterator tmp = *this; return tmp -= offset;
+	}
+
+	template <class T, class Alloc_T, class Stats_T, class Growth_T>
+	constexpr typename vector<T, Alloc_T, Stats_T, Growth_T>::iterator::difference_type vector<T, Alloc_T, Stats_T, Growth_T>::iterator::operator-(const iterator& b) const
+	{
+		return m_ptr - b.m_ptr;
+	}
+
+	template <class T, class Alloc_T, class Stats_T, class Growth_T>
+	constexpr bool vector<T, Alloc_T, Stats_T, Growth_T>::iterator::operator==(const iterator& b) const
 	{
 		return m_ptr == b.m_ptr;
 	}
 
-	template <class T, class Alloc_T>
-	bool vector<T, Alloc_T>::iterator::operator!=(const iterator& b) const
+	template <class T, class Alloc_T, class Stats_T, class Growth_T>
+	constexpr bool vector<T, Alloc_T, Stats_T, Growth_T>::iterator::operator!=(const iterator& b) const
 	{
 		return m_ptr != b.m_ptr;
 	}
 
-	template <class T, class Alloc_T>
-	vector<T, Alloc_T>::constant_iterator::constant_iterator(pointer ptr) : m_ptr(ptr)
+	template <class T, class Alloc_T, class Stats_T, class Growth_T>
+	constexpr std::strong_ordering vector<T, Alloc_T, Stats_T, Growth_T>::iterator::operator<=>(const iterator& b) const
+	{
+		return m_ptr <=> b.m_ptr;
+	}
+
+	template <class T, class Alloc_T, class Stats_T, class Growth_T>
+	constexpr vector<T, Alloc_T, Stats_T, Growth_T>::constant_iterator::constant_iterator(const_pointer ptr) : m_ptr(ptr)
 	{}
 
-	template <class T, class Alloc_T>
-	typename vector<T, Alloc_T>::constant_iterator::const_reference vector<T, Alloc_T>::constant_iterator::
-		operator*() const
+	template <class T, class Alloc_T, class Stats_T, class Growth_T>
+	constexpr vector<T, Alloc_T, Stats_T, Growth_T>::constant_iterator::constant_iterator(const iterator& it) : m_ptr(it.operator->())
+	{}
+
+	template <class T, class Alloc_T, class Stats_T, class Growth_T>
+	constexpr typename vector<T, Alloc_T, Stats_T, Growth_T>::constant_iterator::const_reference vector<T, Alloc_T, Stats_T, Growth_T>::constant_iterator::operator*() const
 	{
 		return *m_ptr;
 	}
 
-	template <class T, class Alloc_T>
-	typename vector<T, Alloc_T>::constant_iterator::const_pointer vector<T, Alloc_T>::constant_iterator::operator
-		->()
+	template <class T, class Alloc_T, class Stats_T, class Growth_T>
+	constexpr typename vector<T, Alloc_T, Stats_T, Growth_T>::constant_iterator::const_pointer vector<T, Alloc_T, Stats_T, Growth_T>::constant_iterator::operator->() const
 	{
 		return m_ptr;
 	}
 
-	template <class T, class Alloc_T>
-	typename vector<T, Alloc_T>::constant_iterator& vector<T, Alloc_T>::constant_iterator::operator++()
+	template <class T, class Alloc_T, class Stats_T, class Growth_T>
+	constexpr typename vector<T, Alloc_T, Stats_T, Growth_T>::constant_iterator::const_reference vector<T, Alloc_T, Stats_T, Growth_T>::constant_iterator::operator[](difference_type offset) const
+	{
+		return m_ptr[offset];
+	}
+
+	template <class T, class Alloc_T, class Stats_T, class Growth_T>
+	constexpr typename vector<T, Alloc_T, Stats_T, Growth_T>::constant_iterator& vector<T, Alloc_T, Stats_T, Growth_T>::constant_iterator::operator++()
 	{
 		++m_ptr; return *this;
 	}
 
-	template <class T, class Alloc_T>
-	typename vector<T, Alloc_T>::constant_iterator vector<T, Alloc_T>::constant_iterator::operator++(int)
+	template <class T, class Alloc_T, class Stats_T, class Growth_T>
+	constexpr typename vector<T, Alloc_T, Stats_T, Growth_T>::constant_iterator vector<T, Alloc_T, Stats_T, Growth_T>::constant_iterator::operator++(int)
 	{
 		constant_iterator tmp = *this; ++(*this); return tmp;
 	}
 
-	template <class T, class Alloc_T>
-	bool vector<T, Alloc_T>::constant_iterator::operator==(const constant_iterator& b) const
+	template <class T, class Alloc_T, class Stats_T, class Growth_T>
+	constexpr typename vector<T, Alloc_T, Stats_T, Growth_T>::constant_iterator& vector<T, Alloc_T, Stats_T, Growth_T>::constant_iterator::operator--()
+	{
+		--m_ptr; return *this;
+	}
+
+	template <class T, class Alloc_T, class Stats_T, class Growth_T>
+	constexpr typename vector<T, Alloc_T, Stats_T, Growth_T>::constant_iterator vector<T, Alloc_T, Stats_T, Growth_T>::constant_iterator::operator--(int)
+	{
+		constant_iterator tmp = *this; --(*this); return tmp;
+	}
+
+	template <class T, class Alloc_T, class Stats_T, class Growth_T>
+	constexpr typename vector<T, Alloc_T, Stats_T, Growth_T>::constant_iterator& vector<T, Alloc_T, Stats_T, Growth_T>::constant_iterator::operator+=(difference_type offset)
+	{
+		m_ptr += offset; return *this;
+	}
+
+	template <class T, class Alloc_T, class Stats_T, class Growth_T>
+	constexpr typename vector<T, Alloc_T, Stats_T, Growth_T>::constant_iterator& vector<T, Alloc_T, Stats_T, Growth_T>::constant_iterator::operator-=(difference_type offset)
+	{
+		m_ptr -= offset; return *this;
+	}
+
+	template <class T, class Alloc_T, class Stats_T, class Growth_T>
+	constexpr typename vector<T, Alloc_T, Stats_T, Growth_T>::constant_iterator vector<T, Alloc_T, Stats_T, Growth_T>::constant_iterator::operator+(difference_type offset) const
+	{
+		constant_iterator tmp = *this; return tmp += offset;
+	}
+
+	template <class T, class Alloc_T, class Stats_T, class Growth_T>
+	constexpr typename vector<T, Alloc_T, Stats_T, Growth_T>::constant_iterator vector<T, Alloc_T, Stats_T, Growth_T>::constant_iterator::operator-(difference_type offset) const
+	{
+		constant_iterator tmp = *this; return tmp -= offset;
+	}
+
+	template <class T, class Alloc_T, class Stats_T, class Growth_T>
+	constexpr typename vector<T, Alloc_T, Stats_T, Growth_T>::constant_iterator::difference_type vector<T, Alloc_T, Stats_T, Growth_T>::constant_iterator::operator-(const constant_iterator& b) const
+	{
+		return m_ptr - b.m_ptr;
+	}
+
+	template <class T, class Alloc_T, class Stats_T, class Growth_T>
+	constexpr bool vector<T, Alloc_T, Stats_T, Growth_T>::constant_iterator::operator==(const constant_iterator& b) const
 	{
 		return m_ptr == b.m_ptr;
 	}
 
-	template <class T, class Alloc_T>
-	bool vector<T, Alloc_T>::constant_iterator::operator!=(const constant_iterator& b) const
+	template <class T, class Alloc_T, class Stats_T, class Growth_T>
+	constexpr bool vector<T, Alloc_T, Stats_T, Growth_T>::constant_iterator::operator!=(const constant_iterator& b) const
 	{
 		return m_ptr != b.m_ptr;
 	}
 
-	template <class T, class Alloc_T>
-	vector<T, Alloc_T>::vector(size_t size)
+	template <class T, class Alloc_T, class Stats_T, class Growth_T>
+	constexpr std::strong_ordering vector<T, Alloc_T, Stats_T, Growth_T>::constant_iterator::operator<=>(const constant_iterator& b) const
+	{
+		return m_ptr <=> b.m_ptr;
+	}
+
+	template <class T, class Alloc_T, class Stats_T, class Growth_T>
+	constexpr vector<T, Alloc_T, Stats_T, Growth_T>::vector(size_t size, const Alloc_T& allocator) : allocator_(allocator)
 	{
-		capacity_ = size;
-		arr_ = allocator_.allocate(capacity_);
 		size_ = size;
-		construct_default(0, size_);
+		if constexpr (is_zero_initializable_v<T> && allocator_with_zeroed_allocation<Alloc_T, T>
+			&& !allocator_with_default_init<Alloc_T>)
+		{
+			arr_ = allocator_.allocate_zeroed(size);
+			capacity_ = size;
+			stats_.on_allocate(size * sizeof(T));
+		}
+		else
+		{
+			init_storage(size);
+			construct_default(0, size_);
+		}
+		note_usage();
 	}
 
-	template <class T, class Alloc_T>
-	vector<T, Alloc_T>::vector(std::initializer_list<T> list) : vector()
+	template <class T, class Alloc_T, class Stats_T, class Growth_T>
+	constexpr vector<T, Alloc_T, Stats_T, Growth_T>::vector(std::initializer_list<T> list, const Alloc_T& allocator) : vector(allocator)
 	{
 		reserve(list.size());
 		for (const T& element : list)
 		{
 			std::construct_at(&arr_[size_++], element);
 		}
+		note_usage();
 	}
 
-	template <class T, class Alloc_T>
-	vector<T, Alloc_T>::vector(size_t size, const T& default_val)
+	template <class T, class Alloc_T, class Stats_T, class Growth_T>
+	template <std::forward_iterator It>
+	constexpr vector<T, Alloc_T, Stats_T, Growth_T>::vector(It first, It last, const Alloc_T& allocator) : vector(allocator)
 	{
-		capacity_ = size;
-		arr_ = allocator_.allocate(capacity_);
+		const size_t count = std::distance(first, last);
+		reserve(count);
+		construct_copy_n(first, count, arr_);
+		size_ = count;
+		note_usage();
+	}
+
+	template <class T, class Alloc_T, class Stats_T, class Growth_T>
+	template <sized_or_forward_range<T> R>
+	constexpr vector<T, Alloc_T, Stats_T, Growth_T>::vector(from_range_t, R&& range, const Alloc_T& allocator) : vector(allocator)
+	{
+		append_range(std::forward<R>(range));
+	}
+
+	template <class T, class Alloc_T, class Stats_T, class Growth_T>
+	constexpr vector<T, Alloc_T, Stats_T, Growth_T>::vector(size_t size, const T& default_val, const Alloc_T& allocator) : allocator_(allocator)
+	{
+		init_storage(size);
 		size_ = size;
 		construct_with_value(0, size_, default_val);
+		note_usage();
 	}
 
-	template <class T, class Alloc_T>
-	vector<T, Alloc_T>::vector() noexcept
+	template <class T, class Alloc_T, class Stats_T, class Growth_T>
+	constexpr vector<T, Alloc_T, Stats_T, Growth_T>::vector() noexcept
 	{
 		arr_ = nullptr;
 		size_ = capacity_ = 0;
 	}
 
-	template <class T, class Alloc_T>
-	vector<T, Alloc_T>::vector(const vector& other)
+	template <class T, class Alloc_T, class Stats_T, class Growth_T>
+	constexpr vector<T, Alloc_T, Stats_T, Growth_T>::vector(const Alloc_T& allocator) noexcept : allocator_(allocator)
 	{
-		capacity_ = other.capacity_;
-		arr_ = allocator_.allocate(capacity_);
+		arr_ = nullptr;
+		size_ = capacity_ = 0;
+	}
+
+	template <class T, class Alloc_T, class Stats_T, class Growth_T>
+	constexpr vector<T, Alloc_T, Stats_T, Growth_T>::vector(const vector& other)
+		: allocator_(allocator_traits::select_on_container_copy_construction(other.allocator_))
+	{
+		init_storage(other.capacity_);
 		size_ = other.size_;
 		for (size_t i = 0; i < size_; ++i)
 		{
 			std::construct_at(&arr_[i], other.arr_[i]);
 		}
+		note_usage();
 	}
 
-	template <class T, class Alloc_T>
-	vector<T, Alloc_T>::vector(vector&& other) noexcept : allocator_(std::move(other.allocator_))
+	template <class T, class Alloc_T, class Stats_T, class Growth_T>
+	constexpr vector<T, Alloc_T, Stats_T, Growth_T>::vector(vector&& other) noexcept : allocator_(std::move(other.allocator_))
 	{
 		capacity_ = other.capacity_;
 		size_ = other.size_;
@@ -300,85 +629,107 @@ namespace my_vector
 
 		other.arr_ = nullptr;
 		other.capacity_ = other.size_ = 0;
+		note_usage();
 	}
 
-	template <class T, class Alloc_T>
-	vector<T, Alloc_T>::~vector()
+	template <class T, class Alloc_T, class Stats_T, class Growth_T>
+	constexpr vector<T, Alloc_T, Stats_T, Growth_T>::~vector()
 	{
 		free();
 	}
 
-	template <class T, class Alloc_T>
-	vector<T, Alloc_T>& vector<T, Alloc_T>::operator=(vector&& other) noexcept
+	template <class T, class Alloc_T, class Stats_T, class Growth_T>
+	constexpr vector<T, Alloc_T, Stats_T, Growth_T>& vector<T, Alloc_T, Stats_T, Growth_T>::operator=(vector&& other) noexcept(propagates_on_move_assignment)
 	{
+		if (this == &other) return *this;
+
+		if constexpr (!propagates_on_move_assignment)
+		{
+			if (!allocators_equal(allocator_, other.allocator_))
+			{
+				// our allocator cannot free the other buffer, so the elements move one by one
+				assign_range(std::ranges::subrange(std::make_move_iterator(other.begin()), std::make_move_iterator(other.end())));
+				other.clear();
+				return *this;
+			}
+		}
+
 		free();
-		allocator_ = std::move(other.allocator_);
+		if constexpr (allocator_traits::propagate_on_container_move_assignment::value)
+		{
+			allocator_ = std::move(other.allocator_);
+		}
 		arr_ = other.arr_;
 		capacity_ = other.capacity_;
 		size_ = other.size_;
 		other.arr_ = nullptr;
 		other.capacity_ = 0;
 		other.size_ = 0;
+		note_usage();
 		return *this;
 	}
 
-	template <class T, class Alloc_T>
-	vector<T, Alloc_T>& vector<T, Alloc_T>::operator=(const vector& other)
+	template <class T, class Alloc_T, class Stats_T, class Growth_T>
+	constexpr vector<T, Alloc_T, Stats_T, Growth_T>& vector<T, Alloc_T, Stats_T, Growth_T>::operator=(const vector& other)
 	{
 		if (this == &other) return *this;
 
-		free();
-		capacity_ = other.capacity_;
-		arr_ = allocator_.allocate(capacity_);
-		size_ = other.size_;
-		for (size_t i = 0; i < size_; ++i)
+		if constexpr (allocator_traits::propagate_on_container_copy_assignment::value)
 		{
-			std::construct_at(&arr_[i], other.arr_[i]);
+			if (!allocators_equal(allocator_, other.allocator_))
+			{
+				// the current block must go back to the allocator that made it
+				free();
+			}
+			allocator_ = other.allocator_;
 		}
+		assign_n(other.size_, other.arr_);
 		return *this;
 	}
 
-	template <class T, class Alloc_T>
-	vector<T, Alloc_T>& vector<T, Alloc_T>::operator=(std::initializer_list<T> list)
+	template <class T, class Alloc_T, class Stats_T, class Growth_T>
+	constexpr vector<T, Alloc_T, Stats_T, Growth_T>& vector<T, Alloc_T, Stats_T, Growth_T>::operator=(std::initializer_list<T> list)
 	{
-		clear();
-		reserve(list.size());
-		for (const T& element : list)
-		{
-			std::construct_at(&arr_[size_++], element);
-		}
+		assign_n(list.size(), list.begin());
 		return *this;
 	}
 
-	template <class T, class Alloc_T>
-	void vector<T, Alloc_T>::clear() noexcept
+	template <class T, class Alloc_T, class Stats_T, class Growth_T>
+	constexpr void vector<T, Alloc_T, Stats_T, Growth_T>::clear() noexcept
 	{
 		std::destroy_n(arr_, size_);
 		size_ = 0;
 	}
 
-	template <class T, class Alloc_T>
-	void vector<T, Alloc_T>::reserve(size_t new_capacity)
+	template <class T, class Alloc_T, class Stats_T, class Growth_T>
+	constexpr void vector<T, Alloc_T, Stats_T, Growth_T>::reserve(size_t new_capacity)
 	{
 		if (capacity_ >= new_capacity)
 		{
 			return;
 		}
 
-		T* new_arr = allocator_.allocate(new_capacity);
+		if (try_grow_in_place(new_capacity))
+		{
+			note_usage();
+			return;
+		}
 
-		for (size_t i = 0; i < size_; ++i)
+		const auto [new_arr, allocated] = allocate_storage(new_capacity);
+
+		relocate_n(arr_, size_, new_arr);
+		if (arr_ != nullptr)
 		{
-			std::construct_at(&new_arr[i], std::move(arr_[i]));
+			stats_.on_relocate(size_);
+			deallocate_storage(arr_, capacity_);
 		}
-		std::destroy_n(arr_, size_);
-		allocator_.deallocate(arr_, capacity_);
 		arr_ = new_arr;
-		capacity_ = new_capacity;
+		capacity_ = allocated;
+		note_usage();
 	}
 
-	template <class T, class Alloc_T>
-	void vector<T, Alloc_T>::resize(size_t new_size)
+	template <class T, class Alloc_T, class Stats_T, class Growth_T>
+	constexpr void vector<T, Alloc_T, Stats_T, Growth_T>::resize(size_t new_size)
 	{
 		reserve(new_size);
 		if (new_size > size_)
@@ -390,10 +741,11 @@ namespace my_vector
 			std::destroy(&arr_[new_size], &arr_[size_]);
 		}
 		size_ = new_size;
+		note_usage();
 	}
 
-	template <class T, class Alloc_T>
-	void vector<T, Alloc_T>::resize(size_t new_size, const T& default_val)
+	template <class T, class Alloc_T, class Stats_T, class Growth_T>
+	constexpr void vector<T, Alloc_T, Stats_T, Growth_T>::resize(size_t new_size, const T& default_val)
 	{
 		reserve(new_size);
 		if (new_size > size_)
@@ -405,43 +757,96 @@ namespace my_vector
 			std::destroy(&arr_[new_size], &arr_[size_]);
 		}
 		size_ = new_size;
+		note_usage();
+	}
+
+	template <class T, class Alloc_T, class Stats_T, class Growth_T>
+	constexpr void vector<T, Alloc_T, Stats_T, Growth_T>::resize_for_overwrite(size_t new_size)
+	{
+		reserve(new_size);
+		if (new_size > size_)
+		{
+			construct_for_overwrite_n(arr_ + size_, new_size - size_);
+		}
+		else if (new_size < size_)
+		{
+			std::destroy(&arr_[new_size], &arr_[size_]);
+		}
+		size_ = new_size;
+		note_usage();
+	}
+
+	template <class T, class Alloc_T, class Stats_T, class Growth_T>
+	template <class Writer>
+		requires std::is_trivially_default_constructible_v<T>
+	constexpr size_t vector<T, Alloc_T, Stats_T, Growth_T>::reserve_and_append(size_t count, Writer&& writer)
+	{
+		if (count > max_size() - size_)
+		{
+			throw my_vector_exception("Vector is too large");
+		}
+		if (size_ + count > capacity_)
+		{
+			reserve(calculate_capacity(size_ + count));
+		}
+		construct_for_overwrite_n(arr_ + size_, count);
+		const size_t written = std::forward<Writer>(writer)(arr_ + size_, count);
+		if (written > count)
+		{
+			throw my_vector_exception("Writer reported more elements than it was given");
+		}
+		size_ += written;
+		note_usage();
+		return written;
 	}
 
-	template <class T, class Alloc_T>
-	void vector<T, Alloc_T>::shrink_to_fit()
+	template <class T, class Alloc_T, class Stats_T, class Growth_T>
+	constexpr void vector<T, Alloc_T, Stats_T, Growth_T>::shrink_to_fit()
 	{
 		if (size_ == capacity_)
 		{
 			return;
 		}
 
-		T* new_arr = allocator_.allocate(size_);
-		for (size_t i = 0; i < size_; ++i)
+		if constexpr (is_trivially_relocatable_v<T> && allocator_with_reallocate<Alloc_T, T>)
 		{
-			std::construct_at(&new_arr[i], std::move(arr_[i]));
+			if (size_ != 0)
+			{
+				arr_ = allocator_.reallocate(arr_, capacity_, size_);
+				stats_.on_allocate(size_ * sizeof(T));
+				stats_.on_deallocate(capacity_ * sizeof(T));
+				stats_.on_relocate(size_);
+				capacity_ = size_;
+				note_usage();
+				return;
+			}
 		}
-		std::destroy_n(arr_, size_);
-		allocator_.deallocate(arr_, capacity_);
+
+		const auto [new_arr, allocated] = allocate_storage(size_);
+		relocate_n(arr_, size_, new_arr);
+		stats_.on_relocate(size_);
+		deallocate_storage(arr_, capacity_);
 
 		arr_ = new_arr;
-		capacity_ = size_;
+		capacity_ = allocated;
+		note_usage();
 	}
 
-	template <class T, class Alloc_T>
-	void vector<T, Alloc_T>::push_back(T&& value)
+	template <class T, class Alloc_T, class Stats_T, class Growth_T>
+	constexpr void vector<T, Alloc_T, Stats_T, Growth_T>::push_back(T&& value)
 	{
 		emplace_back(std::move(value));
 	}
 
-	template <class T, class Alloc_T>
-	void vector<T, Alloc_T>::push_back(const T& value)
+	template <class T, class Alloc_T, class Stats_T, class Growth_T>
+	constexpr void vector<T, Alloc_T, Stats_T, Growth_T>::push_back(const T& value)
 	{
 		emplace_back(value);
 	}
 
-	template <class T, class Alloc_T>
+	template <class T, class Alloc_T, class Stats_T, class Growth_T>
 	template <typename ... Ts>
-	T& vector<T, Alloc_T>::emplace_back(Ts&&... args)
+	constexpr T& vector<T, Alloc_T, Stats_T, Growth_T>::emplace_back(Ts&&... args)
 	{
 		if (size_ == capacity_)
 		{
@@ -450,11 +855,12 @@ namespace my_vector
 
 		T* temp = &arr_[size_];
 		std::construct_at(&arr_[size_++], std::forward<Ts>(args)...);
+		note_usage();
 		return *temp;
 	}
 
-	template <class T, class Alloc_T>
-	void vector<T, Alloc_T>::pop_back()
+	template <class T, class Alloc_T, class Stats_T, class Growth_T>
+	constexpr void vector<T, Alloc_T, Stats_T, Growth_T>::pop_back()
 	{
 		if (size_ == 0)
 		{
@@ -463,14 +869,257 @@ namespace my_vector
 		std::destroy_at(&arr_[--size_]);
 	}
 
-	template <class T, class Alloc_T>
-	const Alloc_T& vector<T, Alloc_T>::get_allocator() const noexcept
+	template <class T, class Alloc_T, class Stats_T, class Growth_T>
+	template <std::forward_iterator It>
+	constexpr typename vector<T, Alloc_T, Stats_T, Growth_T>::iterator vector<T, Alloc_T, Stats_T, Growth_T>::insert(constant_iterator pos, It first, It last)
+	{
+		const size_t index = pos - cbegin();
+		insert_n(index, std::distance(first, last), first);
+		return begin() + index;
+	}
+
+	template <class T, class Alloc_T, class Stats_T, class Growth_T>
+	template <std::ranges::forward_range R>
+	constexpr typename vector<T, Alloc_T, Stats_T, Growth_T>::iterator vector<T, Alloc_T, Stats_T, Growth_T>::insert_range(constant_iterator pos, R&& range)
+	{
+		const size_t index = pos - cbegin();
+		insert_n(index, range_length(range), std::ranges::begin(range));
+		return begin() + index;
+	}
+
+	template <class T, class Alloc_T, class Stats_T, class Growth_T>
+	template <sized_or_forward_range<T> R>
+	constexpr void vector<T, Alloc_T, Stats_T, Growth_T>::append_range(R&& range)
+	{
+		const size_t count = range_length(range);
+		if (size_ + count > capacity_)
+		{
+			reserve(calculate_capacity(size_ + count));
+		}
+		construct_copy_n(std::ranges::begin(range), count, arr_ + size_);
+		size_ += count;
+		note_usage();
+	}
+
+	template <class T, class Alloc_T, class Stats_T, class Growth_T>
+	template <sized_or_forward_range<T> R>
+	constexpr void vector<T, Alloc_T, Stats_T, Growth_T>::assign_range(R&& range)
+	{
+		assign_n(range_length(range), std::ranges::begin(range));
+	}
+
+	template <class T, class Alloc_T, class Stats_T, class Growth_T>
+	constexpr void vector<T, Alloc_T, Stats_T, Growth_T>::assign(size_t count, const T& value)
+	{
+		if (count > capacity_)
+		{
+			rebuild(count, [&](T* block) { construct_fill_n(block, count, value); });
+		}
+		else if (count <= size_)
+		{
+			std::fill_n(arr_, count, value);
+			std::destroy(arr_ + count, arr_ + size_);
+			size_ = count;
+		}
+		else
+		{
+			std::fill_n(arr_, size_, value);
+			construct_with_value(size_, count, value);
+			size_ = count;
+		}
+		note_usage();
+	}
+
+	template <class T, class Alloc_T, class Stats_T, class Growth_T>
+	template <std::forward_iterator It>
+	constexpr void vector<T, Alloc_T, Stats_T, Growth_T>::assign(It first, It last)
+	{
+		assign_n(std::distance(first, last), first);
+	}
+
+	template <class T, class Alloc_T, class Stats_T, class Growth_T>
+	constexpr typename vector<T, Alloc_T, Stats_T, Growth_T>::iterator vector<T, Alloc_T, Stats_T, Growth_T>::erase(constant_iterator pos)
+	{
+		return erase(pos, pos + 1);
+	}
+
+	template <class T, class Alloc_T, class Stats_T, class Growth_T>
+	constexpr typename vector<T, Alloc_T, Stats_T, Growth_T>::iterator vector<T, Alloc_T, Stats_T, Growth_T>::erase(constant_iterator first, constant_iterator last)
+	{
+		const size_t index = first - cbegin();
+		const size_t count = last - first;
+		if (count == 0)
+		{
+			return begin() + index;
+		}
+
+		T* gap = arr_ + index;
+		const size_t tail = size_ - index - count;
+		if constexpr (is_trivially_relocatable_v<T>)
+		{
+			std::destroy_n(gap, count);
+			relocate_overlapping_n(gap + count, tail, gap);
+		}
+		else
+		{
+			std::move(gap + count, arr_ + size_, gap);
+			std::destroy_n(gap + tail, count);
+		}
+		size_ -= count;
+		return begin() + index;
+	}
+
+	template <class T, class Alloc_T, class Stats_T, class Growth_T>
+	template <class Pred>
+	constexpr size_t vector<T, Alloc_T, Stats_T, Growth_T>::erase_if(Pred pred)
+	{
+		size_t kept = 0;
+		size_t i = 0;
+		try
+		{
+			if constexpr (std::is_trivially_copyable_v<T> && std::is_trivially_destructible_v<T>)
+			{
+				// copy every element and advance past the survivors: no branch to mispredict
+				for (; i < size_; ++i)
+				{
+					const T element = arr_[i];
+					arr_[kept] = element;
+					kept += pred(element) ? 0 : 1;
+				}
+			}
+			else
+			{
+				for (; i < size_; ++i)
+				{
+					if (pred(std::as_const(arr_[i])))
+					{
+						if constexpr (is_trivially_relocatable_v<T>)
+						{
+							std::destroy_at(arr_ + i);
+						}
+						continue;
+					}
+					if (kept != i)
+					{
+						if constexpr (is_trivially_relocatable_v<T>)
+						{
+							relocate_n(arr_ + i, 1, arr_ + kept);
+						}
+						else
+						{
+							arr_[kept] = std::move(arr_[i]);
+						}
+					}
+					++kept;
+				}
+			}
+		}
+		catch (...)
+		{
+			// keep the survivors so far followed by the unvisited [i, size_)
+			if constexpr (is_trivially_relocatable_v<T>)
+			{
+				relocate_overlapping_n(arr_ + i, size_ - i, arr_ + kept);
+			}
+			else if (kept != i)
+			{
+				std::move(arr_ + i, arr_ + size_, arr_ + kept);
+				std::destroy(arr_ + kept + (size_ - i), arr_ + size_);
+			}
+			size_ = kept + (size_ - i);
+			throw;
+		}
+		if constexpr (!is_trivially_relocatable_v<T>)
+		{
+			std::destroy(arr_ + kept, arr_ + size_);
+		}
+		const size_t erased = size_ - kept;
+		size_ = kept;
+		return erased;
+	}
+
+	template <class T, class Alloc_T, class Stats_T, class Growth_T>
+	constexpr size_t vector<T, Alloc_T, Stats_T, Growth_T>::erase_value(const T& value)
+	{
+		if constexpr (simd::detail::has_kernels_v<T>)
+		{
+			if (!std::is_constant_evaluated())
+			{
+				const std::span<T> elements(arr_, size_);
+				const size_t kept = static_cast<size_t>(simd::remove(elements, value) - elements.begin());
+				const size_t erased = size_ - kept;
+				size_ = kept;
+				return erased;
+			}
+		}
+		return erase_if([&](const T& element) { return element == value; });
+	}
+
+	template <class T, class Alloc_T, class Stats_T, class Growth_T>
+	constexpr void vector<T, Alloc_T, Stats_T, Growth_T>::unordered_erase(size_t index)
+	{
+		if (index >= size_)
+		{
+			throw my_vector_exception("index out of range");
+		}
+		if (index != size_ - 1)
+		{
+			fill_hole(index, size_ - 1);
+		}
+		else
+		{
+			std::destroy_at(arr_ + index);
+		}
+		--size_;
+	}
+
+	template <class T, class Alloc_T, class Stats_T, class Growth_T>
+	template <class Pred>
+	constexpr size_t vector<T, Alloc_T, Stats_T, Growth_T>::unordered_erase_if(Pred pred)
+	{
+		// no element at or past end is live; if pred throws, the vector keeps [0, end)
+		size_t end = size_;
+		size_t i = 0;
+		try
+		{
+			while (i < end)
+			{
+				if (!pred(std::as_const(arr_[i])))
+				{
+					++i;
+					continue;
+				}
+				while (end - 1 > i && pred(std::as_const(arr_[end - 1])))
+				{
+					std::destroy_at(arr_ + --end);
+				}
+				if (--end == i)
+				{
+					std::destroy_at(arr_ + i);
+					break;
+				}
+				fill_hole(i, end);
+				++i;
+			}
+		}
+		catch (...)
+		{
+			size_ = end;
+			throw;
+		}
+		const size_t erased = size_ - end;
+		size_ = end;
+		return erased;
+	}
+
+	template <class T, class Alloc_T, class Stats_T, class Growth_T>
+	constexpr const Alloc_T& vector<T, Alloc_T, Stats_T, Growth_T>::get_allocator() const noexcept
 	{
 		return allocator_;
 	}
 
-	template <class T, class Alloc_T>
-	const T& vector<T, Alloc_T>::at(size_t index) const
+	template <class T, class Alloc_T, class Stats_T, class Growth_T>
+	constexpr const T& vector<T, Alloc_T, Stats_T, Growth_T>::at(size_t index) const
 	{
 		if (index >= size_)
 		{
@@ -479,8 +1128,8 @@ namespace my_vector
 		return arr_[index];
 	}
 
-	template <class T, class Alloc_T>
-	T& vector<T, Alloc_T>::at(size_t index)
+	template <class T, class Alloc_T, class Stats_T, class Growth_T>
+	constexpr T& vector<T, Alloc_T, Stats_T, Growth_T>::at(size_t index)
 	{
 		if (index >= size_)
 		{
@@ -489,56 +1138,64 @@ namespace my_vector
 		return arr_[index];
 	}
 
-	template <class T, class Alloc_T>
-	const T& vector<T, Alloc_T>::operator[](size_t index) const noexcept
+	template <class T, class Alloc_T, class Stats_T, class Growth_T>
+	constexpr const T& vector<T, Alloc_T, Stats_T, Growth_T>::operator[](size_t index) const noexcept
 	{
 		return arr_[index];
 	}
 
-	template <class T, class Alloc_T>
-	T& vector<T, Alloc_T>::operator[](size_t index) noexcept
+	template <class T, class Alloc_T, class Stats_T, class Growth_T>
+	constexpr T& vector<T, Alloc_T, Stats_T, Growth_T>::operator[](size_t index) noexcept
 	{
 		return arr_[index];
 	}
 
-	template <class T, class Alloc_T>
-	const T* vector<T, Alloc_T>::data() const noexcept
+	template <class T, class Alloc_T, class Stats_T, class Growth_T>
+	constexpr const T* vector<T, Alloc_T, Stats_T, Growth_T>::data() const noexcept
 	{
 		return arr_;
 	}
 
-	template <class T, class Alloc_T>
-	T* vector<T, Alloc_T>::data() noexcept
+	template <class T, class Alloc_T, class Stats_T, class Growth_T>
+	constexpr T* vector<T, Alloc_T, Stats_T, Growth_T>::data() noexcept
 	{
 		return arr_;
 	}
 
-	template <class T, class Alloc_T>
-	bool vector<T, Alloc_T>::empty() const noexcept
+	template <class T, class Alloc_T, class Stats_T, class Growth_T>
+	constexpr bool vector<T, Alloc_T, Stats_T, Growth_T>::empty() const noexcept
 	{
 		return size_ == 0;
 	}
 
-	template <class T, class Alloc_T>
-	size_t vector<T, Alloc_T>::max_size() const noexcept
+	template <class T, class Alloc_T, class Stats_T, class Growth_T>
+	constexpr size_t vector<T, Alloc_T, Stats_T, Growth_T>::max_size() const noexcept
 	{
 		return std::allocator_traits<Alloc_T>::max_size(allocator_);
 	}
 
-	template <class T, class Alloc_T>
-	size_t vector<T, Alloc_T>::size() const noexcept
+	template <class T, class Alloc_T, class Stats_T, class Growth_T>
+	constexpr size_t vector<T, Alloc_T, Stats_T, Growth_T>::size() const noexcept
 	{
 		return size_;
 	}
 
-	template <class T, class Alloc_T>
-	size_t vector<T, Alloc_T>::capacity() const noexcept
+	template <class T, class Alloc_T, class Stats_T, class Growth_T>
+	constexpr size_t vector<T, Alloc_T, Stats_T, Growth_T>::capacity() const noexcept
 	{
 		return capacity_;
 	}
 
-	template <class T, class Alloc_T>
-	T& vector<T, Alloc_T>::front()
+	template <class T, class Alloc_T, class Stats_T, class Growth_T>
+	constexpr vector_stats vector<T, Alloc_T, Stats_T, Growth_T>::stats() const noexcept
+	{
+		vector_stats result = stats_.snapshot();
+		result.slack_bytes = (capacity_ - size_) * sizeof(T);
+		return result;
+	}
+
+	template <class T, class Alloc_T, class Stats_T, class Growth_T>
+	constexpr T& vector<T, Alloc_T, Stats_T, Growth_T>::front()
 	{
 		if (size_ == 0)
 		{
@@ -547,8 +1204,8 @@ namespace my_vector
 		return arr_[0];
 	}
 
-	template <class T, class Alloc_T>
-	const T& vector<T, Alloc_T>::front() const
+	template <class T, class Alloc_T, class Stats_T, class Growth_T>
+	constexpr const T& vector<T, Alloc_T, Stats_T, Growth_T>::front() const
 	{
 		if (size_ == 0)
 		{
@@ -557,8 +1214,8 @@ namespace my_vector
 		return arr_[0];
 	}
 
-	template <class T, class Alloc_T>
-	T& vector<T, Alloc_T>::back()
+	template <class T, class Alloc_T, class Stats_T, class Growth_T>
+	constexpr T& vector<T, Alloc_T, Stats_T, Growth_T>::back()
 	{
 		if (size_ == 0)
 		{
@@ -567,8 +1224,8 @@ namespace my_vector
 		return arr_[size_ - 1];
 	}
 
-	template <class T, class Alloc_T>
-	const T& vector<T, Alloc_T>::back() const
+	template <class T, class Alloc_T, class Stats_T, class Growth_T>
+	constexpr const T& vector<T, Alloc_T, Stats_T, Growth_T>::back() const
 	{
 		if (size_ == 0)
 		{
@@ -577,97 +1234,339 @@ namespace my_vector
 		return arr_[size_ - 1];
 	}
 
-	template <class T, class Alloc_T>
-	void vector<T, Alloc_T>::swap(vector& other) noexcept
+	template <class T, class Alloc_T, class Stats_T, class Growth_T>
+	constexpr void vector<T, Alloc_T, Stats_T, Growth_T>::swap(vector& other) noexcept
 	{
 		std::swap(other.arr_, arr_);
 		std::swap(other.capacity_, capacity_);
 		std::swap(other.size_, size_);
-		std::swap(other.allocator_, allocator_);
+		if constexpr (allocator_traits::propagate_on_container_swap::value)
+		{
+			std::swap(other.allocator_, allocator_);
+		}
 	}
 
-	template <class T, class Alloc_T>
-	typename vector<T, Alloc_T>::iterator vector<T, Alloc_T>::begin()
+	template <class T, class Alloc_T, class Stats_T, class Growth_T>
+	constexpr typename vector<T, Alloc_T, Stats_T, Growth_T>::iterator vector<T, Alloc_T, Stats_T, Growth_T>::begin()
 	{
 		return iterator(arr_);
 	}
 
-	template <class T, class Alloc_T>
-	typename vector<T, Alloc_T>::iterator vector<T, Alloc_T>::end()
+	template <class T, class Alloc_T, class Stats_T, class Growth_T>
+	constexpr typename vector<T, Alloc_T, Stats_T, Growth_T>::iterator vector<T, Alloc_T, Stats_T, Growth_T>::end()
 	{
 		return iterator(arr_ + size_);
 	}
 
-	template <class T, class Alloc_T>
-	typename vector<T, Alloc_T>::constant_iterator vector<T, Alloc_T>::begin()const
+	template <class T, class Alloc_T, class Stats_T, class Growth_T>
+	constexpr typename vector<T, Alloc_T, Stats_T, Growth_T>::constant_iterator vector<T, Alloc_T, Stats_T, Growth_T>::begin()const
 	{
 		return constant_iterator(arr_);
 	}
 
-	template <class T, class Alloc_T>
-	typename vector<T, Alloc_T>::constant_iterator vector<T, Alloc_T>::end()const
+	template <class T, class Alloc_T, class Stats_T, class Growth_T>
+	constexpr typename vector<T, Alloc_T, Stats_T, Growth_T>::constant_iterator vector<T, Alloc_T, Stats_T, Growth_T>::end()const
 	{
 		return constant_iterator(arr_ + size_);
 	}
 
-	template <class T, class Alloc_T>
-	typename vector<T, Alloc_T>::constant_iterator vector<T, Alloc_T>::cbegin()const
+	template <class T, class Alloc_T, class Stats_T, class Growth_T>
+	constexpr typename vector<T, Alloc_T, Stats_T, Growth_T>::constant_iterator vector<T, Alloc_T, Stats_T, Growth_T>::cbegin()const
 	{
 		return constant_iterator(arr_);
 	}
 
-	template <class T, class Alloc_T>
-	typename vector<T, Alloc_T>::constant_iterator vector<T, Alloc_T>::cend()const
+	template <class T, class Alloc_T, class Stats_T, class Growth_T>
+	constexpr typename vector<T, Alloc_T, Stats_T, Growth_T>::constant_iterator vector<T, Alloc_T, Stats_T, Growth_T>::cend()const
 	{
 		return constant_iterator(arr_ + size_);
 	}
 
-	template <class T, class Alloc_T>
-	size_t vector<T, Alloc_T>::calculate_capacity(const size_t new_size) const
+	template <class T, class Alloc_T, class Stats_T, class Growth_T>
+	constexpr size_t vector<T, Alloc_T, Stats_T, Growth_T>::calculate_capacity(const size_t new_size) const
+	{
+		return Growth_T::grow(capacity_, new_size, max_size(), sizeof(T));
+	}
+
+	template <class T, class Alloc_T, class Stats_T, class Growth_T>
+	constexpr allocation_result<T*> vector<T, Alloc_T, Stats_T, Growth_T>::allocate_storage(size_t count)
+	{
+		const allocation_result<T*> result = allocate_at_least<T>(allocator_, count);
+		stats_.on_allocate(result.count * sizeof(T));
+		return result;
+	}
+
+	template <class T, class Alloc_T, class Stats_T, class Growth_T>
+	constexpr void vector<T, Alloc_T, Stats_T, Growth_T>::deallocate_storage(T* ptr, size_t count) noexcept
+	{
+		allocator_.deallocate(ptr, count);
+		stats_.on_deallocate(count * sizeof(T));
+	}
+
+	template <class T, class Alloc_T, class Stats_T, class Growth_T>
+	constexpr void vector<T, Alloc_T, Stats_T, Growth_T>::init_storage(size_t count)
 	{
-		const size_t old_capacity = capacity_;
-		const size_t max = max_size();
+		const auto [ptr, allocated] = allocate_storage(count);
+		arr_ = ptr;
+		capacity_ = allocated;
+	}
 
+	template <class T, class Alloc_T, class Stats_T, class Growth_T>
+	constexpr bool vector<T, Alloc_T, Stats_T, Growth_T>::try_grow_in_place(size_t new_capacity)
+	{
+		if (arr_ == nullptr)
+		{
+			return false;
+		}
+		if constexpr (allocator_with_try_expand<Alloc_T, T>)
+		{
+			if (allocator_.try_expand(arr_, capacity_, new_capacity))
+			{
+				stats_.on_allocate((new_capacity - capacity_) * sizeof(T));
+				capacity_ = new_capacity;
+				return true;
+			}
+		}
+		if constexpr (is_trivially_relocatable_v<T> && allocator_with_reallocate<Alloc_T, T>)
+		{
+			arr_ = allocator_.reallocate(arr_, capacity_, new_capacity);
+			stats_.on_allocate(new_capacity * sizeof(T));
+			stats_.on_deallocate(capacity_ * sizeof(T));
+			stats_.on_relocate(size_);
+			capacity_ = new_capacity;
+			return true;
+		}
+		return false;
+	}
+
+	template <class T, class Alloc_T, class Stats_T, class Growth_T>
+	constexpr void vector<T, Alloc_T, Stats_T, Growth_T>::construct_with_value(size_t start, size_t end, const T& val)
+	{
+		construct_fill_n(arr_ + start, end - start, val);
+	}
+
+	template <class T, class Alloc_T, class Stats_T, class Growth_T>
+	constexpr void vector<T, Alloc_T, Stats_T, Growth_T>::construct_default(size_t start, size_t end)
+	{
+		if constexpr (allocator_with_default_init<Alloc_T>)
+		{
+			construct_for_overwrite_n(arr_ + start, end - start);
+		}
+		else
+		{
+			construct_default_n(arr_ + start, end - start);
+		}
+	}
+
+	template <class T, class Alloc_T, class Stats_T, class Growth_T>
+	template <class It>
+	constexpr void vector<T, Alloc_T, Stats_T, Growth_T>::insert_n(size_t index, size_t count, It first)
+	{
+		if (count == 0)
+		{
+			return;
+		}
 
-		if (old_capacity > max - old_capacity / 2)
+		T* position = arr_ + index;
+		const size_t tail = size_ - index;
+		if (size_ + count > capacity_)
+		{
+			// build the inserted elements first so a throwing copy leaves *this untouched
+			const auto [new_arr, new_capacity] = allocate_storage(calculate_capacity(size_ + count));
+			try
+			{
+				construct_copy_n(first, count, new_arr + index);
+			}
+			catch (...)
+			{
+				deallocate_storage(new_arr, new_capacity);
+				throw;
+			}
+			relocate_n(arr_, index, new_arr);
+			relocate_n(position, tail, new_arr + index + count);
+			if (arr_ != nullptr)
+			{
+				stats_.on_relocate(size_);
+				deallocate_storage(arr_, capacity_);
+			}
+			arr_ = new_arr;
+			capacity_ = new_capacity;
+		}
+		else if constexpr (is_trivially_relocatable_v<T>)
+		{
+			relocate_overlapping_n(position, tail, position + count);
+			try
+			{
+				construct_copy_n(first, count, position);
+			}
+			catch (...)
+			{
+				relocate_overlapping_n(position + count, tail, position);
+				throw;
+			}
+		}
+		else
 		{
-			return max; // geometric growth would overflow
+			T* old_end = arr_ + size_;
+			if (tail > count)
+			{
+				construct_copy_n(std::make_move_iterator(old_end - count), count, old_end);
+				size_ += count;
+				std::move_backward(position, old_end - count, old_end);
+				std::copy_n(first, count, position);
+				note_usage();
+				return;
+			}
+
+			It mid = std::next(first, tail);
+			construct_copy_n(mid, count - tail, old_end);
+			size_ += count - tail;
+			construct_copy_n(std::make_move_iterator(position), tail, position + count);
+			size_ += tail;
+			std::copy_n(first, tail, position);
+			note_usage();
+			return;
 		}
-		const size_t new_geometric_capacity = old_capacity + old_capacity / 2;
+		size_ += count;
+		note_usage();
+	}
 
-		if (new_geometric_capacity < new_size) {
-			return new_size; // geometric growth would be insufficient
+	template <class T, class Alloc_T, class Stats_T, class Growth_T>
+	template <class It>
+	constexpr void vector<T, Alloc_T, Stats_T, Growth_T>::assign_n(size_t count, It first)
+	{
+		if (count > capacity_)
+		{
+			rebuild(count, [&](T* block) { construct_copy_n(first, count, block); });
 		}
+		else if (count <= size_)
+		{
+			copy_assign_n(first, count, arr_);
+			std::destroy(arr_ + count, arr_ + size_);
+			size_ = count;
+		}
+		else
+		{
+			first = copy_assign_n(first, size_, arr_);
+			construct_copy_n(first, count - size_, arr_ + size_);
+			size_ = count;
+		}
+		note_usage();
+	}
 
-		return new_geometric_capacity;
+	template <class T, class Alloc_T, class Stats_T, class Growth_T>
+	template <class Construct>
+	constexpr void vector<T, Alloc_T, Stats_T, Growth_T>::rebuild(size_t count, Construct construct)
+	{
+		const auto [new_arr, allocated] = allocate_storage(count);
+		try
+		{
+			construct(new_arr);
+		}
+		catch (...)
+		{
+			deallocate_storage(new_arr, allocated);
+			throw;
+		}
+		free();
+		arr_ = new_arr;
+		capacity_ = allocated;
+		size_ = count;
 	}
 
-	template <class T, class Alloc_T>
-	void vector<T, Alloc_T>::construct_with_value(int start, int end, const T& val)
+	template <class T, class Alloc_T, class Stats_T, class Growth_T>
+	constexpr void vector<T, Alloc_T, Stats_T, Growth_T>::fill_hole(size_t hole, size_t from)
 	{
-		for (int i = start; i < end; ++i)
+		if constexpr (is_trivially_relocatable_v<T>)
 		{
-			std::construct_at(&arr_[i], val);
+			std::destroy_at(arr_ + hole);
+			relocate_n(arr_ + from, 1, arr_ + hole);
+		}
+		else
+		{
+			arr_[hole] = std::move(arr_[from]);
+			std::destroy_at(arr_ + from);
 		}
 	}
 
-	template <class T, class Alloc_T>
-	void vector<T, Alloc_T>::construct_default(int start, int end)
+	template <class T, class Alloc_T, class Stats_T, class Growth_T>
+	template <class R>
+	constexpr size_t vector<T, Alloc_T, Stats_T, Growth_T>::range_length(R&& range)
 	{
-		for (int i = start; i < end; ++i)
+		if constexpr (std::ranges::sized_range<R>)
+		{
+			return std::ranges::size(range);
+		}
+		else
 		{
-			std::construct_at(&arr_[i]);
+			return std::ranges::distance(range);
 		}
 	}
 
-	template <class T, class Alloc_T>
-	void vector<T, Alloc_T>::free() noexcept
+	template <class T, class Alloc_T, class Stats_T, class Growth_T>
+	constexpr void vector<T, Alloc_T, Stats_T, Growth_T>::free() noexcept
 	{
 		if (arr_ != nullptr)
 		{
 			std::destroy_n(arr_, size_);
-			allocator_.deallocate(arr_, capacity_);
+			deallocate_storage(arr_, capacity_);
 		}
+		arr_ = nullptr;
 		size_ = capacity_ = 0;
 	}
-}
+
+	template <class T, class Alloc_T, class Stats_T, class Growth_T>
+	constexpr void vector<T, Alloc_T, Stats_T, Growth_T>::note_usage() noexcept
+	{
+		stats_.on_usage(size_, capacity_, sizeof(T));
+	}
+
+	namespace detail
+	{
+		struct vector_access
+		{
+			// Commits elements constructed directly in the capacity beyond size():
+			// [vec.size(), count) must hold live objects, count <= vec.capacity()
+			template <class T, class Alloc_T, class Stats_T, class Growth_T>
+			static constexpr void set_size(vector<T, Alloc_T, Stats_T, Growth_T>& vec, size_t count) noexcept
+			{
+				vec.size_ = count;
+				vec.note_usage();
+			}
+		};
+	}
+
+	// Copies the vector returned by Build() into a std::array of exactly its size, so a table
+	// computed with vector during constant evaluation survives into the program:
+	//
+	//	constexpr auto squares = to_array<[] { vector<int> v; ...; return v; }>();
+	//
+	// Build runs twice, once for the size and once for the elements, and its element type
+	// must be default constructible.
+	template <auto Build>
+	consteval auto to_array()
+	{
+		using T = std::ranges::range_value_t<decltype(Build())>;
+		constexpr size_t size = Build().size();
+		std::array<T, size> result{};
+		const auto built = Build();
+		std::copy(built.begin(), built.end(), result.begin());
+		return result;
+	}
+
+	// The table built by Build as one object in read-only data, shared by every translation
+	// unit, and a fixed-extent view of it for runtime code
+	template <auto Build>
+	inline constexpr auto static_table = to_array<Build>();
+
+	template <auto Build>
+	inline constexpr std::span static_span{ static_table<Build> };
+
+	static_assert(std::contiguous_iterator<vector<int>::iterator>);
+	static_assert(std::contiguous_iterator<vector<int>::constant_iterator>);
+	static_assert(std::ranges::contiguous_range<vector<int>>);
+	static_assert(std::ranges::contiguous_range<const vector<int>>);
+	static_assert(std::ranges::sized_range<vector<int>>);
+	// the default stats policy adds nothing to the layout: an allocator slot and three words
+	static_assert(sizeof(vector<int>) == 4 * sizeof(void*));
+}
\ No newline at end of file
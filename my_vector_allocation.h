@@ -0,0 +1,87 @@
+#pragma once
+#include <concepts>
+#include <cstddef>
+#include <memory>
+
+namespace my_vector
+{
+	// Block returned by allocate_at_least: count may exceed the requested size and the
+	// whole block may be used. Mirrors C++23 std::allocation_result.
+	template <class Pointer>
+	struct allocation_result
+	{
+		Pointer ptr;
+		size_t count;
+	};
+
+	// Optional allocator hooks, detected on Alloc_T:
+	//
+	//	allocate_at_least(n) -> { ptr, count }	block holding count >= n elements (C++23 protocol)
+	//	allocate_zeroed(n) -> T*	block of n elements that already reads as zero bytes
+	//	try_expand(p, n, new_n) -> bool	grows the block at p in place, never moving it
+	//	reallocate(p, n, new_n) -> T*	resizes the block, possibly moving its bytes (realloc)
+	//	default_initializes == true	vector(n) and resize(n) default-initialize instead of
+	//		value-initializing, leaving trivial elements unwritten (see default_init_allocator)
+	//
+	// Blocks obtained through any hook are released with the usual deallocate(p, count).
+	// reallocate copies raw bytes, so the vector only uses it for trivially relocatable types.
+	template <class Alloc_T, class T>
+	concept allocator_with_allocate_at_least = requires(Alloc_T & allocator, size_t count)
+	{
+		{ allocator.allocate_at_least(count).ptr } -> std::convertible_to<T*>;
+		{ allocator.allocate_at_least(count).count } -> std::convertible_to<size_t>;
+	};
+
+	template <class Alloc_T, class T>
+	concept allocator_with_zeroed_allocation = requires(Alloc_T & allocator, size_t count)
+	{
+		{ allocator.allocate_zeroed(count) } -> std::same_as<T*>;
+	};
+
+	template <class Alloc_T, class T>
+	concept allocator_with_try_expand = requires(Alloc_T & allocator, T * ptr, size_t count)
+	{
+		{ allocator.try_expand(ptr, count, count) } -> std::same_as<bool>;
+	};
+
+	template <class Alloc_T, class T>
+	concept allocator_with_reallocate = requires(Alloc_T & allocator, T * ptr, size_t count)
+	{
+		{ allocator.reallocate(ptr, count, count) } -> std::same_as<T*>;
+	};
+
+	template <class Alloc_T>
+	concept allocator_with_default_init = requires
+	{
+		requires Alloc_T::default_initializes;
+	};
+
+	// Allocates at least count elements, reporting the real size of the block
+	template <class T, class Alloc_T>
+	constexpr allocation_result<T*> allocate_at_least(Alloc_T& allocator, size_t count)
+	{
+		if constexpr (allocator_with_allocate_at_least<Alloc_T, T>)
+		{
+			auto [ptr, allocated] = allocator.allocate_at_least(count);
+			return { ptr, allocated };
+		}
+		else
+		{
+			return { std::allocator_traits<Alloc_T>::allocate(allocator, count), count };
+		}
+	}
+
+	// Whether storage from one allocator may be released through the other
+	template <class Alloc_T>
+	constexpr bool allocators_equal(const Alloc_T& a, const Alloc_T& b) noexcept
+	{
+		if constexpr (std::allocator_traits<Alloc_T>::is_always_equal::value)
+		{
+			return true;
+		}
+		else
+		{
+			return a == b;
+		}
+	}
+}
@@ -0,0 +1,357 @@
+#pragma once
+#include "my_vector_allocation.h"
+#include <cstddef>
+#include <cstdint>
+#include <new>
+#include <type_traits>
+
+namespace my_vector
+{
+	// Bump-pointer arena. Allocation carves the next bytes out of the current block and
+	// individual deallocation is a no-op; everything is returned at once by release() or
+	// by the destructor. Blocks grow geometrically and come from ::operator new, after an
+	// optional caller-supplied initial buffer. Not thread-safe: use one arena per thread
+	// or per request.
+	class monotonic_arena
+	{
+		struct block_header
+		{
+			block_header* next;
+			size_t size;
+		};
+
+		block_header* blocks_ = nullptr;
+		unsigned char* initial_buffer_ = nullptr;
+		size_t initial_size_ = 0;
+		unsigned char* current_ = nullptr;
+		unsigned char* end_ = nullptr;
+		size_t next_block_size_;
+		size_t bytes_allocated_ = 0;
+
+	public:
+		static constexpr size_t default_block_size = size_t{ 64 } << 10;
+
+		explicit monotonic_arena(size_t initial_block_size = default_block_size) noexcept
+			: next_block_size_(initial_block_size)
+		{}
+
+		monotonic_arena(void* buffer, size_t size) noexcept
+			: initial_buffer_(static_cast<unsigned char*>(buffer)), initial_size_(size),
+			current_(initial_buffer_), end_(initial_buffer_ + size),
+			next_block_size_(size > default_block_size ? size : default_block_size)
+		{}
+
+		monotonic_arena(const monotonic_arena&) = delete;
+		monotonic_arena& operator=(const monotonic_arena&) = delete;
+
+		~monotonic_arena()
+		{
+			release();
+		}
+
+		void* allocate(size_t bytes, size_t alignment)
+		{
+			if (current_ == nullptr)
+			{
+				add_block(bytes + alignment);
+			}
+			unsigned char* result = align_up(current_, alignment);
+			if (result > end_ || static_cast<size_t>(end_ - result) < bytes)
+			{
+				add_block(bytes + alignment);
+				result = align_up(current_, alignment);
+			}
+			current_ = result + bytes;
+			bytes_allocated_ += bytes;
+			return result;
+		}
+
+		// Extends the most recent allocation in place when the current block has room
+		bool try_expand(void* ptr, size_t bytes, size_t new_bytes) noexcept
+		{
+			auto* block_end = static_cast<unsigned char*>(ptr) + bytes;
+			if (block_end != current_ || new_bytes < bytes
+				|| static_cast<size_t>(end_ - static_cast<unsigned char*>(ptr)) < new_bytes)
+			{
+				return false;
+			}
+			current_ = static_cast<unsigned char*>(ptr) + new_bytes;
+			bytes_allocated_ += new_bytes - bytes;
+			return true;
+		}
+
+		// Frees every block obtained from ::operator new and rewinds to the initial buffer
+		void release() noexcept
+		{
+			while (blocks_ != nullptr)
+			{
+				block_header* next = blocks_->next;
+				::operator delete(blocks_, blocks_->size);
+				blocks_ = next;
+			}
+			current_ = initial_buffer_;
+			end_ = initial_buffer_ + initial_size_;
+			bytes_allocated_ = 0;
+		}
+
+		// Bytes handed out since construction or the last release()
+		[[nodiscard]] size_t bytes_allocated() const noexcept
+		{
+			return bytes_allocated_;
+		}
+
+	private:
+		static unsigned char* align_up(unsigned char* ptr, size_t alignment) noexcept
+		{
+			const auto address = reinterpret_cast<std::uintptr_t>(ptr);
+			return ptr + ((alignment - address % alignment) % alignment);
+		}
+
+		void add_block(size_t min_bytes)
+		{
+			size_t size = next_block_size_;
+			while (size < min_bytes + sizeof(block_header))
+			{
+				size *= 2;
+			}
+			auto* block = static_cast<block_header*>(::operator new(size));
+			block->next = blocks_;
+			block->size = size;
+			blocks_ = block;
+			current_ = reinterpret_cast<unsigned char*>(block + 1);
+			end_ = reinterpret_cast<unsigned char*>(block) + size;
+			next_block_size_ = size * 2;
+		}
+	};
+
+	// Allocator drawing from a monotonic_arena. Containers keep the arena they were built
+	// with: the allocator does not propagate on assignment or swap, and moving between
+	// vectors on different arenas moves the elements instead of the buffer.
+	template <class T>
+	class monotonic_arena_allocator
+	{
+		template <class U>
+		friend class monotonic_arena_allocator;
+
+		monotonic_arena* arena_;
+
+	public:
+		using value_type = T;
+		using propagate_on_container_copy_assignment = std::false_type;
+		using propagate_on_container_move_assignment = std::false_type;
+		using propagate_on_container_swap = std::false_type;
+		using is_always_equal = std::false_type;
+
+		monotonic_arena_allocator(monotonic_arena& arena) noexcept : arena_(&arena)
+		{}
+
+		template <class U>
+		monotonic_arena_allocator(const monotonic_arena_allocator<U>& other) noexcept : arena_(other.arena_)
+		{}
+
+		T* allocate(size_t n)
+		{
+			if (n > static_cast<size_t>(-1) / sizeof(T))
+			{
+				throw std::bad_array_new_length();
+			}
+			return static_cast<T*>(arena_->allocate(n * sizeof(T), alignof(T)));
+		}
+
+		bool try_expand(T* ptr, size_t n, size_t new_n) noexcept
+		{
+			if (new_n > static_cast<size_t>(-1) / sizeof(T))
+			{
+				return false;
+			}
+			return arena_->try_expand(ptr, n * sizeof(T), new_n * sizeof(T));
+		}
+
+		void deallocate(T*, size_t) noexcept
+		{}
+
+		[[nodiscard]] monotonic_arena& arena() const noexcept
+		{
+			return *arena_;
+		}
+
+		template <class U>
+		bool operator==(const monotonic_arena_allocator<U>& other) const noexcept
+		{
+			return arena_ == other.arena_;
+		}
+	};
+
+	// Size-class pool. Requests up to max_pooled_size bytes are rounded up to a power of two
+	// and served from per-class free lists carved out of shared slabs, so freeing and
+	// reallocating blocks of the same class never reaches malloc. Larger requests go
+	// straight to ::operator new. Not thread-safe.
+	class pool_resource
+	{
+		static constexpr size_t min_class_size = 8;
+		static constexpr size_t class_count = 10;
+		static constexpr size_t slab_size = size_t{ 64 } << 10;
+
+		struct free_node
+		{
+			free_node* next;
+		};
+
+		struct slab_header
+		{
+			slab_header* next;
+			alignas(std::max_align_t) unsigned char data[1];
+		};
+
+		free_node* free_lists_[class_count] = {};
+		slab_header* slabs_ = nullptr;
+		unsigned char* slab_current_ = nullptr;
+		unsigned char* slab_end_ = nullptr;
+
+	public:
+		static constexpr size_t max_pooled_size = min_class_size << (class_count - 1);
+
+		pool_resource() noexcept = default;
+
+		pool_resource(const pool_resource&) = delete;
+		pool_resource& operator=(const pool_resource&) = delete;
+
+		~pool_resource()
+		{
+			release();
+		}
+
+		void* allocate(size_t bytes)
+		{
+			if (bytes > max_pooled_size)
+			{
+				return ::operator new(bytes);
+			}
+			const size_t index = class_index(bytes);
+			if (free_node* node = free_lists_[index])
+			{
+				free_lists_[index] = node->next;
+				return node;
+			}
+			return carve(min_class_size << index);
+		}
+
+		void deallocate(void* ptr, size_t bytes) noexcept
+		{
+			if (ptr == nullptr)
+			{
+				return;
+			}
+			if (bytes > max_pooled_size)
+			{
+				::operator delete(ptr, bytes);
+				return;
+			}
+			const size_t index = class_index(bytes);
+			free_lists_[index] = ::new(ptr) free_node{ free_lists_[index] };
+		}
+
+		// Returns every slab to the system. Blocks larger than max_pooled_size are not
+		// tracked and must have been deallocated already.
+		void release() noexcept
+		{
+			while (slabs_ != nullptr)
+			{
+				slab_header* next = slabs_->next;
+				::operator delete(slabs_);
+				slabs_ = next;
+			}
+			for (free_node*& list : free_lists_)
+			{
+				list = nullptr;
+			}
+			slab_current_ = slab_end_ = nullptr;
+		}
+
+	private:
+		static size_t class_index(size_t bytes) noexcept
+		{
+			size_t index = 0;
+			while ((min_class_size << index) < bytes)
+			{
+				++index;
+			}
+			return index;
+		}
+
+		void* carve(size_t class_size)
+		{
+			// classes are powers of two, so aligning to the class size keeps every block
+			// aligned for any type that fits in it
+			const size_t alignment = class_size < alignof(std::max_align_t) ? class_size : alignof(std::max_align_t);
+			if (slab_current_ != nullptr)
+			{
+				const auto address = reinterpret_cast<std::uintptr_t>(slab_current_);
+				slab_current_ += (alignment - address % alignment) % alignment;
+			}
+			if (slab_current_ == nullptr || slab_current_ > slab_end_
+				|| static_cast<size_t>(slab_end_ - slab_current_) < class_size)
+			{
+				auto* slab = static_cast<slab_header*>(::operator new(offsetof(slab_header, data) + slab_size));
+				slab->next = slabs_;
+				slabs_ = slab;
+				slab_current_ = slab->data;
+				slab_end_ = slab->data + slab_size;
+			}
+			void* result = slab_current_;
+			slab_current_ += class_size;
+			return result;
+		}
+	};
+
+	// Allocator drawing from a pool_resource; propagation follows monotonic_arena_allocator
+	template <class T>
+	class pool_allocator
+	{
+		static_assert(alignof(T) <= alignof(std::max_align_t), "pool blocks are aligned to max_align_t");
+
+		template <class U>
+		friend class pool_allocator;
+
+		pool_resource* pool_;
+
+	public:
+		using value_type = T;
+		using propagate_on_container_copy_assignment = std::false_type;
+		using propagate_on_container_move_assignment = std::false_type;
+		using propagate_on_container_swap = std::false_type;
+		using is_always_equal = std::false_type;
+
+		pool_allocator(pool_resource& pool) noexcept : pool_(&pool)
+		{}
+
+		template <class U>
+		pool_allocator(const pool_allocator<U>& other) noexcept : pool_(other.pool_)
+		{}
+
+		T* allocate(size_t n)
+		{
+			if (n > static_cast<size_t>(-1) / sizeof(T))
+			{
+				throw std::bad_array_new_length();
+			}
+			return static_cast<T*>(pool_->allocate(n * sizeof(T)));
+		}
+
+		void deallocate(T* ptr, size_t n) noexcept
+		{
+			pool_->deallocate(ptr, n * sizeof(T));
+		}
+
+		[[nodiscard]] pool_resource& resource() const noexcept
+		{
+			return *pool_;
+		}
+
+		template <class U>
+		bool operator==(const pool_allocator<U>& other) const noexcept
+		{
+			return pool_ == other.pool_;
+		}
+	};
+}
@@ -0,0 +1,40 @@
+#pragma once
+#include "my_vector_allocation.h"
+#include <memory>
+
+namespace my_vector
+{
+	// Adaptor that makes vector(n) and resize(n) default-initialize their new elements, so
+	// buffers of trivial types grow without zeroing bytes that are about to be overwritten
+	// (by read(), a decoder, ...). Everything else, including the optional allocation hooks,
+	// comes from Base.
+	template <class T, class Base = std::allocator<T>>
+	class default_init_allocator : public Base
+	{
+		using base_traits = std::allocator_traits<Base>;
+
+	public:
+		static constexpr bool default_initializes = true;
+
+		template <class U>
+		struct rebind
+		{
+			using other = default_init_allocator<U, typename base_traits::template rebind_alloc<U>>;
+		};
+
+		using Base::Base;
+
+		default_init_allocator() = default;
+
+		constexpr explicit default_init_allocator(const Base& base) noexcept : Base(base)
+		{}
+
+		template <class U, class OtherBase>
+		constexpr default_init_allocator(const default_init_allocator<U, OtherBase>& other) noexcept
+			: Base(static_cast<const OtherBase&>(other))
+		{}
+	};
+
+	static_assert(allocator_with_default_init<default_init_allocator<int>>);
+	static_assert(!allocator_with_default_init<std::allocator<int>>);
+}
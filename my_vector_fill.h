@@ -0,0 +1,272 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <iterator>
+#include <memory>
+#include <type_traits>
+
+#if defined(__AVX2__) || defined(__SSE2__)
+#include <immintrin.h>
+#endif
+
+namespace my_vector
+{
+	// A type is zero initializable when a value-initialized object is all zero bytes,
+	// so a block of them can be produced by memset or by zeroed pages. That holds for
+	// scalars other than pointers to members (whose null value is -1 on common ABIs).
+	// Trivial class types can opt in by specializing.
+	template <class T>
+	struct is_zero_initializable
+		: std::bool_constant<std::is_scalar_v<T> && !std::is_member_pointer_v<T>>
+	{};
+
+	template <class T>
+	inline constexpr bool is_zero_initializable_v = is_zero_initializable<T>::value;
+
+	namespace detail
+	{
+		// Blocks above this size are written with streaming stores, bypassing the cache
+		inline constexpr size_t streaming_fill_threshold = size_t{ 4 } << 20;
+
+		// Fills bytes of dest with a pattern whose period divides 32.
+		// pattern must hold 64 bytes: two periods of 32 bytes each.
+		inline void fill_pattern(unsigned char* dest, size_t bytes, const unsigned char* pattern)
+		{
+#if defined(__AVX2__) || defined(__SSE2__)
+#if defined(__AVX2__)
+			constexpr size_t width = 32;
+#else
+			constexpr size_t width = 16;
+#endif
+			size_t head = (width - reinterpret_cast<std::uintptr_t>(dest) % width) % width;
+			if (head > bytes)
+			{
+				head = bytes;
+			}
+			std::memcpy(dest, pattern, head);
+			dest += head;
+			bytes -= head;
+
+			// the pattern repeats every 32 bytes, so shift it to the phase of the aligned part
+			const unsigned char* phase = pattern + head % 32;
+			const bool streaming = bytes >= streaming_fill_threshold;
+#if defined(__AVX2__)
+			const __m256i wide = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(phase));
+			for (; bytes >= width; bytes -= width, dest += width)
+			{
+				if (streaming)
+				{
+					_mm256_stream_si256(reinterpret_cast<__m256i*>(dest), wide);
+				}
+				else
+				{
+					_mm256_store_si256(reinterpret_cast<__m256i*>(dest), wide);
+				}
+			}
+#else
+			const __m128i lo = _mm_loadu_si128(reinterpret_cast<const __m128i*>(phase));
+			const __m128i hi = _mm_loadu_si128(reinterpret_cast<const __m128i*>(phase + 16));
+			bool odd = false;
+			for (; bytes >= width; bytes -= width, dest += width, odd = !odd)
+			{
+				const __m128i wide = odd ? hi : lo;
+				if (streaming)
+				{
+					_mm_stream_si128(reinterpret_cast<__m128i*>(dest), wide);
+				}
+				else
+				{
+					_mm_store_si128(reinterpret_cast<__m128i*>(dest), wide);
+				}
+			}
+			if (odd)
+			{
+				phase += 16;
+			}
+#endif
+			if (streaming)
+			{
+				_mm_sfence();
+			}
+			std::memcpy(dest, phase, bytes);
+#else
+			for (size_t i = 0; i < bytes; ++i)
+			{
+				dest[i] = pattern[i % 32];
+			}
+#endif
+		}
+
+		// Fills count objects at dest with copies of value for element sizes that do not
+		// divide 32: doubles the filled prefix with memcpy, then repeats a cache-sized block.
+		inline void fill_by_doubling(unsigned char* dest, size_t count, const void* value, size_t element_size)
+		{
+			constexpr size_t max_block = size_t{ 16 } << 10;
+			const size_t total = count * element_size;
+
+			std::memcpy(dest, value, element_size);
+			size_t filled = element_size;
+			while (filled < total && filled * 2 <= max_block)
+			{
+				const size_t chunk = filled < total - filled ? filled : total - filled;
+				std::memcpy(dest + filled, dest, chunk);
+				filled += chunk;
+			}
+			const size_t block = filled;
+			while (filled < total)
+			{
+				const size_t chunk = block < total - filled ? block : total - filled;
+				std::memcpy(dest + filled, dest, chunk);
+				filled += chunk;
+			}
+		}
+	}
+
+	// Value-initializes count objects in the uninitialized storage at dest
+	template <class T>
+	constexpr void construct_default_n(T* dest, size_t count)
+	{
+		// constant evaluation has neither memset nor the uninitialized algorithms
+		if (std::is_constant_evaluated())
+		{
+			for (size_t i = 0; i < count; ++i)
+			{
+				std::construct_at(dest + i);
+			}
+			return;
+		}
+		if constexpr (is_zero_initializable_v<T>)
+		{
+			if (count != 0)
+			{
+				std::memset(static_cast<void*>(dest), 0, count * sizeof(T));
+			}
+		}
+		else
+		{
+			std::uninitialized_value_construct_n(dest, count);
+		}
+	}
+
+	// Default-initializes count objects in the uninitialized storage at dest. Trivially default
+	// constructible types get no initialization, so the storage is not even touched.
+	template <class T>
+	constexpr void construct_for_overwrite_n(T* dest, size_t count)
+	{
+		// constant evaluation only allows writes to constructed objects
+		if (std::is_constant_evaluated())
+		{
+			for (size_t i = 0; i < count; ++i)
+			{
+				std::construct_at(dest + i);
+			}
+			return;
+		}
+		std::uninitialized_default_construct_n(dest, count);
+	}
+
+	// Copy-constructs count objects equal to value in the uninitialized storage at dest
+	template <class T>
+	constexpr void construct_fill_n(T* dest, size_t count, const T& value)
+	{
+		if (std::is_constant_evaluated())
+		{
+			for (size_t i = 0; i < count; ++i)
+			{
+				std::construct_at(dest + i, value);
+			}
+			return;
+		}
+		if constexpr (std::is_trivially_copyable_v<T>)
+		{
+			if (count == 0)
+			{
+				return;
+			}
+			auto* bytes = reinterpret_cast<unsigned char*>(dest);
+			if constexpr (sizeof(T) == 1)
+			{
+				unsigned char byte;
+				std::memcpy(&byte, &value, 1);
+				std::memset(bytes, byte, count);
+			}
+			else if constexpr (32 % sizeof(T) == 0)
+			{
+				unsigned char pattern[64];
+				for (size_t offset = 0; offset < sizeof(pattern); offset += sizeof(T))
+				{
+					std::memcpy(pattern + offset, &value, sizeof(T));
+				}
+				detail::fill_pattern(bytes, count * sizeof(T), pattern);
+			}
+			else
+			{
+				detail::fill_by_doubling(bytes, count, &value, sizeof(T));
+			}
+		}
+		else
+		{
+			std::uninitialized_fill_n(dest, count, value);
+		}
+	}
+
+	// Copy-constructs count objects from the sequence starting at first into the uninitialized
+	// storage at dest. Contiguous sources of trivially copyable T are copied with one memcpy.
+	// If a constructor throws, the objects built so far are destroyed.
+	template <class It, class T>
+	constexpr void construct_copy_n(It first, size_t count, T* dest)
+	{
+		if constexpr (std::contiguous_iterator<It> && std::is_trivially_copyable_v<T>
+			&& std::is_same_v<std::remove_cv_t<std::iter_value_t<It>>, T>)
+		{
+			// constant evaluation takes the element-wise loop below
+			if (!std::is_constant_evaluated())
+			{
+				if (count != 0)
+				{
+					std::memcpy(static_cast<void*>(dest), static_cast<const void*>(std::to_address(first)), count * sizeof(T));
+				}
+				return;
+			}
+		}
+		size_t constructed = 0;
+		try
+		{
+			for (; constructed < count; ++constructed, ++first)
+			{
+				std::construct_at(dest + constructed, *first);
+			}
+		}
+		catch (...)
+		{
+			std::destroy_n(dest, constructed);
+			throw;
+		}
+	}
+
+	// Copy-assigns count elements from the sequence starting at first over the live objects at
+	// dest and returns the iterator past the last element read. Contiguous sources of trivially
+	// copyable T are copied with one memcpy.
+	template <class It, class T>
+	constexpr It copy_assign_n(It first, size_t count, T* dest)
+	{
+		if constexpr (std::contiguous_iterator<It> && std::is_trivially_copyable_v<T>
+			&& std::is_same_v<std::remove_cv_t<std::iter_value_t<It>>, T>)
+		{
+			if (!std::is_constant_evaluated())
+			{
+				if (count != 0)
+				{
+					std::memcpy(static_cast<void*>(dest), static_cast<const void*>(std::to_address(first)), count * sizeof(T));
+				}
+				return first + count;
+			}
+		}
+		for (size_t i = 0; i < count; ++i, ++first)
+		{
+			dest[i] = *first;
+		}
+		return first;
+	}
+}
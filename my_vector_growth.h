@@ -0,0 +1,112 @@
+#pragma once
+#include <cstddef>
+#include <limits>
+
+namespace my_vector
+{
+	// Growth policies are the fourth template parameter of vector. When an insertion needs
+	// more room than capacity holds, the vector asks
+	//
+	//	static size_t grow(size_t capacity, size_t required, size_t max_size, size_t element_size)
+	//
+	// for the capacity to allocate. The result must lie in [required, max_size]; required
+	// never exceeds max_size. Explicit reserve() calls bypass the policy.
+
+	// Multiplies the capacity by Numerator / Denominator
+	template <size_t Numerator, size_t Denominator = 1>
+	struct factor_growth
+	{
+		static_assert(Denominator > 0 && Numerator > Denominator, "growth factor must exceed 1");
+
+		static constexpr size_t grow(size_t capacity, size_t required, size_t max_size, size_t) noexcept
+		{
+			// capacity * (factor - 1), computed without overflowing the product
+			constexpr size_t extra = Numerator - Denominator;
+			const size_t increment = capacity / Denominator * extra + capacity % Denominator * extra / Denominator;
+			if (capacity > max_size - increment || increment > max_size)
+			{
+				return max_size;
+			}
+			const size_t geometric = capacity + increment;
+			return geometric < required ? required : geometric;
+		}
+	};
+
+	// The vector's original behaviour: 1.5x, which lets a freed block be reused after a few
+	// reallocations, unlike 2x whose new block always exceeds all previous ones combined
+	using default_growth = factor_growth<3, 2>;
+
+	// Adds a fixed number of elements, trading reallocations for little unused capacity
+	template <size_t Elements>
+	struct additive_growth
+	{
+		static_assert(Elements > 0, "growth increment must be positive");
+
+		static constexpr size_t grow(size_t capacity, size_t required, size_t max_size, size_t) noexcept
+		{
+			if (capacity > max_size - Elements)
+			{
+				return max_size;
+			}
+			return capacity + Elements < required ? required : capacity + Elements;
+		}
+	};
+
+	// Grows like Base, then rounds blocks of at least one page up to whole pages, so capacity
+	// the allocator would hand out as padding anyway becomes usable elements
+	template <size_t PageBytes = 4096, class Base = default_growth>
+	struct page_rounded_growth
+	{
+		static_assert(PageBytes > 0 && (PageBytes & (PageBytes - 1)) == 0, "page size must be a power of two");
+
+		static constexpr size_t grow(size_t capacity, size_t required, size_t max_size, size_t element_size) noexcept
+		{
+			const size_t grown = Base::grow(capacity, required, max_size, element_size);
+			if (grown > (std::numeric_limits<size_t>::max() - PageBytes) / element_size || grown * element_size < PageBytes)
+			{
+				return grown;
+			}
+			const size_t bytes = (grown * element_size + PageBytes - 1) & ~(PageBytes - 1);
+			const size_t rounded = bytes / element_size;
+			return rounded > max_size ? max_size : rounded;
+		}
+	};
+
+	// Rounds to 2 MiB, the x86-64 huge page, for vectors backed by mmap_allocator
+	template <class Base = default_growth>
+	using huge_page_rounded_growth = page_rounded_growth<size_t{ 2 } << 20, Base>;
+
+	// Grows like Base until the block reaches ThresholdBytes, then by ThresholdBytes at a
+	// time: few reallocations while small, bounded unused capacity once large
+	template <size_t ThresholdBytes, class Base = default_growth>
+	struct capped_geometric_growth
+	{
+		static_assert(ThresholdBytes > 0, "threshold must be positive");
+
+		static constexpr size_t grow(size_t capacity, size_t required, size_t max_size, size_t element_size) noexcept
+		{
+			const size_t step = ThresholdBytes / element_size > 0 ? ThresholdBytes / element_size : 1;
+			if (capacity < step)
+			{
+				const size_t grown = Base::grow(capacity, required, max_size, element_size);
+				// the geometric step that crosses the threshold stops at it
+				return grown > step && required <= step ? step : grown;
+			}
+			if (capacity > max_size - step)
+			{
+				return max_size;
+			}
+			return capacity + step < required ? required : capacity + step;
+		}
+	};
+
+	static_assert(default_growth::grow(10, 11, 100, 4) == 15);
+	static_assert(default_growth::grow(0, 1, 100, 4) == 1);
+	static_assert(default_growth::grow(90, 91, 100, 4) == 100);
+	static_assert(factor_growth<2>::grow(8, 9, 100, 4) == 16);
+	static_assert(additive_growth<16>::grow(100, 101, 1000, 4) == 116);
+	static_assert(page_rounded_growth<4096>::grow(1000, 1001, 100000, 4) == 2048);
+	static_assert(page_rounded_growth<4096>::grow(10, 11, 100000, 4) == 15);
+	static_assert(capped_geometric_growth<4096>::grow(800, 801, 100000, 4) == 1024);
+	static_assert(capped_geometric_growth<4096>::grow(1024, 1025, 100000, 4) == 2048);
+}
@@ -0,0 +1,461 @@
+#pragma once
+#include "my_vector.h"
+#include <algorithm>
+#include <cerrno>
+#include <cstdint>
+#include <cstring>
+#include <istream>
+#include <limits>
+#include <ostream>
+#include <streambuf>
+#include <string>
+#include <sys/stat.h>
+#include <sys/uio.h>
+#include <type_traits>
+#include <unistd.h>
+
+namespace my_vector
+{
+	// Binary format written by write_to: this header followed by count elements. Trivially
+	// copyable elements are stored as their raw bytes, others through codec<T>. Data is
+	// written in host byte order; a file from a host with the other order fails the magic check.
+	struct serialized_header
+	{
+		static constexpr uint64_t expected_magic = 0x524553434556594dULL;	// "MYVECSER" in little endian
+		static constexpr uint32_t current_version = 1;
+
+		enum encoding : uint32_t
+		{
+			raw = 0,
+			codec = 1
+		};
+
+		uint64_t magic;
+		uint32_t version;
+		uint32_t element_size;
+		uint32_t element_encoding;
+		uint32_t reserved;
+		uint64_t count;
+	};
+
+	// Per-element encoding for types that cannot be written as raw bytes. Specialize with
+	//
+	//	static void write(std::ostream& out, const T& value);
+	//	static T read(std::istream& in);
+	template <class T>
+	struct codec;
+
+	template <class CharT, class Traits, class StrAlloc>
+	struct codec<std::basic_string<CharT, Traits, StrAlloc>>
+	{
+		using string_type = std::basic_string<CharT, Traits, StrAlloc>;
+		static_assert(std::is_trivially_copyable_v<CharT>);
+
+		static void write(std::ostream& out, const string_type& value)
+		{
+			const uint64_t length = value.size();
+			out.write(reinterpret_cast<const char*>(&length), sizeof(length));
+			out.write(reinterpret_cast<const char*>(value.data()), static_cast<std::streamsize>(length * sizeof(CharT)));
+		}
+
+		static string_type read(std::istream& in)
+		{
+			uint64_t length = 0;
+			in.read(reinterpret_cast<char*>(&length), sizeof(length));
+			string_type value(in ? length : 0, CharT());
+			in.read(reinterpret_cast<char*>(value.data()), static_cast<std::streamsize>(value.size() * sizeof(CharT)));
+			return value;
+		}
+	};
+
+	namespace detail
+	{
+		inline void write_all(int fd, iovec* parts, int count)
+		{
+			while (count > 0)
+			{
+				ssize_t written = ::writev(fd, parts, count);
+				if (written < 0)
+				{
+					if (errno == EINTR)
+					{
+						continue;
+					}
+					throw my_vector_exception(std::string("write failed: ") + std::strerror(errno));
+				}
+				while (count > 0 && static_cast<size_t>(written) >= parts->iov_len)
+				{
+					written -= static_cast<ssize_t>(parts->iov_len);
+					++parts;
+					--count;
+				}
+				if (count > 0)
+				{
+					parts->iov_base = static_cast<char*>(parts->iov_base) + written;
+					parts->iov_len -= static_cast<size_t>(written);
+				}
+			}
+		}
+
+		// Reads up to bytes bytes, stopping early only at end of file. Returns the bytes read.
+		inline size_t read_full(int fd, void* dest, size_t bytes)
+		{
+			size_t done = 0;
+			while (done < bytes)
+			{
+				const ssize_t result = ::read(fd, static_cast<char*>(dest) + done, bytes - done);
+				if (result < 0)
+				{
+					if (errno == EINTR)
+					{
+						continue;
+					}
+					throw my_vector_exception(std::string("read failed: ") + std::strerror(errno));
+				}
+				if (result == 0)
+				{
+					break;
+				}
+				done += static_cast<size_t>(result);
+			}
+			return done;
+		}
+
+		inline void read_exact(int fd, void* dest, size_t bytes)
+		{
+			if (read_full(fd, dest, bytes) != bytes)
+			{
+				throw my_vector_exception("unexpected end of serialized vector");
+			}
+		}
+
+		// Buffered std::streambuf over a file descriptor, used to run codecs on fds
+		class fd_streambuf : public std::streambuf
+		{
+			int fd_;
+			char buffer_[1 << 16];
+
+		public:
+			explicit fd_streambuf(int fd) : fd_(fd)
+			{
+				setp(buffer_, buffer_ + sizeof(buffer_));
+			}
+
+			~fd_streambuf() override
+			{
+				sync();
+			}
+
+		protected:
+			int_type overflow(int_type ch) override
+			{
+				if (sync() != 0)
+				{
+					return traits_type::eof();
+				}
+				if (!traits_type::eq_int_type(ch, traits_type::eof()))
+				{
+					*pptr() = traits_type::to_char_type(ch);
+					pbump(1);
+				}
+				return traits_type::not_eof(ch);
+			}
+
+			int sync() override
+			{
+				if (pbase() == pptr())
+				{
+					return 0;
+				}
+				iovec part{ pbase(), static_cast<size_t>(pptr() - pbase()) };
+				try
+				{
+					write_all(fd_, &part, 1);
+				}
+				catch (const my_vector_exception&)
+				{
+					return -1;
+				}
+				setp(buffer_, buffer_ + sizeof(buffer_));
+				return 0;
+			}
+
+			int_type underflow() override
+			{
+				// reading and writing through the same buffer is not supported
+				setp(nullptr, nullptr);
+				const ssize_t result = ::read(fd_, buffer_, sizeof(buffer_));
+				if (result <= 0)
+				{
+					return traits_type::eof();
+				}
+				setg(buffer_, buffer_, buffer_ + result);
+				return traits_type::to_int_type(buffer_[0]);
+			}
+		};
+
+		template <class T>
+		serialized_header make_header(size_t count)
+		{
+			serialized_header header{};
+			header.magic = serialized_header::expected_magic;
+			header.version = serialized_header::current_version;
+			header.element_size = sizeof(T);
+			header.element_encoding = std::is_trivially_copyable_v<T> ? serialized_header::raw : serialized_header::codec;
+			header.count = count;
+			return header;
+		}
+
+		template <class T>
+		void validate_header(const serialized_header& header)
+		{
+			if (header.magic != serialized_header::expected_magic)
+			{
+				throw my_vector_exception("not a serialized vector");
+			}
+			if (header.version != serialized_header::current_version)
+			{
+				throw my_vector_exception("unsupported serialized vector version");
+			}
+			if (header.element_size != sizeof(T) || header.element_encoding != make_header<T>(0).element_encoding)
+			{
+				throw my_vector_exception("serialized vector holds a different element type");
+			}
+		}
+
+		template <class T, class Alloc_T, class Stats_T, class Growth_T>
+		void write_elements(std::ostream& out, const vector<T, Alloc_T, Stats_T, Growth_T>& vec)
+		{
+			if constexpr (std::is_trivially_copyable_v<T>)
+			{
+				out.write(reinterpret_cast<const char*>(vec.data()), static_cast<std::streamsize>(vec.size() * sizeof(T)));
+			}
+			else
+			{
+				for (const T& element : vec)
+				{
+					codec<T>::write(out, element);
+				}
+			}
+		}
+
+		// Storage reserved ahead of the data actually read. The count in a header is untrusted:
+		// a corrupt one must not cost more than this plus what the input really holds.
+		inline constexpr size_t initial_read_bytes = size_t{ 1 } << 16;
+
+		template <class T, class Alloc_T, class Stats_T, class Growth_T>
+		void check_count(const vector<T, Alloc_T, Stats_T, Growth_T>& vec, uint64_t count)
+		{
+			if (count > vec.max_size() || count > std::numeric_limits<size_t>::max() / sizeof(T))
+			{
+				throw my_vector_exception("serialized vector is too large");
+			}
+		}
+
+		// Appends count raw elements using read_bytes(dest, bytes), which throws on a short
+		// read. Each step at most doubles the size, so storage stays within twice what has arrived.
+		template <class T, class Alloc_T, class Stats_T, class Growth_T, class ReadBytes>
+		void read_raw_in_steps(vector<T, Alloc_T, Stats_T, Growth_T>& vec, size_t count, ReadBytes read_bytes)
+		{
+			const size_t initial = std::max<size_t>(initial_read_bytes / sizeof(T), 1);
+			try
+			{
+				while (vec.size() < count)
+				{
+					const size_t step = std::min(count - vec.size(), std::max(initial, vec.size()));
+					vec.reserve(vec.size() + step);
+					// straight into the uninitialized capacity, no per-element construction
+					read_bytes(vec.data() + vec.size(), step * sizeof(T));
+					vector_access::set_size(vec, vec.size() + step);
+				}
+			}
+			catch (...)
+			{
+				vec.clear();
+				throw;
+			}
+		}
+
+		// Bytes left after the current offset when fd is a regular file, or -1 when unknown
+		inline off_t remaining_file_bytes(int fd)
+		{
+			struct stat info {};
+			if (::fstat(fd, &info) != 0 || !S_ISREG(info.st_mode))
+			{
+				return -1;
+			}
+			const off_t offset = ::lseek(fd, 0, SEEK_CUR);
+			return offset < 0 || offset > info.st_size ? -1 : info.st_size - offset;
+		}
+
+		template <class T, class Alloc_T, class Stats_T, class Growth_T>
+		void read_elements(std::istream& in, vector<T, Alloc_T, Stats_T, Growth_T>& vec, size_t count)
+		{
+			check_count(vec, count);
+			if constexpr (std::is_trivially_copyable_v<T>)
+			{
+				read_raw_in_steps(vec, count, [&](T* dest, size_t bytes)
+				{
+					in.read(reinterpret_cast<char*>(dest), static_cast<std::streamsize>(bytes));
+					if (in.gcount() != static_cast<std::streamsize>(bytes))
+					{
+						throw my_vector_exception("unexpected end of serialized vector");
+					}
+				});
+			}
+			else
+			{
+				vec.reserve(std::min<size_t>(count, std::max<size_t>(initial_read_bytes / sizeof(T), 1)));
+				for (size_t i = 0; i < count; ++i)
+				{
+					T element = codec<T>::read(in);
+					if (!in)
+					{
+						throw my_vector_exception("unexpected end of serialized vector");
+					}
+					vec.push_back(std::move(element));
+				}
+			}
+		}
+	}
+
+	// Writes vec to out in the serialized vector format
+	template <class T, class Alloc_T, class Stats_T, class Growth_T>
+	void write_to(std::ostream& out, const vector<T, Alloc_T, Stats_T, Growth_T>& vec)
+	{
+		const serialized_header header = detail::make_header<T>(vec.size());
+		out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+		detail::write_elements(out, vec);
+		if (!out)
+		{
+			throw my_vector_exception("write failed");
+		}
+	}
+
+	// Replaces the contents of vec with a vector read from in
+	template <class T, class Alloc_T, class Stats_T, class Growth_T>
+	void read_from(std::istream& in, vector<T, Alloc_T, Stats_T, Growth_T>& vec)
+	{
+		serialized_header header{};
+		in.read(reinterpret_cast<char*>(&header), sizeof(header));
+		if (in.gcount() != sizeof(header))
+		{
+			throw my_vector_exception("unexpected end of serialized vector");
+		}
+		detail::validate_header<T>(header);
+		vec.clear();
+		detail::read_elements(in, vec, header.count);
+	}
+
+	// Writes vec to fd. Trivially copyable elements go out with one writev straight from data().
+	template <class T, class Alloc_T, class Stats_T, class Growth_T>
+	void write_to(int fd, const vector<T, Alloc_T, Stats_T, Growth_T>& vec)
+	{
+		serialized_header header = detail::make_header<T>(vec.size());
+		if constexpr (std::is_trivially_copyable_v<T>)
+		{
+			iovec parts[2] = {
+				{ &header, sizeof(header) },
+				{ const_cast<T*>(vec.data()), vec.size() * sizeof(T) }
+			};
+			detail::write_all(fd, parts, vec.empty() ? 1 : 2);
+		}
+		else
+		{
+			detail::fd_streambuf buffer(fd);
+			std::ostream out(&buffer);
+			write_to(out, vec);
+			out.flush();
+			if (!out)
+			{
+				throw my_vector_exception("write failed");
+			}
+		}
+	}
+
+	// Replaces the contents of vec with a vector read from fd. Trivially copyable elements are
+	// read directly into the reserved storage with no per-element construction. A regular file
+	// too short for the header's count is rejected before allocating; from pipes and sockets
+	// the storage grows in steps as the data arrives.
+	template <class T, class Alloc_T, class Stats_T, class Growth_T>
+	void read_from(int fd, vector<T, Alloc_T, Stats_T, Growth_T>& vec)
+	{
+		if constexpr (std::is_trivially_copyable_v<T>)
+		{
+			serialized_header header{};
+			detail::read_exact(fd, &header, sizeof(header));
+			detail::validate_header<T>(header);
+			detail::check_count(vec, header.count);
+			const size_t count = header.count;
+			const off_t available = detail::remaining_file_bytes(fd);
+			if (available >= 0 && count * sizeof(T) > static_cast<size_t>(available))
+			{
+				throw my_vector_exception("unexpected end of serialized vector");
+			}
+			vec.clear();
+			if (available >= 0)
+			{
+				vec.reserve(count);
+				detail::read_exact(fd, vec.data(), count * sizeof(T));
+				detail::vector_access::set_size(vec, count);
+			}
+			else
+			{
+				detail::read_raw_in_steps(vec, count, [fd](T* dest, size_t bytes) { detail::read_exact(fd, dest, bytes); });
+			}
+		}
+		else
+		{
+			// the stream buffer may read past the vector; fine for a file holding one vector
+			detail::fd_streambuf buffer(fd);
+			std::istream in(&buffer);
+			read_from(in, vec);
+		}
+	}
+
+	// Reads a serialized vector of trivially copyable T from fd in fixed-size batches, so
+	// the whole vector never has to be resident at once.
+	template <class T>
+	class chunked_reader
+	{
+		static_assert(std::is_trivially_copyable_v<T>, "chunked reading needs raw-encoded elements");
+
+		int fd_;
+		size_t batch_size_;
+		size_t remaining_;
+
+	public:
+		// Reads and validates the header; fd must be positioned at the start of a serialized vector
+		chunked_reader(int fd, size_t batch_size) : fd_(fd), batch_size_(batch_size)
+		{
+			if (batch_size_ == 0)
+			{
+				throw my_vector_exception("batch size must be positive");
+			}
+			serialized_header header{};
+			detail::read_exact(fd_, &header, sizeof(header));
+			detail::validate_header<T>(header);
+			remaining_ = header.count;
+		}
+
+		// Replaces the contents of batch with the next elements, reusing its storage.
+		// Returns the number of elements read, 0 once the vector is exhausted.
+		template <class Alloc_T, class Stats_T, class Growth_T>
+		size_t next(vector<T, Alloc_T, Stats_T, Growth_T>& batch)
+		{
+			const size_t count = remaining_ < batch_size_ ? remaining_ : batch_size_;
+			batch.clear();
+			batch.reserve(count);
+			detail::read_exact(fd_, batch.data(), count * sizeof(T));
+			detail::vector_access::set_size(batch, count);
+			remaining_ -= count;
+			return count;
+		}
+
+		// Elements not yet handed out
+		[[nodiscard]] size_t remaining() const noexcept
+		{
+			return remaining_;
+		}
+	};
+}
@@ -0,0 +1,88 @@
+#pragma once
+#include "my_vector_allocation.h"
+#include <cstddef>
+#include <cstdlib>
+#include <cstring>
+#include <new>
+
+#if defined(__GLIBC__)
+#include <malloc.h>
+#endif
+
+namespace my_vector
+{
+	// Allocator on top of malloc/realloc. Reports the usable size of each block through
+	// allocate_at_least and lets the vector grow trivially relocatable elements with realloc,
+	// which can extend a block in place (or by remapping pages for large blocks on glibc)
+	// instead of copying it.
+	template <class T>
+	class malloc_allocator
+	{
+		static_assert(alignof(T) <= alignof(std::max_align_t), "malloc does not honour over-aligned types");
+
+	public:
+		using value_type = T;
+
+		malloc_allocator() noexcept = default;
+
+		template <class U>
+		malloc_allocator(const malloc_allocator<U>&) noexcept
+		{}
+
+		T* allocate(size_t n)
+		{
+			if (n > max_size())
+			{
+				throw std::bad_array_new_length();
+			}
+			void* ptr = std::malloc(n * sizeof(T));
+			if (ptr == nullptr && n != 0)
+			{
+				throw std::bad_alloc();
+			}
+			return static_cast<T*>(ptr);
+		}
+
+		allocation_result<T*> allocate_at_least(size_t n)
+		{
+			T* ptr = allocate(n);
+#if defined(__GLIBC__)
+			if (ptr != nullptr)
+			{
+				return { ptr, malloc_usable_size(ptr) / sizeof(T) };
+			}
+#endif
+			return { ptr, n };
+		}
+
+		T* reallocate(T* ptr, size_t, size_t new_n)
+		{
+			if (new_n > max_size())
+			{
+				throw std::bad_array_new_length();
+			}
+			void* result = std::realloc(ptr, new_n == 0 ? 1 : new_n * sizeof(T));
+			if (result == nullptr)
+			{
+				throw std::bad_alloc();
+			}
+			return static_cast<T*>(result);
+		}
+
+		void deallocate(T* ptr, size_t) noexcept
+		{
+			std::free(ptr);
+		}
+
+		[[nodiscard]] size_t max_size() const noexcept
+		{
+			return static_cast<size_t>(-1) / sizeof(T);
+		}
+
+		template <class U>
+		bool operator==(const malloc_allocator<U>&) const noexcept
+		{
+			return true;
+		}
+	};
+}
@@ -0,0 +1,201 @@
+#pragma once
+#include "my_vector_allocation.h"
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <new>
+#include <sys/mman.h>
+#include <unistd.h>
+
+namespace my_vector
+{
+	enum class huge_pages
+	{
+		none,	// plain 4 KiB pages
+		transparent,	// 2 MiB aligned mapping with madvise(MADV_HUGEPAGE)
+		explicit_hugetlb	// MAP_HUGETLB from the reserved pool, falling back to transparent
+	};
+
+	struct mmap_options
+	{
+		huge_pages pages = huge_pages::transparent;
+		// MAP_POPULATE: prefault the whole mapping when it is created
+		bool populate = false;
+		// Requests smaller than this many bytes go to std::allocator
+		size_t threshold = size_t{ 1 } << 20;
+	};
+
+	// Allocator backing large blocks with anonymous mmap so they can use huge pages,
+	// which cuts TLB misses when scanning tens of GB. Blocks are rounded up to whole pages
+	// and the slack is reported through allocate_at_least; fresh mappings are already zero
+	// (allocate_zeroed) and grow with mremap (reallocate) instead of being copied.
+	template <class T, mmap_options Options = mmap_options{}>
+	class mmap_allocator
+	{
+	public:
+		using value_type = T;
+
+		template <class U>
+		struct rebind
+		{
+			using other = mmap_allocator<U, Options>;
+		};
+
+		static constexpr size_t huge_page_size = size_t{ 2 } << 20;
+
+		mmap_allocator() noexcept = default;
+
+		template <class U>
+		mmap_allocator(const mmap_allocator<U, Options>&) noexcept
+		{}
+
+		T* allocate(size_t n)
+		{
+			return allocate_at_least(n).ptr;
+		}
+
+		allocation_result<T*> allocate_at_least(size_t n)
+		{
+			if (!is_mapped(n))
+			{
+				return { std::allocator<T>().allocate(n), n };
+			}
+			const size_t length = mapping_length(n * sizeof(T));
+			return { static_cast<T*>(map(length)), length / sizeof(T) };
+		}
+
+		T* allocate_zeroed(size_t n)
+		{
+			if (!is_mapped(n))
+			{
+				T* result = std::allocator<T>().allocate(n);
+				std::memset(static_cast<void*>(result), 0, n * sizeof(T));
+				return result;
+			}
+			return static_cast<T*>(map(mapping_length(n * sizeof(T))));
+		}
+
+		T* reallocate(T* ptr, size_t n, size_t new_n)
+		{
+			if (is_mapped(n) && is_mapped(new_n))
+			{
+				const size_t new_length = mapping_length(new_n * sizeof(T));
+				void* result = mremap(ptr, mapping_length(n * sizeof(T)), new_length, MREMAP_MAYMOVE);
+				if (result == MAP_FAILED)
+				{
+					throw std::bad_alloc();
+				}
+				advise(result, new_length);
+				return static_cast<T*>(result);
+			}
+
+			T* result = allocate(new_n);
+			std::memcpy(static_cast<void*>(result), static_cast<const void*>(ptr), (n < new_n ? n : new_n) * sizeof(T));
+			deallocate(ptr, n);
+			return result;
+		}
+
+		void deallocate(T* ptr, size_t n) noexcept
+		{
+			if (!is_mapped(n))
+			{
+				std::allocator<T>().deallocate(ptr, n);
+				return;
+			}
+			munmap(ptr, mapping_length(n * sizeof(T)));
+		}
+
+		[[nodiscard]] size_t max_size() const noexcept
+		{
+			return static_cast<size_t>(-1) / sizeof(T);
+		}
+
+		template <class U>
+		bool operator==(const mmap_allocator<U, Options>&) const noexcept
+		{
+			return true;
+		}
+
+	private:
+		static bool is_mapped(size_t n) noexcept
+		{
+			return n >= (Options.threshold + sizeof(T) - 1) / sizeof(T);
+		}
+
+		static size_t mapping_length(size_t bytes) noexcept
+		{
+			const size_t granularity = Options.pages == huge_pages::none
+				? static_cast<size_t>(sysconf(_SC_PAGESIZE))
+				: huge_page_size;
+			return (bytes + granularity - 1) / granularity * granularity;
+		}
+
+		static void* map(size_t length)
+		{
+			int flags = MAP_PRIVATE | MAP_ANONYMOUS;
+			if constexpr (Options.populate)
+			{
+				flags |= MAP_POPULATE;
+			}
+
+			if constexpr (Options.pages == huge_pages::explicit_hugetlb)
+			{
+				void* result = mmap(nullptr, length, PROT_READ | PROT_WRITE, flags | MAP_HUGETLB, -1, 0);
+				if (result != MAP_FAILED)
+				{
+					return result;
+				}
+				// no reserved huge pages: fall through to transparent huge pages
+			}
+
+			if constexpr (Options.pages == huge_pages::none)
+			{
+				void* result = mmap(nullptr, length, PROT_READ | PROT_WRITE, flags, -1, 0);
+				if (result == MAP_FAILED)
+				{
+					throw std::bad_alloc();
+				}
+				return result;
+			}
+			else
+			{
+				// over-map by one huge page and trim, so the block starts on a 2 MiB boundary
+				// and the kernel can back all of it with huge pages
+				const size_t padded = length + huge_page_size;
+				void* raw = mmap(nullptr, padded, PROT_READ | PROT_WRITE, flags & ~MAP_POPULATE, -1, 0);
+				if (raw == MAP_FAILED)
+				{
+					throw std::bad_alloc();
+				}
+				auto* start = static_cast<unsigned char*>(raw);
+				const auto address = reinterpret_cast<std::uintptr_t>(start);
+				const size_t head = (huge_page_size - address % huge_page_size) % huge_page_size;
+				if (head != 0)
+				{
+					munmap(start, head);
+				}
+				munmap(start + head + length, padded - head - length);
+
+				advise(start + head, length);
+				if constexpr (Options.populate)
+				{
+					madvise(start + head, length, MADV_WILLNEED);
+					for (size_t offset = 0; offset < length; offset += huge_page_size)
+					{
+						*static_cast<volatile unsigned char*>(start + head + offset) = 0;
+					}
+				}
+				return start + head;
+			}
+		}
+
+		static void advise(void* ptr, size_t length) noexcept
+		{
+			if constexpr (Options.pages != huge_pages::none)
+			{
+				madvise(ptr, length, MADV_HUGEPAGE);
+			}
+		}
+	};
+}
@@ -0,0 +1,515 @@
+#pragma once
+#include "my_vector.h"
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <optional>
+#include <thread>
+
+namespace my_vector::par
+{
+	inline constexpr size_t cache_line_size = 64;
+
+	// Fixed set of worker threads, each with its own task deque. A worker pops its newest
+	// task and, when its deque is empty, steals the oldest task of another worker, so
+	// load evens out without a shared queue. Threads waiting on a parallel algorithm run
+	// queued tasks themselves, which also makes nested parallel calls safe.
+	class thread_pool
+	{
+	public:
+		using task = std::function<void()>;
+
+		explicit thread_pool(unsigned threads = std::thread::hardware_concurrency());
+
+		thread_pool(const thread_pool& other) = delete;
+
+		thread_pool& operator=(const thread_pool& other) = delete;
+
+		// Finishes the queued tasks, then joins the workers
+		~thread_pool();
+
+		// Number of worker threads; callers of the algorithms take part as well
+		[[nodiscard]] unsigned size()const noexcept;
+
+		void submit(task work);
+
+		// Runs one queued task on the calling thread. Returns false if none was found.
+		bool run_pending();
+
+	private:
+		struct alignas(cache_line_size) worker_queue
+		{
+			std::mutex lock;
+			std::deque<task> tasks;
+		};
+
+		unsigned count_;
+		std::unique_ptr<worker_queue[]> queues_;
+		vector<std::thread> threads_;
+		std::atomic<size_t> queued_;
+		std::atomic<unsigned> next_queue_;
+		std::atomic<bool> stopping_;
+		std::mutex sleep_lock_;
+		std::condition_variable wake_;
+
+		// The pool and queue of the worker running on this thread, if any
+		inline static thread_local thread_pool* current_pool_ = nullptr;
+		inline static thread_local unsigned current_index_ = 0;
+
+		bool pop(unsigned index, task& work);
+		bool steal(unsigned thief, task& work);
+		void worker_loop(unsigned index);
+	};
+
+	inline thread_pool::thread_pool(unsigned threads)
+		: count_(threads == 0 ? 1 : threads), queues_(new worker_queue[count_]), queued_(0), next_queue_(0), stopping_(false)
+	{
+		threads_.reserve(count_);
+		for (unsigned index = 0; index < count_; ++index)
+		{
+			threads_.emplace_back([this, index] { worker_loop(index); });
+		}
+	}
+
+	inline thread_pool::~thread_pool()
+	{
+		{
+			std::lock_guard lock(sleep_lock_);
+			stopping_.store(true);
+		}
+		wake_.notify_all();
+		for (std::thread& thread : threads_)
+		{
+			thread.join();
+		}
+	}
+
+	inline unsigned thread_pool::size() const noexcept
+	{
+		return count_;
+	}
+
+	inline void thread_pool::submit(task work)
+	{
+		// workers push to their own deque; other threads spread tasks round robin
+		const unsigned index = current_pool_ == this
+			? current_index_
+			: next_queue_.fetch_add(1, std::memory_order_relaxed) % count_;
+		{
+			std::lock_guard lock(queues_[index].lock);
+			queues_[index].tasks.push_back(std::move(work));
+		}
+		queued_.fetch_add(1);
+		{
+			std::lock_guard lock(sleep_lock_);
+		}
+		wake_.notify_one();
+	}
+
+	inline bool thread_pool::run_pending()
+	{
+		task work;
+		const bool found = current_pool_ == this
+			? pop(current_index_, work) || steal(current_index_, work)
+			: steal(next_queue_.load(std::memory_order_relaxed) % count_, work);
+		if (found)
+		{
+			work();
+		}
+		return found;
+	}
+
+	inline bool thread_pool::pop(unsigned index, task& work)
+	{
+		std::lock_guard lock(queues_[index].lock);
+		if (queues_[index].tasks.empty())
+		{
+			return false;
+		}
+		work = std::move(queues_[index].tasks.back());
+		queues_[index].tasks.pop_back();
+		queued_.fetch_sub(1);
+		return true;
+	}
+
+	inline bool thread_pool::steal(unsigned thief, task& work)
+	{
+		for (unsigned i = 0; i < count_; ++i)
+		{
+			worker_queue& victim = queues_[(thief + i) % count_];
+			std::lock_guard lock(victim.lock);
+			if (!victim.tasks.empty())
+			{
+				work = std::move(victim.tasks.front());
+				victim.tasks.pop_front();
+				queued_.fetch_sub(1);
+				return true;
+			}
+		}
+		return false;
+	}
+
+	inline void thread_pool::worker_loop(unsigned index)
+	{
+		current_pool_ = this;
+		current_index_ = index;
+		task work;
+		while (true)
+		{
+			if (pop(index, work) || steal(index, work))
+			{
+				work();
+				work = nullptr;
+				continue;
+			}
+			std::unique_lock lock(sleep_lock_);
+			wake_.wait(lock, [this] { return queued_.load() != 0 || stopping_.load(); });
+			if (stopping_.load() && queued_.load() == 0)
+			{
+				return;
+			}
+		}
+	}
+
+	// Pool used by the algorithms when none is given, one worker per hardware thread
+	inline thread_pool& default_pool()
+	{
+		static thread_pool pool;
+		return pool;
+	}
+
+	namespace detail
+	{
+		// Runs body(i) for every i in [0, tasks) on the pool and the calling thread, returning
+		// once all have finished. The first exception thrown is rethrown afterwards.
+		template <class F>
+		void run_tasks(thread_pool& pool, size_t tasks, F&& body)
+		{
+			if (tasks == 0)
+			{
+				return;
+			}
+			if (tasks == 1)
+			{
+				body(size_t{ 0 });
+				return;
+			}
+
+			std::atomic<size_t> remaining(tasks - 1);
+			std::exception_ptr error;
+			std::mutex error_lock;
+			const auto run = [&](size_t index)
+			{
+				try
+				{
+					body(index);
+				}
+				catch (...)
+				{
+					std::lock_guard lock(error_lock);
+					if (!error)
+					{
+						error = std::current_exception();
+					}
+				}
+			};
+
+			for (size_t index = 1; index < tasks; ++index)
+			{
+				pool.submit([&run, &remaining, index]
+				{
+					run(index);
+					remaining.fetch_sub(1, std::memory_order_release);
+				});
+			}
+			run(0);
+			while (remaining.load(std::memory_order_acquire) != 0)
+			{
+				if (!pool.run_pending())
+				{
+					std::this_thread::yield();
+				}
+			}
+			if (error)
+			{
+				std::rethrow_exception(error);
+			}
+		}
+
+		// Split of count elements at data into chunks whose inner boundaries fall on cache
+		// line boundaries (for element sizes dividing the line), so no two threads write to
+		// the same line. Chunks hold at least min_chunk_bytes, and there are a few per thread
+		// for the stealing to balance.
+		template <class T>
+		class chunk_plan
+		{
+			static constexpr size_t min_chunk_bytes = 16 * 1024;
+			static constexpr size_t per_line = sizeof(T) < cache_line_size ? cache_line_size / sizeof(T) : 1;
+
+			size_t count_;
+			size_t head_;
+			size_t chunk_;
+
+		public:
+			chunk_plan(const thread_pool& pool, const T* data, size_t count) : count_(count), head_(0)
+			{
+				const size_t target_chunks = (pool.size() + size_t{ 1 }) * 4;
+				size_t chunk = (count + target_chunks - 1) / target_chunks;
+				const size_t min_chunk = (min_chunk_bytes + sizeof(T) - 1) / sizeof(T);
+				chunk = chunk < min_chunk ? min_chunk : chunk;
+				chunk_ = (chunk + per_line - 1) / per_line * per_line;
+
+				const auto address = reinterpret_cast<std::uintptr_t>(data);
+				if (cache_line_size % sizeof(T) == 0 && address % sizeof(T) == 0)
+				{
+					head_ = (cache_line_size - address % cache_line_size) % cache_line_size / sizeof(T);
+				}
+			}
+
+			[[nodiscard]] size_t chunks() const noexcept
+			{
+				if (count_ <= head_ + chunk_)
+				{
+					return count_ == 0 ? 0 : 1;
+				}
+				return 1 + (count_ - head_ - 1) / chunk_;
+			}
+
+			[[nodiscard]] size_t begin(size_t index) const noexcept
+			{
+				return index == 0 ? 0 : head_ + index * chunk_;
+			}
+
+			[[nodiscard]] size_t end(size_t index) const noexcept
+			{
+				const size_t bound = head_ + (index + 1) * chunk_;
+				return bound < count_ ? bound : count_;
+			}
+		};
+
+		// Runs body(first, last) over cache-line aligned chunks of [data, data + count)
+		template <class T, class F>
+		void for_chunks(thread_pool& pool, const T* data, size_t count, F&& body)
+		{
+			const chunk_plan<T> plan(pool, data, count);
+			run_tasks(pool, plan.chunks(), [&](size_t index)
+			{
+				body(plan.begin(index), plan.end(index));
+			});
+		}
+
+		// Constructs [size(), new_size) of vec in parallel with construct(first, count), each
+		// chunk on the thread that first touches its pages
+		template <class T, class Alloc_T, class Stats_T, class Growth_T, class F>
+		void construct_tail(thread_pool& pool, vector<T, Alloc_T, Stats_T, Growth_T>& vec, size_t new_size, F&& construct)
+		{
+			const size_t old_size = vec.size();
+			T* const tail = vec.data() + old_size;
+			const size_t count = new_size - old_size;
+			const chunk_plan<T> plan(pool, tail, count);
+
+			// chunks whose elements were all constructed, to unwind if another one throws
+			vector<unsigned char> built(plan.chunks(), 0);
+			try
+			{
+				run_tasks(pool, plan.chunks(), [&](size_t index)
+				{
+					construct(tail + plan.begin(index), plan.end(index) - plan.begin(index));
+					built[index] = 1;
+				});
+			}
+			catch (...)
+			{
+				for (size_t index = 0; index < plan.chunks(); ++index)
+				{
+					if (built[index] != 0)
+					{
+						std::destroy(tail + plan.begin(index), tail + plan.end(index));
+					}
+				}
+				throw;
+			}
+			my_vector::detail::vector_access::set_size(vec, new_size);
+		}
+	}
+
+	// Assigns value to every element of range
+	template <std::ranges::contiguous_range R, class T>
+	void fill(thread_pool& pool, R&& range, const T& value)
+	{
+		auto* data = std::ranges::data(range);
+		detail::for_chunks(pool, data, std::ranges::size(range), [&](size_t first, size_t last)
+		{
+			std::fill(data + first, data + last, value);
+		});
+	}
+
+	template <std::ranges::contiguous_range R, class T>
+	void fill(R&& range, const T& value)
+	{
+		fill(default_pool(), std::forward<R>(range), value);
+	}
+
+	// Calls f on every element of range, in no particular order
+	template <std::ranges::contiguous_range R, class F>
+	void for_each(thread_pool& pool, R&& range, F f)
+	{
+		auto* data = std::ranges::data(range);
+		detail::for_chunks(pool, data, std::ranges::size(range), [&](size_t first, size_t last)
+		{
+			std::for_each(data + first, data + last, f);
+		});
+	}
+
+	template <std::ranges::contiguous_range R, class F>
+	void for_each(R&& range, F f)
+	{
+		for_each(default_pool(), std::forward<R>(range), std::move(f));
+	}
+
+	// Folds range with op, which must be associative; chunk results are combined in order
+	template <std::ranges::contiguous_range R, class T, class Op = std::plus<>>
+	T reduce(thread_pool& pool, R&& range, T init, Op op = Op())
+	{
+		const auto* data = std::ranges::data(range);
+		const detail::chunk_plan<std::remove_cv_t<std::remove_pointer_t<decltype(data)>>> plan(pool, data, std::ranges::size(range));
+		vector<std::optional<T>> partial(plan.chunks());
+		detail::run_tasks(pool, plan.chunks(), [&](size_t index)
+		{
+			T sum = data[plan.begin(index)];
+			for (size_t i = plan.begin(index) + 1; i < plan.end(index); ++i)
+			{
+				sum = op(std::move(sum), data[i]);
+			}
+			partial[index].emplace(std::move(sum));
+		});
+		for (std::optional<T>& sum : partial)
+		{
+			init = op(std::move(init), std::move(*sum));
+		}
+		return init;
+	}
+
+	template <std::ranges::contiguous_range R, class T, class Op = std::plus<>>
+	T reduce(R&& range, T init, Op op = Op())
+	{
+		return reduce(default_pool(), std::forward<R>(range), std::move(init), std::move(op));
+	}
+
+	// Sorts range: chunks are sorted in parallel, then merged pairwise in parallel rounds
+	template <std::ranges::contiguous_range R, class Comp = std::less<>>
+	void sort(thread_pool& pool, R&& range, Comp comp = Comp())
+	{
+		auto* data = std::ranges::data(range);
+		const detail::chunk_plan<std::remove_pointer_t<decltype(data)>> plan(pool, data, std::ranges::size(range));
+		const size_t chunks = plan.chunks();
+		detail::run_tasks(pool, chunks, [&](size_t index)
+		{
+			std::sort(data + plan.begin(index), data + plan.end(index), comp);
+		});
+
+		for (size_t width = 1; width < chunks; width *= 2)
+		{
+			const size_t pairs = (chunks + 2 * width - 1) / (2 * width);
+			detail::run_tasks(pool, pairs, [&](size_t pair)
+			{
+				const size_t left = pair * 2 * width;
+				const size_t right = left + width;
+				if (right >= chunks)
+				{
+					return;
+				}
+				const size_t last = right + width < chunks ? right + width : chunks;
+				std::inplace_merge(data + plan.begin(left), data + plan.begin(right), data + plan.end(last - 1), comp);
+			});
+		}
+	}
+
+	template <std::ranges::contiguous_range R, class Comp = std::less<>>
+	void sort(R&& range, Comp comp = Comp())
+	{
+		sort(default_pool(), std::forward<R>(range), std::move(comp));
+	}
+
+	// Replaces the contents of out with op(element) for every element of in, constructing
+	// the results in place
+	template <std::ranges::contiguous_range R, class U, class Alloc_T, class Stats_T, class Growth_T, class F>
+	void transform(thread_pool& pool, const R& in, vector<U, Alloc_T, Stats_T, Growth_T>& out, F op)
+	{
+		const auto* source = std::ranges::data(in);
+		const size_t count = std::ranges::size(in);
+		out.clear();
+		out.reserve(count);
+		detail::construct_tail(pool, out, count, [&](U* dest, size_t n)
+		{
+			const auto* from = source + (dest - out.data());
+			size_t built = 0;
+			try
+			{
+				for (; built < n; ++built)
+				{
+					std::construct_at(dest + built, op(from[built]));
+				}
+			}
+			catch (...)
+			{
+				std::destroy_n(dest, built);
+				throw;
+			}
+		});
+	}
+
+	template <std::ranges::contiguous_range R, class U, class Alloc_T, class Stats_T, class Growth_T, class F>
+	void transform(const R& in, vector<U, Alloc_T, Stats_T, Growth_T>& out, F op)
+	{
+		transform(default_pool(), in, out, std::move(op));
+	}
+
+	// resize that value-initializes the new elements in parallel
+	template <class T, class Alloc_T, class Stats_T, class Growth_T>
+	void resize(thread_pool& pool, vector<T, Alloc_T, Stats_T, Growth_T>& vec, size_t new_size)
+	{
+		if (new_size <= vec.size())
+		{
+			vec.resize(new_size);
+			return;
+		}
+		vec.reserve(new_size);
+		detail::construct_tail(pool, vec, new_size, [](T* dest, size_t count)
+		{
+			construct_default_n(dest, count);
+		});
+	}
+
+	template <class T, class Alloc_T, class Stats_T, class Growth_T>
+	void resize(vector<T, Alloc_T, Stats_T, Growth_T>& vec, size_t new_size)
+	{
+		resize(default_pool(), vec, new_size);
+	}
+
+	// resize that copies value into the new elements in parallel
+	template <class T, class Alloc_T, class Stats_T, class Growth_T>
+	void resize(thread_pool& pool, vector<T, Alloc_T, Stats_T, Growth_T>& vec, size_t new_size, const T& value)
+	{
+		if (new_size <= vec.size())
+		{
+			vec.resize(new_size);
+			return;
+		}
+		vec.reserve(new_size);
+		detail::construct_tail(pool, vec, new_size, [&value](T* dest, size_t count)
+		{
+			construct_fill_n(dest, count, value);
+		});
+	}
+
+	template <class T, class Alloc_T, class Stats_T, class Growth_T>
+	void resize(vector<T, Alloc_T, Stats_T, Growth_T>& vec, size_t new_size, const T& value)
+	{
+		resize(default_pool(), vec, new_size, value);
+	}
+}
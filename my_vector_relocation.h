@@ -0,0 +1,68 @@
+#pragma once
+#include <cstring>
+#include <memory>
+#include <type_traits>
+
+namespace my_vector
+{
+	// A type is trivially relocatable when moving an object to a new address and ending the
+	// lifetime of the old one is equivalent to copying its bytes. Trivially copyable types
+	// qualify automatically; other types (e.g. ones that only own a pointer) can opt in:
+	//
+	//	template <>
+	//	struct my_vector::is_trivially_relocatable<my_type> : std::true_type {};
+	template <class T>
+	struct is_trivially_relocatable : std::is_trivially_copyable<T>
+	{};
+
+	template <class T>
+	inline constexpr bool is_trivially_relocatable_v = is_trivially_relocatable<T>::value;
+
+	// Moves count objects from src into the uninitialized storage at dest.
+	// Afterwards src holds no live objects and must not be destroyed again.
+	template <class T>
+	constexpr void relocate_n(T* src, size_t count, T* dest)
+	{
+		// constant evaluation cannot copy object bytes, so it always moves element by element
+		if constexpr (is_trivially_relocatable_v<T>)
+		{
+			if (!std::is_constant_evaluated())
+			{
+				if (count != 0)
+				{
+					std::memcpy(static_cast<void*>(dest), static_cast<const void*>(src), count * sizeof(T));
+				}
+				return;
+			}
+		}
+		for (size_t i = 0; i < count; ++i)
+		{
+			std::construct_at(&dest[i], std::move(src[i]));
+		}
+		std::destroy_n(src, count);
+	}
+
+	// Moves count trivially relocatable objects from src to dest, where the two ranges may overlap.
+	// Afterwards only [dest, dest + count) holds live objects.
+	template <class T>
+	constexpr void relocate_overlapping_n(T* src, size_t count, T* dest)
+	{
+		static_assert(is_trivially_relocatable_v<T>, "overlapping relocation needs a trivially relocatable type");
+		if (std::is_constant_evaluated())
+		{
+			// each element moves before the one that overwrites its slot
+			const bool forward = dest < src;
+			for (size_t n = 0; n < count; ++n)
+			{
+				const size_t i = forward ? n : count - 1 - n;
+				std::construct_at(&dest[i], std::move(src[i]));
+				std::destroy_at(&src[i]);
+			}
+			return;
+		}
+		if (count != 0)
+		{
+			std::memmove(static_cast<void*>(dest), static_cast<const void*>(src), count * sizeof(T));
+		}
+	}
+}
@@ -0,0 +1,175 @@
+#pragma once
+#include <bit>
+#include <compare>
+#include <cstddef>
+#include <iterator>
+#include <limits>
+#include <type_traits>
+
+namespace my_vector::detail
+{
+	// Index arithmetic for containers stored as geometrically growing segments that never
+	// move. Segment 0 holds 2^BaseBits elements and every later segment doubles the one
+	// before, so after biasing the index by the first segment's size its highest set bit
+	// names the segment and the bits below it are the offset: O(1), no loops or tables.
+	template <size_t BaseBits>
+	struct segment_layout
+	{
+		static constexpr size_t base_size = size_t{ 1 } << BaseBits;
+		static constexpr size_t max_segments = std::numeric_limits<size_t>::digits - BaseBits;
+
+		struct position
+		{
+			size_t segment;
+			size_t offset;
+		};
+
+		static constexpr position locate(size_t index) noexcept
+		{
+			const size_t biased = index + base_size;
+			const size_t segment = static_cast<size_t>(std::bit_width(biased)) - 1 - BaseBits;
+			return { segment, biased - (base_size << segment) };
+		}
+
+		static constexpr size_t segment_size(size_t segment) noexcept
+		{
+			return base_size << segment;
+		}
+
+		// Index of the first element in segment
+		static constexpr size_t segment_start(size_t segment) noexcept
+		{
+			return (base_size << segment) - base_size;
+		}
+	};
+
+	static_assert(segment_layout<3>::locate(0).segment == 0);
+	static_assert(segment_layout<3>::locate(7).offset == 7);
+	static_assert(segment_layout<3>::locate(8).segment == 1 && segment_layout<3>::locate(8).offset == 0);
+	static_assert(segment_layout<3>::locate(24).segment == 2);
+	static_assert(segment_layout<3>::segment_start(2) == 24);
+
+	// Random access iterator over a segmented container, addressing elements by index through
+	// Container::operator[]. Value is const-qualified for the constant iterator. Containers
+	// whose operator[] returns a proxy object pass its type as Reference; operator-> is then
+	// unavailable.
+	template <class Container, class Value, class Reference = Value&>
+	class indexed_iterator
+	{
+	public:
+		using iterator_category = std::random_access_iterator_tag;
+		using difference_type = std::ptrdiff_t;
+		using value_type = std::remove_const_t<Value>;
+		using pointer = Value*;
+		using reference = Reference;
+
+		indexed_iterator() = default;
+
+		indexed_iterator(Container* container, size_t index) : container_(container), index_(index)
+		{}
+
+		// iterator converts to constant_iterator
+		template <class Other, class OtherValue, class OtherReference>
+			requires std::is_convertible_v<Other*, Container*> && std::is_convertible_v<OtherValue*, Value*>
+		indexed_iterator(const indexed_iterator<Other, OtherValue, OtherReference>& other)
+			: container_(other.container()), index_(other.index())
+		{}
+
+		reference operator*() const
+		{
+			return (*container_)[index_];
+		}
+
+		pointer operator->() const
+		{
+			return &(*container_)[index_];
+		}
+
+		reference operator[](difference_type offset) const
+		{
+			return (*container_)[index_ + offset];
+		}
+
+		indexed_iterator& operator++()
+		{
+			++index_;
+			return *this;
+		}
+
+		indexed_iterator operator++(int)
+		{
+			indexed_iterator old = *this;
+			++index_;
+			return old;
+		}
+
+		indexed_iterator& operator--()
+		{
+			--index_;
+			return *this;
+		}
+
+		indexed_iterator operator--(int)
+		{
+			indexed_iterator old = *this;
+			--index_;
+			return old;
+		}
+
+		indexed_iterator& operator+=(difference_type offset)
+		{
+			index_ += offset;
+			return *this;
+		}
+
+		indexed_iterator& operator-=(difference_type offset)
+		{
+			index_ -= offset;
+			return *this;
+		}
+
+		indexed_iterator operator+(difference_type offset) const
+		{
+			return indexed_iterator(container_, index_ + offset);
+		}
+
+		friend indexed_iterator operator+(difference_type offset, const indexed_iterator& it)
+		{
+			return it + offset;
+		}
+
+		indexed_iterator operator-(difference_type offset) const
+		{
+			return indexed_iterator(container_, index_ - offset);
+		}
+
+		difference_type operator-(const indexed_iterator& other) const
+		{
+			return static_cast<difference_type>(index_) - static_cast<difference_type>(other.index_);
+		}
+
+		bool operator==(const indexed_iterator& other) const
+		{
+			return index_ == other.index_;
+		}
+
+		std::strong_ordering operator<=>(const indexed_iterator& other) const
+		{
+			return index_ <=> other.index_;
+		}
+
+		[[nodiscard]] Container* container() const noexcept
+		{
+			return container_;
+		}
+
+		[[nodiscard]] size_t index() const noexcept
+		{
+			return index_;
+		}
+
+	private:
+		Container* container_ = nullptr;
+		size_t index_ = 0;
+	};
+}
@@ -0,0 +1,663 @@
+#pragma once
+#include "my_vector_exception.h"
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <ranges>
+#include <type_traits>
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define MY_VECTOR_SIMD_X86 1
+#include <immintrin.h>
+#endif
+
+// Vectorized algorithms over contiguous ranges of int32_t, float and double: find, count,
+// contains, remove, sum, min, max, minmax, dot, add and scale, plus popcount over 64-bit words. Each
+// has SSE4.2, AVX2 and AVX-512 kernels compiled side by side with #pragma GCC target; the
+// widest one the CPU supports is picked at run time, so the library itself still builds for
+// the baseline instruction set. Other arithmetic types, and CPUs without SSE4.2 and popcnt,
+// use the scalar loops.
+//
+// Integer sums and products wrap around like unsigned arithmetic. Floating-point sums and
+// dot products add in a different order than a sequential loop, so they may differ from it
+// in the last bits. min, max and minmax are unspecified for ranges holding NaN.
+namespace my_vector::simd
+{
+	enum class instruction_set
+	{
+		scalar,
+		sse4_2,
+		avx2,
+		avx512
+	};
+
+	// Widest instruction set this CPU and OS support
+	inline instruction_set detected_instruction_set() noexcept
+	{
+#if defined(MY_VECTOR_SIMD_X86)
+		static const instruction_set detected = []
+		{
+			__builtin_cpu_init();
+			// every kernel set also counts bits with popcnt
+			if (!__builtin_cpu_supports("popcnt"))
+			{
+				return instruction_set::scalar;
+			}
+			if (__builtin_cpu_supports("avx512f"))
+			{
+				return instruction_set::avx512;
+			}
+			if (__builtin_cpu_supports("avx2"))
+			{
+				return instruction_set::avx2;
+			}
+			if (__builtin_cpu_supports("sse4.2"))
+			{
+				return instruction_set::sse4_2;
+			}
+			return instruction_set::scalar;
+		}();
+		return detected;
+#else
+		return instruction_set::scalar;
+#endif
+	}
+
+	namespace detail
+	{
+		inline std::atomic<instruction_set>& active_set() noexcept
+		{
+			static std::atomic<instruction_set> active(detected_instruction_set());
+			return active;
+		}
+	}
+
+	// Instruction set the algorithms currently use
+	inline instruction_set active_instruction_set() noexcept
+	{
+		return detail::active_set().load(std::memory_order_relaxed);
+	}
+
+	// Makes the algorithms use at most limit, for testing and comparing the kernels.
+	// Returns the instruction set now in use.
+	inline instruction_set limit_instruction_set(instruction_set limit) noexcept
+	{
+		const instruction_set chosen = std::min(limit, detected_instruction_set());
+		detail::active_set().store(chosen, std::memory_order_relaxed);
+		return chosen;
+	}
+
+	namespace detail
+	{
+		template <class T>
+		inline constexpr bool has_kernels_v = std::is_same_v<T, int32_t> || std::is_same_v<T, float> || std::is_same_v<T, double>;
+
+		// Integer arithmetic is done unsigned, wrapping like the vector instructions
+		template <class T>
+		T wrapping_add(T a, T b) noexcept
+		{
+			if constexpr (std::is_integral_v<T>)
+			{
+				using U = std::make_unsigned_t<T>;
+				return static_cast<T>(static_cast<U>(static_cast<U>(a) + static_cast<U>(b)));
+			}
+			else
+			{
+				return a + b;
+			}
+		}
+
+		template <class T>
+		T wrapping_mul(T a, T b) noexcept
+		{
+			if constexpr (std::is_integral_v<T>)
+			{
+				// promoted first, so that small unsigned types do not multiply as signed int
+				using U = std::common_type_t<std::make_unsigned_t<T>, unsigned>;
+				return static_cast<T>(static_cast<U>(a) * static_cast<U>(b));
+			}
+			else
+			{
+				return a * b;
+			}
+		}
+
+		struct scalar_kernels
+		{
+			template <class T>
+			static size_t find(const T* data, size_t count, T value) noexcept
+			{
+				size_t i = 0;
+				while (i < count && !(data[i] == value))
+				{
+					++i;
+				}
+				return i;
+			}
+
+			template <class T>
+			static size_t count(const T* data, size_t count, T value) noexcept
+			{
+				size_t result = 0;
+				for (size_t i = 0; i < count; ++i)
+				{
+					result += data[i] == value ? 1 : 0;
+				}
+				return result;
+			}
+
+			template <class T>
+			static size_t remove(T* data, size_t count, T value) noexcept
+			{
+				size_t kept = 0;
+				for (size_t i = 0; i < count; ++i)
+				{
+					if (!(data[i] == value))
+					{
+						data[kept++] = data[i];
+					}
+				}
+				return kept;
+			}
+
+			template <class T>
+			static T sum(const T* data, size_t count) noexcept
+			{
+				T result = T();
+				for (size_t i = 0; i < count; ++i)
+				{
+					result = wrapping_add(result, data[i]);
+				}
+				return result;
+			}
+
+			template <class T>
+			static std::ranges::min_max_result<T> minmax(const T* data, size_t count) noexcept
+			{
+				std::ranges::min_max_result<T> result{ data[0], data[0] };
+				for (size_t i = 1; i < count; ++i)
+				{
+					result.min = data[i] < result.min ? data[i] : result.min;
+					result.max = result.max < data[i] ? data[i] : result.max;
+				}
+				return result;
+			}
+
+			template <class T>
+			static T dot(const T* left, const T* right, size_t count) noexcept
+			{
+				T result = T();
+				for (size_t i = 0; i < count; ++i)
+				{
+					result = wrapping_add(result, wrapping_mul(left[i], right[i]));
+				}
+				return result;
+			}
+
+			template <class T>
+			static void add(T* dest, const T* source, size_t count) noexcept
+			{
+				for (size_t i = 0; i < count; ++i)
+				{
+					dest[i] = wrapping_add(dest[i], source[i]);
+				}
+			}
+
+			template <class T>
+			static void scale(T* data, size_t count, T factor) noexcept
+			{
+				for (size_t i = 0; i < count; ++i)
+				{
+					data[i] = wrapping_mul(data[i], factor);
+				}
+			}
+
+			static size_t popcount(const uint64_t* words, size_t count) noexcept
+			{
+				size_t result = 0;
+				for (size_t i = 0; i < count; ++i)
+				{
+					result += static_cast<size_t>(std::popcount(words[i]));
+				}
+				return result;
+			}
+		};
+
+		// Shuffle tables for compressing lanes without AVX-512. Entry mask lists the lanes whose
+		// bit is set in mask, in order, each as Parts consecutive indices of 1 / Parts lane
+		// (bytes for pshufb, dwords for vpermd); the unused tail of the entry is zero.
+		template <size_t Lanes, size_t Parts, class Index>
+		inline constexpr auto compress_table = []
+		{
+			std::array<std::array<Index, Lanes * Parts>, size_t{ 1 } << Lanes> table{};
+			for (size_t mask = 0; mask < table.size(); ++mask)
+			{
+				size_t out = 0;
+				for (size_t lane = 0; lane < Lanes; ++lane)
+				{
+					if ((mask >> lane & 1) != 0)
+					{
+						for (size_t part = 0; part < Parts; ++part)
+						{
+							table[mask][out++] = static_cast<Index>(lane * Parts + part);
+						}
+					}
+				}
+			}
+			return table;
+		}();
+	}
+}
+
+#if defined(MY_VECTOR_SIMD_X86)
+#pragma GCC push_options
+#pragma GCC target("sse4.2,popcnt")
+namespace my_vector::simd::detail::sse4_2
+{
+	template <class T>
+	struct lanes;
+
+	template <>
+	struct lanes<int32_t>
+	{
+		using reg = __m128i;
+		static constexpr size_t width = 4;
+
+		static reg load(const int32_t* p) { return _mm_loadu_si128(reinterpret_cast<const __m128i*>(p)); }
+		static void store(int32_t* p, reg r) { _mm_storeu_si128(reinterpret_cast<__m128i*>(p), r); }
+		static reg broadcast(int32_t value) { return _mm_set1_epi32(value); }
+		static reg zero() { return _mm_setzero_si128(); }
+		static reg add(reg a, reg b) { return _mm_add_epi32(a, b); }
+		static reg mul(reg a, reg b) { return _mm_mullo_epi32(a, b); }
+		static reg min(reg a, reg b) { return _mm_min_epi32(a, b); }
+		static reg max(reg a, reg b) { return _mm_max_epi32(a, b); }
+		static unsigned equal(reg a, reg b) { return static_cast<unsigned>(_mm_movemask_ps(_mm_castsi128_ps(_mm_cmpeq_epi32(a, b)))); }
+		static void compress_store(int32_t* p, reg r, unsigned keep)
+		{
+			const __m128i shuffle = _mm_loadu_si128(reinterpret_cast<const __m128i*>(compress_table<4, 4, uint8_t>[keep].data()));
+			store(p, _mm_shuffle_epi8(r, shuffle));
+		}
+	};
+
+	template <>
+	struct lanes<float>
+	{
+		using reg = __m128;
+		static constexpr size_t width = 4;
+
+		static reg load(const float* p) { return _mm_loadu_ps(p); }
+		static void store(float* p, reg r) { _mm_storeu_ps(p, r); }
+		static reg broadcast(float value) { return _mm_set1_ps(value); }
+		static reg zero() { return _mm_setzero_ps(); }
+		static reg add(reg a, reg b) { return _mm_add_ps(a, b); }
+		static reg mul(reg a, reg b) { return _mm_mul_ps(a, b); }
+		static reg min(reg a, reg b) { return _mm_min_ps(a, b); }
+		static reg max(reg a, reg b) { return _mm_max_ps(a, b); }
+		static unsigned equal(reg a, reg b) { return static_cast<unsigned>(_mm_movemask_ps(_mm_cmpeq_ps(a, b))); }
+		static void compress_store(float* p, reg r, unsigned keep)
+		{
+			const __m128i shuffle = _mm_loadu_si128(reinterpret_cast<const __m128i*>(compress_table<4, 4, uint8_t>[keep].data()));
+			store(p, _mm_castsi128_ps(_mm_shuffle_epi8(_mm_castps_si128(r), shuffle)));
+		}
+	};
+
+	template <>
+	struct lanes<double>
+	{
+		using reg = __m128d;
+		static constexpr size_t width = 2;
+
+		static reg load(const double* p) { return _mm_loadu_pd(p); }
+		static void store(double* p, reg r) { _mm_storeu_pd(p, r); }
+		static reg broadcast(double value) { return _mm_set1_pd(value); }
+		static reg zero() { return _mm_setzero_pd(); }
+		static reg add(reg a, reg b) { return _mm_add_pd(a, b); }
+		static reg mul(reg a, reg b) { return _mm_mul_pd(a, b); }
+		static reg min(reg a, reg b) { return _mm_min_pd(a, b); }
+		static reg max(reg a, reg b) { return _mm_max_pd(a, b); }
+		static unsigned equal(reg a, reg b) { return static_cast<unsigned>(_mm_movemask_pd(_mm_cmpeq_pd(a, b))); }
+		static void compress_store(double* p, reg r, unsigned keep)
+		{
+			const __m128i shuffle = _mm_loadu_si128(reinterpret_cast<const __m128i*>(compress_table<2, 8, uint8_t>[keep].data()));
+			store(p, _mm_castsi128_pd(_mm_shuffle_epi8(_mm_castpd_si128(r), shuffle)));
+		}
+	};
+
+#include "my_vector_simd_kernels.h"
+}
+#pragma GCC pop_options
+
+#pragma GCC push_options
+#pragma GCC target("avx2,popcnt")
+namespace my_vector::simd::detail::avx2
+{
+	template <class T>
+	struct lanes;
+
+	template <>
+	struct lanes<int32_t>
+	{
+		using reg = __m256i;
+		static constexpr size_t width = 8;
+
+		static reg load(const int32_t* p) { return _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p)); }
+		static void store(int32_t* p, reg r) { _mm256_storeu_si256(reinterpret_cast<__m256i*>(p), r); }
+		static reg broadcast(int32_t value) { return _mm256_set1_epi32(value); }
+		static reg zero() { return _mm256_setzero_si256(); }
+		static reg add(reg a, reg b) { return _mm256_add_epi32(a, b); }
+		static reg mul(reg a, reg b) { return _mm256_mullo_epi32(a, b); }
+		static reg min(reg a, reg b) { return _mm256_min_epi32(a, b); }
+		static reg max(reg a, reg b) { return _mm256_max_epi32(a, b); }
+		static unsigned equal(reg a, reg b) { return static_cast<unsigned>(_mm256_movemask_ps(_mm256_castsi256_ps(_mm256_cmpeq_epi32(a, b)))); }
+		static void compress_store(int32_t* p, reg r, unsigned keep)
+		{
+			const __m256i order = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(compress_table<8, 1, uint32_t>[keep].data()));
+			store(p, _mm256_permutevar8x32_epi32(r, order));
+		}
+	};
+
+	template <>
+	struct lanes<float>
+	{
+		using reg = __m256;
+		static constexpr size_t width = 8;
+
+		static reg load(const float* p) { return _mm256_loadu_ps(p); }
+		static void store(float* p, reg r) { _mm256_storeu_ps(p, r); }
+		static reg broadcast(float value) { return _mm256_set1_ps(value); }
+		static reg zero() { return _mm256_setzero_ps(); }
+		static reg add(reg a, reg b) { return _mm256_add_ps(a, b); }
+		static reg mul(reg a, reg b) { return _mm256_mul_ps(a, b); }
+		static reg min(reg a, reg b) { return _mm256_min_ps(a, b); }
+		static reg max(reg a, reg b) { return _mm256_max_ps(a, b); }
+		static unsigned equal(reg a, reg b) { return static_cast<unsigned>(_mm256_movemask_ps(_mm256_cmp_ps(a, b, _CMP_EQ_OQ))); }
+		static void compress_store(float* p, reg r, unsigned keep)
+		{
+			const __m256i order = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(compress_table<8, 1, uint32_t>[keep].data()));
+			store(p, _mm256_permutevar8x32_ps(r, order));
+		}
+	};
+
+	template <>
+	struct lanes<double>
+	{
+		using reg = __m256d;
+		static constexpr size_t width = 4;
+
+		static reg load(const double* p) { return _mm256_loadu_pd(p); }
+		static void store(double* p, reg r) { _mm256_storeu_pd(p, r); }
+		static reg broadcast(double value) { return _mm256_set1_pd(value); }
+		static reg zero() { return _mm256_setzero_pd(); }
+		static reg add(reg a, reg b) { return _mm256_add_pd(a, b); }
+		static reg mul(reg a, reg b) { return _mm256_mul_pd(a, b); }
+		static reg min(reg a, reg b) { return _mm256_min_pd(a, b); }
+		static reg max(reg a, reg b) { return _mm256_max_pd(a, b); }
+		static unsigned equal(reg a, reg b) { return static_cast<unsigned>(_mm256_movemask_pd(_mm256_cmp_pd(a, b, _CMP_EQ_OQ))); }
+		static void compress_store(double* p, reg r, unsigned keep)
+		{
+			// each double moves as a pair of dwords
+			const __m256i order = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(compress_table<4, 2, uint32_t>[keep].data()));
+			store(p, _mm256_castps_pd(_mm256_permutevar8x32_ps(_mm256_castpd_ps(r), order)));
+		}
+	};
+
+#include "my_vector_simd_kernels.h"
+}
+#pragma GCC pop_options
+
+#pragma GCC push_options
+#pragma GCC target("avx512f,popcnt")
+// min and max go through the full-mask forms: the plain ones trip a false
+// -Wmaybe-uninitialized inside GCC 12's avx512fintrin.h and compile to the same instruction
+namespace my_vector::simd::detail::avx512
+{
+	template <class T>
+	struct lanes;
+
+	template <>
+	struct lanes<int32_t>
+	{
+		using reg = __m512i;
+		static constexpr size_t width = 16;
+
+		static reg load(const int32_t* p) { return _mm512_loadu_si512(p); }
+		static void store(int32_t* p, reg r) { _mm512_storeu_si512(p, r); }
+		static reg broadcast(int32_t value) { return _mm512_set1_epi32(value); }
+		static reg zero() { return _mm512_setzero_si512(); }
+		static reg add(reg a, reg b) { return _mm512_add_epi32(a, b); }
+		static reg mul(reg a, reg b) { return _mm512_mullo_epi32(a, b); }
+		static reg min(reg a, reg b) { return _mm512_mask_min_epi32(a, 0xFFFF, a, b); }
+		static reg max(reg a, reg b) { return _mm512_mask_max_epi32(a, 0xFFFF, a, b); }
+		static unsigned equal(reg a, reg b) { return _mm512_cmpeq_epi32_mask(a, b); }
+		static void compress_store(int32_t* p, reg r, unsigned keep) { store(p, _mm512_maskz_compress_epi32(static_cast<__mmask16>(keep), r)); }
+	};
+
+	template <>
+	struct lanes<float>
+	{
+		using reg = __m512;
+		static constexpr size_t width = 16;
+
+		static reg load(const float* p) { return _mm512_loadu_ps(p); }
+		static void store(float* p, reg r) { _mm512_storeu_ps(p, r); }
+		static reg broadcast(float value) { return _mm512_set1_ps(value); }
+		static reg zero() { return _mm512_setzero_ps(); }
+		static reg add(reg a, reg b) { return _mm512_add_ps(a, b); }
+		static reg mul(reg a, reg b) { return _mm512_mul_ps(a, b); }
+		static reg min(reg a, reg b) { return _mm512_mask_min_ps(a, 0xFFFF, a, b); }
+		static reg max(reg a, reg b) { return _mm512_mask_max_ps(a, 0xFFFF, a, b); }
+		static unsigned equal(reg a, reg b) { return _mm512_cmp_ps_mask(a, b, _CMP_EQ_OQ); }
+		static void compress_store(float* p, reg r, unsigned keep) { store(p, _mm512_maskz_compress_ps(static_cast<__mmask16>(keep), r)); }
+	};
+
+	template <>
+	struct lanes<double>
+	{
+		using reg = __m512d;
+		static constexpr size_t width = 8;
+
+		static reg load(const double* p) { return _mm512_loadu_pd(p); }
+		static void store(double* p, reg r) { _mm512_storeu_pd(p, r); }
+		static reg broadcast(double value) { return _mm512_set1_pd(value); }
+		static reg zero() { return _mm512_setzero_pd(); }
+		static reg add(reg a, reg b) { return _mm512_add_pd(a, b); }
+		static reg mul(reg a, reg b) { return _mm512_mul_pd(a, b); }
+		static reg min(reg a, reg b) { return _mm512_mask_min_pd(a, 0xFF, a, b); }
+		static reg max(reg a, reg b) { return _mm512_mask_max_pd(a, 0xFF, a, b); }
+		static unsigned equal(reg a, reg b) { return _mm512_cmp_pd_mask(a, b, _CMP_EQ_OQ); }
+		static void compress_store(double* p, reg r, unsigned keep) { store(p, _mm512_maskz_compress_pd(static_cast<__mmask8>(keep), r)); }
+	};
+
+#include "my_vector_simd_kernels.h"
+}
+#pragma GCC pop_options
+#endif
+
+namespace my_vector::simd
+{
+	namespace detail
+	{
+		// Calls call(kernels) with the kernel set for T and the active instruction set
+		template <class T, class F>
+		decltype(auto) dispatch(F&& call)
+		{
+#if defined(MY_VECTOR_SIMD_X86)
+			if constexpr (has_kernels_v<T>)
+			{
+				switch (active_instruction_set())
+				{
+				case instruction_set::avx512:
+					return call(avx512::kernels{});
+				case instruction_set::avx2:
+					return call(avx2::kernels{});
+				case instruction_set::sse4_2:
+					return call(sse4_2::kernels{});
+				case instruction_set::scalar:
+					break;
+				}
+			}
+#endif
+			return call(scalar_kernels{});
+		}
+
+		// Like dispatch, for popcount: the only kernel over uint64_t, which has no lanes<T>
+		inline size_t dispatch_popcount(const uint64_t* words, size_t count) noexcept
+		{
+#if defined(MY_VECTOR_SIMD_X86)
+			switch (active_instruction_set())
+			{
+			case instruction_set::avx512:
+				return avx512::kernels::popcount(words, count);
+			case instruction_set::avx2:
+				return avx2::kernels::popcount(words, count);
+			case instruction_set::sse4_2:
+				return sse4_2::kernels::popcount(words, count);
+			case instruction_set::scalar:
+				break;
+			}
+#endif
+			return scalar_kernels::popcount(words, count);
+		}
+
+		template <class R>
+		concept arithmetic_range = std::ranges::contiguous_range<R> && std::ranges::sized_range<R>
+			&& std::is_arithmetic_v<std::ranges::range_value_t<R>>;
+
+		template <class R>
+		void check_same_size(const R& left, const R& right)
+		{
+			if (std::ranges::size(left) != std::ranges::size(right))
+			{
+				throw my_vector_exception("Vector sizes differ");
+			}
+		}
+	}
+
+	// Iterator to the first element equal to value, or end
+	template <detail::arithmetic_range R>
+	auto find(R&& range, std::ranges::range_value_t<R> value)
+	{
+		using T = std::ranges::range_value_t<R>;
+		const size_t index = detail::dispatch<T>([&](auto kernels)
+		{
+			return decltype(kernels)::find(std::ranges::data(range), std::ranges::size(range), value);
+		});
+		return std::ranges::begin(range) + static_cast<std::ranges::range_difference_t<R>>(index);
+	}
+
+	template <detail::arithmetic_range R>
+	size_t count(const R& range, std::ranges::range_value_t<R> value)
+	{
+		using T = std::ranges::range_value_t<R>;
+		return detail::dispatch<T>([&](auto kernels)
+		{
+			return decltype(kernels)::count(std::ranges::data(range), std::ranges::size(range), value);
+		});
+	}
+
+	template <detail::arithmetic_range R>
+	bool contains(const R& range, std::ranges::range_value_t<R> value)
+	{
+		using T = std::ranges::range_value_t<R>;
+		return detail::dispatch<T>([&](auto kernels)
+		{
+			return decltype(kernels)::find(std::ranges::data(range), std::ranges::size(range), value);
+		}) != std::ranges::size(range);
+	}
+
+	// Moves the elements not equal to value to the front, keeping their order, and returns the
+	// new end, like std::remove. The lanes that stay are packed with AVX-512 compress or,
+	// below it, a table-driven shuffle.
+	template <detail::arithmetic_range R>
+	auto remove(R&& range, std::ranges::range_value_t<R> value)
+	{
+		using T = std::ranges::range_value_t<R>;
+		const size_t kept = detail::dispatch<T>([&](auto kernels)
+		{
+			return decltype(kernels)::remove(std::ranges::data(range), std::ranges::size(range), value);
+		});
+		return std::ranges::begin(range) + static_cast<std::ranges::range_difference_t<R>>(kept);
+	}
+
+	template <detail::arithmetic_range R>
+	std::ranges::range_value_t<R> sum(const R& range)
+	{
+		using T = std::ranges::range_value_t<R>;
+		return detail::dispatch<T>([&](auto kernels)
+		{
+			return decltype(kernels)::sum(std::ranges::data(range), std::ranges::size(range));
+		});
+	}
+
+	// Smallest and largest element; throws if range is empty
+	template <detail::arithmetic_range R>
+	std::ranges::min_max_result<std::ranges::range_value_t<R>> minmax(const R& range)
+	{
+		using T = std::ranges::range_value_t<R>;
+		if (std::ranges::empty(range))
+		{
+			throw my_vector_exception("Vector is empty");
+		}
+		return detail::dispatch<T>([&](auto kernels)
+		{
+			return decltype(kernels)::minmax(std::ranges::data(range), std::ranges::size(range));
+		});
+	}
+
+	template <detail::arithmetic_range R>
+	std::ranges::range_value_t<R> min(const R& range)
+	{
+		return minmax(range).min;
+	}
+
+	template <detail::arithmetic_range R>
+	std::ranges::range_value_t<R> max(const R& range)
+	{
+		return minmax(range).max;
+	}
+
+	// Sum of left[i] * right[i]; throws if the sizes differ
+	template <detail::arithmetic_range R>
+	std::ranges::range_value_t<R> dot(const R& left, const R& right)
+	{
+		using T = std::ranges::range_value_t<R>;
+		detail::check_same_size(left, right);
+		return detail::dispatch<T>([&](auto kernels)
+		{
+			return decltype(kernels)::dot(std::ranges::data(left), std::ranges::data(right), std::ranges::size(left));
+		});
+	}
+
+	// dest[i] += source[i]; throws if the sizes differ
+	template <detail::arithmetic_range R>
+	void add(R& dest, const R& source)
+	{
+		using T = std::ranges::range_value_t<R>;
+		detail::check_same_size(dest, source);
+		detail::dispatch<T>([&](auto kernels)
+		{
+			decltype(kernels)::add(std::ranges::data(dest), std::ranges::data(source), std::ranges::size(dest));
+		});
+	}
+
+	// range[i] *= factor
+	template <detail::arithmetic_range R>
+	void scale(R& range, std::ranges::range_value_t<R> factor)
+	{
+		using T = std::ranges::range_value_t<R>;
+		detail::dispatch<T>([&](auto kernels)
+		{
+			decltype(kernels)::scale(std::ranges::data(range), std::ranges::size(range), factor);
+		});
+	}
+
+	// Number of set bits in count words, with the popcnt instruction where available
+	inline size_t popcount(const uint64_t* words, size_t count) noexcept
+	{
+		return detail::dispatch_popcount(words, count);
+	}
+}
@@ -0,0 +1,243 @@
+// Kernel bodies shared by every instruction set. Deliberately without include guard:
+// my_vector_simd.h includes this file once per instruction set, each time inside a
+// namespace that defines lanes<T> and under a #pragma GCC target for that set, so the same
+// source is compiled into SSE4.2, AVX2 and AVX-512 code. Do not include it directly.
+//
+// lanes<T> provides the register type reg, its element count width, and
+//	load, store, broadcast, zero, add, mul, min, max	elementwise operations
+//	equal(a, b)	bitmask with bit i set where lane i of a equals lane i of b
+//	compress_store(p, r, keep)	stores the lanes of r selected by the bitmask keep to p
+//		in order; may write all width elements
+
+// Copies the lanes of r into an array, for the horizontal reductions done once per call
+template <class T>
+struct lane_array
+{
+	T values[lanes<T>::width];
+
+	explicit lane_array(typename lanes<T>::reg r)
+	{
+		lanes<T>::store(values, r);
+	}
+};
+
+struct kernels
+{
+	// Index of the first element equal to value, or count if there is none
+	template <class T>
+	static size_t find(const T* data, size_t count, T value) noexcept
+	{
+		using L = lanes<T>;
+		const typename L::reg needle = L::broadcast(value);
+		size_t i = 0;
+		for (; i + L::width <= count; i += L::width)
+		{
+			const auto mask = L::equal(L::load(data + i), needle);
+			if (mask != 0)
+			{
+				return i + static_cast<size_t>(std::countr_zero(mask));
+			}
+		}
+		for (; i < count; ++i)
+		{
+			if (data[i] == value)
+			{
+				return i;
+			}
+		}
+		return count;
+	}
+
+	template <class T>
+	static size_t count(const T* data, size_t count, T value) noexcept
+	{
+		using L = lanes<T>;
+		const typename L::reg needle = L::broadcast(value);
+		size_t result = 0;
+		size_t i = 0;
+		for (; i + L::width <= count; i += L::width)
+		{
+			result += static_cast<size_t>(std::popcount(L::equal(L::load(data + i), needle)));
+		}
+		for (; i < count; ++i)
+		{
+			result += data[i] == value ? 1 : 0;
+		}
+		return result;
+	}
+
+	// Packs the elements not equal to value to the front in order; returns how many there are
+	template <class T>
+	static size_t remove(T* data, size_t count, T value) noexcept
+	{
+		using L = lanes<T>;
+		constexpr unsigned all_lanes = (1u << L::width) - 1;
+		const typename L::reg needle = L::broadcast(value);
+		size_t kept = 0;
+		size_t i = 0;
+		for (; i + L::width <= count; i += L::width)
+		{
+			const typename L::reg values = L::load(data + i);
+			const unsigned keep = ~L::equal(values, needle) & all_lanes;
+			// the full-width store stays within the block just loaded, as kept <= i
+			L::compress_store(data + kept, values, keep);
+			kept += static_cast<size_t>(std::popcount(keep));
+		}
+		for (; i < count; ++i)
+		{
+			if (!(data[i] == value))
+			{
+				data[kept++] = data[i];
+			}
+		}
+		return kept;
+	}
+
+	template <class T>
+	static T sum(const T* data, size_t count) noexcept
+	{
+		using L = lanes<T>;
+		// four independent accumulators hide the latency of the adds
+		typename L::reg acc[4] = { L::zero(), L::zero(), L::zero(), L::zero() };
+		size_t i = 0;
+		for (; i + 4 * L::width <= count; i += 4 * L::width)
+		{
+			for (size_t a = 0; a < 4; ++a)
+			{
+				acc[a] = L::add(acc[a], L::load(data + i + a * L::width));
+			}
+		}
+		for (; i + L::width <= count; i += L::width)
+		{
+			acc[0] = L::add(acc[0], L::load(data + i));
+		}
+		const lane_array<T> partial(L::add(L::add(acc[0], acc[1]), L::add(acc[2], acc[3])));
+		T result = T();
+		for (const T value : partial.values)
+		{
+			result = wrapping_add(result, value);
+		}
+		for (; i < count; ++i)
+		{
+			result = wrapping_add(result, data[i]);
+		}
+		return result;
+	}
+
+	// count must be positive
+	template <class T>
+	static std::ranges::min_max_result<T> minmax(const T* data, size_t count) noexcept
+	{
+		using L = lanes<T>;
+		std::ranges::min_max_result<T> result{ data[0], data[0] };
+		size_t i = 0;
+		if (count >= L::width)
+		{
+			typename L::reg low = L::load(data);
+			typename L::reg high = low;
+			for (i = L::width; i + L::width <= count; i += L::width)
+			{
+				const typename L::reg values = L::load(data + i);
+				low = L::min(low, values);
+				high = L::max(high, values);
+			}
+			const lane_array<T> lows(low);
+			const lane_array<T> highs(high);
+			for (size_t lane = 0; lane < L::width; ++lane)
+			{
+				result.min = lows.values[lane] < result.min ? lows.values[lane] : result.min;
+				result.max = result.max < highs.values[lane] ? highs.values[lane] : result.max;
+			}
+		}
+		for (; i < count; ++i)
+		{
+			result.min = data[i] < result.min ? data[i] : result.min;
+			result.max = result.max < data[i] ? data[i] : result.max;
+		}
+		return result;
+	}
+
+	template <class T>
+	static T dot(const T* left, const T* right, size_t count) noexcept
+	{
+		using L = lanes<T>;
+		typename L::reg acc[2] = { L::zero(), L::zero() };
+		size_t i = 0;
+		for (; i + 2 * L::width <= count; i += 2 * L::width)
+		{
+			for (size_t a = 0; a < 2; ++a)
+			{
+				const size_t at = i + a * L::width;
+				acc[a] = L::add(acc[a], L::mul(L::load(left + at), L::load(right + at)));
+			}
+		}
+		for (; i + L::width <= count; i += L::width)
+		{
+			acc[0] = L::add(acc[0], L::mul(L::load(left + i), L::load(right + i)));
+		}
+		const lane_array<T> partial(L::add(acc[0], acc[1]));
+		T result = T();
+		for (const T value : partial.values)
+		{
+			result = wrapping_add(result, value);
+		}
+		for (; i < count; ++i)
+		{
+			result = wrapping_add(result, wrapping_mul(left[i], right[i]));
+		}
+		return result;
+	}
+
+	// dest[i] += source[i]
+	template <class T>
+	static void add(T* dest, const T* source, size_t count) noexcept
+	{
+		using L = lanes<T>;
+		size_t i = 0;
+		for (; i + L::width <= count; i += L::width)
+		{
+			L::store(dest + i, L::add(L::load(dest + i), L::load(source + i)));
+		}
+		for (; i < count; ++i)
+		{
+			dest[i] = wrapping_add(dest[i], source[i]);
+		}
+	}
+
+	// Compiled with popcnt enabled, so std::popcount is one instruction per word
+	static size_t popcount(const uint64_t* words, size_t count) noexcept
+	{
+		// independent sums keep several popcnt instructions in flight
+		size_t sums[4] = {};
+		size_t i = 0;
+		for (; i + 4 <= count; i += 4)
+		{
+			for (size_t a = 0; a < 4; ++a)
+			{
+				sums[a] += static_cast<size_t>(std::popcount(words[i + a]));
+			}
+		}
+		for (; i < count; ++i)
+		{
+			sums[0] += static_cast<size_t>(std::popcount(words[i]));
+		}
+		return sums[0] + sums[1] + sums[2] + sums[3];
+	}
+
+	// data[i] *= factor
+	template <class T>
+	static void scale(T* data, size_t count, T factor) noexcept
+	{
+		using L = lanes<T>;
+		const typename L::reg by = L::broadcast(factor);
+		size_t i = 0;
+		for (; i + L::width <= count; i += L::width)
+		{
+			L::store(data + i, L::mul(L::load(data + i), by));
+		}
+		for (; i < count; ++i)
+		{
+			data[i] = wrapping_mul(data[i], factor);
+		}
+	}
+};
@@ -0,0 +1,274 @@
+#pragma once
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <mutex>
+#include <string>
+#include <utility>
+
+namespace my_vector
+{
+	// Memory activity of one vector, or of every vector reporting under one registry name
+	struct vector_stats
+	{
+		// Moves of the elements to a new block (growth, shrink_to_fit, realloc)
+		uint64_t reallocations = 0;
+		uint64_t elements_relocated = 0;
+		uint64_t bytes_allocated = 0;
+		uint64_t bytes_freed = 0;
+		size_t peak_size = 0;
+		size_t peak_capacity = 0;
+		// Allocated but unused bytes, (capacity - size) * sizeof(T)
+		size_t slack_bytes = 0;
+
+		[[nodiscard]] uint64_t live_bytes() const noexcept
+		{
+			return bytes_allocated - bytes_freed;
+		}
+	};
+
+	// Stats policies are the third template parameter of vector. The vector reports
+	//
+	//	on_allocate(bytes)	a block was obtained, or an existing one grew in place by bytes
+	//	on_deallocate(bytes)	a block was released
+	//	on_relocate(count)	the elements moved to a new block, count of them
+	//	on_usage(size, capacity, element_size)	after operations that grow the vector or change its capacity
+	//	snapshot() -> vector_stats	counters for vector::stats()
+	//
+	// Stats stay with the vector object: they are not copied, moved or swapped with its contents.
+
+	// Default policy: every hook is empty and the member takes no space, so it compiles away
+	struct no_stats
+	{
+		constexpr void on_allocate(size_t) noexcept
+		{}
+
+		constexpr void on_deallocate(size_t) noexcept
+		{}
+
+		constexpr void on_relocate(size_t) noexcept
+		{}
+
+		constexpr void on_usage(size_t, size_t, size_t) noexcept
+		{}
+
+		[[nodiscard]] constexpr vector_stats snapshot() const noexcept
+		{
+			return {};
+		}
+	};
+
+	// Plain per-instance counters, as cheap as the vector itself is thread-safe
+	class counting_stats
+	{
+		vector_stats stats_;
+
+	public:
+		void on_allocate(size_t bytes) noexcept
+		{
+			stats_.bytes_allocated += bytes;
+		}
+
+		void on_deallocate(size_t bytes) noexcept
+		{
+			stats_.bytes_freed += bytes;
+		}
+
+		void on_relocate(size_t count) noexcept
+		{
+			++stats_.reallocations;
+			stats_.elements_relocated += count;
+		}
+
+		void on_usage(size_t size, size_t capacity, size_t) noexcept
+		{
+			if (size > stats_.peak_size)
+			{
+				stats_.peak_size = size;
+			}
+			if (capacity > stats_.peak_capacity)
+			{
+				stats_.peak_capacity = capacity;
+			}
+		}
+
+		[[nodiscard]] vector_stats snapshot() const noexcept
+		{
+			return stats_;
+		}
+	};
+
+	// Process-wide totals per name, updated concurrently by registered_stats instances
+	class stats_registry
+	{
+	public:
+		class entry
+		{
+			std::string name_;
+			std::atomic<uint64_t> reallocations_{ 0 };
+			std::atomic<uint64_t> elements_relocated_{ 0 };
+			std::atomic<uint64_t> bytes_allocated_{ 0 };
+			std::atomic<uint64_t> bytes_freed_{ 0 };
+			std::atomic<size_t> peak_size_{ 0 };
+			std::atomic<size_t> peak_capacity_{ 0 };
+			std::atomic<int64_t> slack_bytes_{ 0 };
+
+			static void raise(std::atomic<size_t>& peak, size_t value) noexcept
+			{
+				size_t current = peak.load(std::memory_order_relaxed);
+				while (value > current && !peak.compare_exchange_weak(current, value, std::memory_order_relaxed))
+				{}
+			}
+
+		public:
+			explicit entry(std::string name) : name_(std::move(name))
+			{}
+
+			void add_allocated(uint64_t bytes) noexcept
+			{
+				bytes_allocated_.fetch_add(bytes, std::memory_order_relaxed);
+			}
+
+			void add_freed(uint64_t bytes) noexcept
+			{
+				bytes_freed_.fetch_add(bytes, std::memory_order_relaxed);
+			}
+
+			void add_relocation(uint64_t count) noexcept
+			{
+				reallocations_.fetch_add(1, std::memory_order_relaxed);
+				elements_relocated_.fetch_add(count, std::memory_order_relaxed);
+			}
+
+			void add_slack(int64_t delta) noexcept
+			{
+				slack_bytes_.fetch_add(delta, std::memory_order_relaxed);
+			}
+
+			void raise_peaks(size_t size, size_t capacity) noexcept
+			{
+				raise(peak_size_, size);
+				raise(peak_capacity_, capacity);
+			}
+
+			[[nodiscard]] const std::string& name() const noexcept
+			{
+				return name_;
+			}
+
+			[[nodiscard]] vector_stats snapshot() const noexcept
+			{
+				vector_stats result;
+				result.reallocations = reallocations_.load(std::memory_order_relaxed);
+				result.elements_relocated = elements_relocated_.load(std::memory_order_relaxed);
+				result.bytes_allocated = bytes_allocated_.load(std::memory_order_relaxed);
+				result.bytes_freed = bytes_freed_.load(std::memory_order_relaxed);
+				result.peak_size = peak_size_.load(std::memory_order_relaxed);
+				result.peak_capacity = peak_capacity_.load(std::memory_order_relaxed);
+				const int64_t slack = slack_bytes_.load(std::memory_order_relaxed);
+				result.slack_bytes = slack > 0 ? static_cast<size_t>(slack) : 0;
+				return result;
+			}
+		};
+
+		static stats_registry& global()
+		{
+			static stats_registry registry;
+			return registry;
+		}
+
+		// The entry for name, created on first use. Entries live as long as the registry.
+		entry& find_or_add(const std::string& name)
+		{
+			std::lock_guard lock(mutex_);
+			for (entry& existing : entries_)
+			{
+				if (existing.name() == name)
+				{
+					return existing;
+				}
+			}
+			return entries_.emplace_back(name);
+		}
+
+		// Calls visit(name, stats) for every entry
+		template <class F>
+		void for_each(F&& visit) const
+		{
+			std::lock_guard lock(mutex_);
+			for (const entry& existing : entries_)
+			{
+				visit(existing.name(), existing.snapshot());
+			}
+		}
+
+	private:
+		mutable std::mutex mutex_;
+		std::deque<entry> entries_;
+	};
+
+	// Per-instance counters that also feed the registry entry named Tag::name. Totals are
+	// updated on every allocation; peaks and slack are published whenever the capacity
+	// changes and when the vector is destroyed.
+	template <class Tag>
+	class registered_stats : public counting_stats
+	{
+		size_t published_capacity_ = 0;
+		size_t published_slack_ = 0;
+
+		static stats_registry::entry& shared()
+		{
+			static stats_registry::entry& result = stats_registry::global().find_or_add(Tag::name);
+			return result;
+		}
+
+	public:
+		registered_stats() = default;
+
+		registered_stats(const registered_stats&) noexcept
+		{}
+
+		registered_stats& operator=(const registered_stats&) noexcept
+		{
+			return *this;
+		}
+
+		~registered_stats()
+		{
+			shared().raise_peaks(snapshot().peak_size, published_capacity_);
+			shared().add_slack(-static_cast<int64_t>(published_slack_));
+		}
+
+		void on_allocate(size_t bytes) noexcept
+		{
+			counting_stats::on_allocate(bytes);
+			shared().add_allocated(bytes);
+		}
+
+		void on_deallocate(size_t bytes) noexcept
+		{
+			counting_stats::on_deallocate(bytes);
+			shared().add_freed(bytes);
+		}
+
+		void on_relocate(size_t count) noexcept
+		{
+			counting_stats::on_relocate(count);
+			shared().add_relocation(count);
+		}
+
+		void on_usage(size_t size, size_t capacity, size_t element_size) noexcept
+		{
+			counting_stats::on_usage(size, capacity, element_size);
+			if (capacity != published_capacity_)
+			{
+				const size_t slack = (capacity - size) * element_size;
+				shared().raise_peaks(snapshot().peak_size, capacity);
+				shared().add_slack(static_cast<int64_t>(slack) - static_cast<int64_t>(published_slack_));
+				published_capacity_ = capacity;
+				published_slack_ = slack;
+			}
+		}
+	};
+}
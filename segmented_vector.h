@@ -0,0 +1,525 @@
+#pragma once
+#include "my_vector.h"
+#include "my_vector_segments.h"
+
+namespace my_vector
+{
+	// Vector whose elements never move once constructed. Storage is a list of segments that
+	// double in size; growing allocates one more segment and leaves the others alone, so
+	// pointers and references stay valid until the element is erased and the worst-case
+	// push costs one allocation instead of relocating every element. Element i is found
+	// in O(1) from the position of the highest set bit of its index.
+	template <class T, class Alloc_T = std::allocator<T>>
+	class segmented_vector
+	{
+		using layout = detail::segment_layout<4>;
+		using allocator_traits = std::allocator_traits<Alloc_T>;
+
+		// Move assignment can take over the other segments instead of moving elements one by one
+		static constexpr bool propagates_on_move_assignment =
+			allocator_traits::propagate_on_container_move_assignment::value || allocator_traits::is_always_equal::value;
+
+		Alloc_T allocator_;
+		T* segments_[layout::max_segments];
+		// segments [0, segment_count_) are allocated
+		size_t segment_count_;
+		size_t size_;
+
+	public:
+		using iterator = detail::indexed_iterator<segmented_vector, T>;
+		using constant_iterator = detail::indexed_iterator<const segmented_vector, const T>;
+
+		explicit segmented_vector(size_t size, const T& default_val, const Alloc_T& allocator = Alloc_T());
+
+		explicit segmented_vector(size_t size, const Alloc_T& allocator = Alloc_T());
+
+		segmented_vector(std::initializer_list<T> list, const Alloc_T& allocator = Alloc_T());
+
+		template <std::input_iterator It>
+		segmented_vector(It first, It last, const Alloc_T& allocator = Alloc_T());
+
+		segmented_vector()noexcept;
+
+		explicit segmented_vector(const Alloc_T& allocator)noexcept;
+
+		segmented_vector(const segmented_vector& other);
+
+		segmented_vector(segmented_vector&& other) noexcept;
+
+		~segmented_vector();
+
+		segmented_vector& operator=(segmented_vector&& other) noexcept(propagates_on_move_assignment);
+
+		segmented_vector& operator=(const segmented_vector& other);
+
+		void clear()noexcept;
+
+		void reserve(size_t new_capacity);
+
+		void resize(size_t new_size);
+
+		void resize(size_t new_size, const T& default_val);
+
+		// Frees the segments no element lives in
+		void shrink_to_fit();
+
+		void push_back(T&& value);
+
+		void push_back(const T& value);
+
+		template <typename... Ts>
+		T& emplace_back(Ts&&... args);
+
+		void pop_back();
+
+		[[nodiscard]] const Alloc_T& get_allocator()const noexcept;
+
+		[[nodiscard]] const T& at(size_t index)const;
+
+		T& at(size_t index);
+
+		const T& operator[](size_t index)const noexcept;
+
+		T& operator[](size_t index)noexcept;
+
+		[[nodiscard]] bool empty()const noexcept;
+
+		[[nodiscard]] size_t max_size()const noexcept;
+
+		[[nodiscard]] size_t size()const noexcept;
+
+		[[nodiscard]] size_t capacity()const noexcept;
+
+		T& front();
+
+		[[nodiscard]] const T& front()const;
+
+		T& back();
+
+		[[nodiscard]] const T& back()const;
+
+		void swap(segmented_vector& other) noexcept;
+
+		iterator begin();
+
+		iterator end();
+
+		[[nodiscard]] constant_iterator begin()const;
+
+		[[nodiscard]] constant_iterator end()const;
+
+		[[nodiscard]] constant_iterator cbegin()const;
+
+		[[nodiscard]] constant_iterator cend()const;
+
+	private:
+		// Allocates the next segment
+		void add_segment();
+
+		void steal(segmented_vector& other) noexcept;
+
+		// Destroys the elements and releases every segment
+		void free()noexcept;
+	};
+
+
+	template <class T, class Alloc_T>
+	segmented_vector<T, Alloc_T>::segmented_vector() noexcept : segment_count_(0), size_(0)
+	{}
+
+	template <class T, class Alloc_T>
+	segmented_vector<T, Alloc_T>::segmented_vector(const Alloc_T& allocator) noexcept
+		: allocator_(allocator), segment_count_(0), size_(0)
+	{}
+
+	template <class T, class Alloc_T>
+	segmented_vector<T, Alloc_T>::segmented_vector(size_t size, const Alloc_T& allocator) : segmented_vector(allocator)
+	{
+		resize(size);
+	}
+
+	template <class T, class Alloc_T>
+	segmented_vector<T, Alloc_T>::segmented_vector(size_t size, const T& default_val, const Alloc_T& allocator)
+		: segmented_vector(allocator)
+	{
+		resize(size, default_val);
+	}
+
+	template <class T, class Alloc_T>
+	segmented_vector<T, Alloc_T>::segmented_vector(std::initializer_list<T> list, const Alloc_T& allocator)
+		: segmented_vector(list.begin(), list.end(), allocator)
+	{}
+
+	template <class T, class Alloc_T>
+	template <std::input_iterator It>
+	segmented_vector<T, Alloc_T>::segmented_vector(It first, It last, const Alloc_T& allocator) : segmented_vector(allocator)
+	{
+		try
+		{
+			if constexpr (std::forward_iterator<It>)
+			{
+				reserve(std::distance(first, last));
+			}
+			for (; first != last; ++first)
+			{
+				emplace_back(*first);
+			}
+		}
+		catch (...)
+		{
+			free();
+			throw;
+		}
+	}
+
+	template <class T, class Alloc_T>
+	segmented_vector<T, Alloc_T>::segmented_vector(const segmented_vector& other)
+		: segmented_vector(other.begin(), other.end(), allocator_traits::select_on_container_copy_construction(other.allocator_))
+	{}
+
+	template <class T, class Alloc_T>
+	segmented_vector<T, Alloc_T>::segmented_vector(segmented_vector&& other) noexcept
+		: allocator_(std::move(other.allocator_)), segment_count_(0), size_(0)
+	{
+		steal(other);
+	}
+
+	template <class T, class Alloc_T>
+	segmented_vector<T, Alloc_T>::~segmented_vector()
+	{
+		free();
+	}
+
+	template <class T, class Alloc_T>
+	segmented_vector<T, Alloc_T>& segmented_vector<T, Alloc_T>::operator=(segmented_vector&& other) noexcept(propagates_on_move_assignment)
+	{
+		if (this == &other) return *this;
+
+		if constexpr (!propagates_on_move_assignment)
+		{
+			if (!allocators_equal(allocator_, other.allocator_))
+			{
+				// our allocator cannot free the other segments, so the elements move one by one
+				clear();
+				reserve(other.size_);
+				for (T& element : other)
+				{
+					emplace_back(std::move(element));
+				}
+				other.clear();
+				return *this;
+			}
+		}
+
+		free();
+		if constexpr (allocator_traits::propagate_on_container_move_assignment::value)
+		{
+			allocator_ = std::move(other.allocator_);
+		}
+		steal(other);
+		return *this;
+	}
+
+	template <class T, class Alloc_T>
+	segmented_vector<T, Alloc_T>& segmented_vector<T, Alloc_T>::operator=(const segmented_vector& other)
+	{
+		if (this == &other) return *this;
+
+		clear();
+		if constexpr (allocator_traits::propagate_on_container_copy_assignment::value)
+		{
+			if (!allocators_equal(allocator_, other.allocator_))
+			{
+				free();
+			}
+			allocator_ = other.allocator_;
+		}
+		reserve(other.size_);
+		for (const T& element : other)
+		{
+			emplace_back(element);
+		}
+		return *this;
+	}
+
+	template <class T, class Alloc_T>
+	void segmented_vector<T, Alloc_T>::clear() noexcept
+	{
+		size_t remaining = size_;
+		for (size_t segment = 0; remaining != 0; ++segment)
+		{
+			const size_t count = remaining < layout::segment_size(segment) ? remaining : layout::segment_size(segment);
+			std::destroy_n(segments_[segment], count);
+			remaining -= count;
+		}
+		size_ = 0;
+	}
+
+	template <class T, class Alloc_T>
+	void segmented_vector<T, Alloc_T>::reserve(size_t new_capacity)
+	{
+		while (capacity() < new_capacity)
+		{
+			add_segment();
+		}
+	}
+
+	template <class T, class Alloc_T>
+	void segmented_vector<T, Alloc_T>::resize(size_t new_size)
+	{
+		reserve(new_size);
+		while (size_ < new_size)
+		{
+			emplace_back();
+		}
+		while (size_ > new_size)
+		{
+			pop_back();
+		}
+	}
+
+	template <class T, class Alloc_T>
+	void segmented_vector<T, Alloc_T>::resize(size_t new_size, const T& default_val)
+	{
+		reserve(new_size);
+		while (size_ < new_size)
+		{
+			emplace_back(default_val);
+		}
+		while (size_ > new_size)
+		{
+			pop_back();
+		}
+	}
+
+	template <class T, class Alloc_T>
+	void segmented_vector<T, Alloc_T>::shrink_to_fit()
+	{
+		const size_t needed = size_ == 0 ? 0 : layout::locate(size_ - 1).segment + 1;
+		while (segment_count_ > needed)
+		{
+			--segment_count_;
+			allocator_traits::deallocate(allocator_, segments_[segment_count_], layout::segment_size(segment_count_));
+		}
+	}
+
+	template <class T, class Alloc_T>
+	void segmented_vector<T, Alloc_T>::push_back(T&& value)
+	{
+		emplace_back(std::move(value));
+	}
+
+	template <class T, class Alloc_T>
+	void segmented_vector<T, Alloc_T>::push_back(const T& value)
+	{
+		emplace_back(value);
+	}
+
+	template <class T, class Alloc_T>
+	template <typename ... Ts>
+	T& segmented_vector<T, Alloc_T>::emplace_back(Ts&&... args)
+	{
+		const auto [segment, offset] = layout::locate(size_);
+		if (segment == segment_count_)
+		{
+			add_segment();
+		}
+		T* slot = std::construct_at(segments_[segment] + offset, std::forward<Ts>(args)...);
+		++size_;
+		return *slot;
+	}
+
+	template <class T, class Alloc_T>
+	void segmented_vector<T, Alloc_T>::pop_back()
+	{
+		if (size_ == 0)
+		{
+			throw my_vector_exception("Vector is empty");
+		}
+		std::destroy_at(&(*this)[--size_]);
+	}
+
+	template <class T, class Alloc_T>
+	const Alloc_T& segmented_vector<T, Alloc_T>::get_allocator() const noexcept
+	{
+		return allocator_;
+	}
+
+	template <class T, class Alloc_T>
+	const T& segmented_vector<T, Alloc_T>::at(size_t index) const
+	{
+		if (index >= size_)
+		{
+			throw my_vector_exception("Index is out of range");
+		}
+		return (*this)[index];
+	}
+
+	template <class T, class Alloc_T>
+	T& segmented_vector<T, Alloc_T>::at(size_t index)
+	{
+		if (index >= size_)
+		{
+			throw my_vector_exception("Index is out of range");
+		}
+		return (*this)[index];
+	}
+
+	template <class T, class Alloc_T>
+	const T& segmented_vector<T, Alloc_T>::operator[](size_t index) const noexcept
+	{
+		const auto [segment, offset] = layout::locate(index);
+		return segments_[segment][offset];
+	}
+
+	template <class T, class Alloc_T>
+	T& segmented_vector<T, Alloc_T>::operator[](size_t index) noexcept
+	{
+		const auto [segment, offset] = layout::locate(index);
+		return segments_[segment][offset];
+	}
+
+	template <class T, class Alloc_T>
+	bool segmented_vector<T, Alloc_T>::empty() const noexcept
+	{
+		return size_ == 0;
+	}
+
+	template <class T, class Alloc_T>
+	size_t segmented_vector<T, Alloc_T>::max_size() const noexcept
+	{
+		return allocator_traits::max_size(allocator_);
+	}
+
+	template <class T, class Alloc_T>
+	size_t segmented_vector<T, Alloc_T>::size() const noexcept
+	{
+		return size_;
+	}
+
+	template <class T, class Alloc_T>
+	size_t segmented_vector<T, Alloc_T>::capacity() const noexcept
+	{
+		return layout::segment_start(segment_count_);
+	}
+
+	template <class T, class Alloc_T>
+	T& segmented_vector<T, Alloc_T>::front()
+	{
+		if (size_ == 0)
+		{
+			throw my_vector_exception("Vector is empty!");
+		}
+		return (*this)[0];
+	}
+
+	template <class T, class Alloc_T>
+	const T& segmented_vector<T, Alloc_T>::front() const
+	{
+		if (size_ == 0)
+		{
+			throw my_vector_exception("Vector is empty!");
+		}
+		return (*this)[0];
+	}
+
+	template <class T, class Alloc_T>
+	T& segmented_vector<T, Alloc_T>::back()
+	{
+		if (size_ == 0)
+		{
+			throw my_vector_exception("Vector is empty!");
+		}
+		return (*this)[size_ - 1];
+	}
+
+	template <class T, class Alloc_T>
+	const T& segmented_vector<T, Alloc_T>::back() const
+	{
+		if (size_ == 0)
+		{
+			throw my_vector_exception("Vector is empty!");
+		}
+		return (*this)[size_ - 1];
+	}
+
+	template <class T, class Alloc_T>
+	void segmented_vector<T, Alloc_T>::swap(segmented_vector& other) noexcept
+	{
+		std::swap(segments_, other.segments_);
+		std::swap(segment_count_, other.segment_count_);
+		std::swap(size_, other.size_);
+		if constexpr (allocator_traits::propagate_on_container_swap::value)
+		{
+			std::swap(allocator_, other.allocator_);
+		}
+	}
+
+	template <class T, class Alloc_T>
+	typename segmented_vector<T, Alloc_T>::iterator segmented_vector<T, Alloc_T>::begin()
+	{
+		return iterator(this, 0);
+	}
+
+	template <class T, class Alloc_T>
+	typename segmented_vector<T, Alloc_T>::iterator segmented_vector<T, Alloc_T>::end()
+	{
+		return iterator(this, size_);
+	}
+
+	template <class T, class Alloc_T>
+	typename segmented_vector<T, Alloc_T>::constant_iterator segmented_vector<T, Alloc_T>::begin() const
+	{
+		return constant_iterator(this, 0);
+	}
+
+	template <class T, class Alloc_T>
+	typename segmented_vector<T, Alloc_T>::constant_iterator segmented_vector<T, Alloc_T>::end() const
+	{
+		return constant_iterator(this, size_);
+	}
+
+	template <class T, class Alloc_T>
+	typename segmented_vector<T, Alloc_T>::constant_iterator segmented_vector<T, Alloc_T>::cbegin() const
+	{
+		return begin();
+	}
+
+	template <class T, class Alloc_T>
+	typename segmented_vector<T, Alloc_T>::constant_iterator segmented_vector<T, Alloc_T>::cend() const
+	{
+		return end();
+	}
+
+	template <class T, class Alloc_T>
+	void segmented_vector<T, Alloc_T>::add_segment()
+	{
+		if (segment_count_ == layout::max_segments)
+		{
+			throw my_vector_exception("Vector is too large");
+		}
+		segments_[segment_count_] = allocator_traits::allocate(allocator_, layout::segment_size(segment_count_));
+		++segment_count_;
+	}
+
+	template <class T, class Alloc_T>
+	void segmented_vector<T, Alloc_T>::steal(segmented_vector& other) noexcept
+	{
+		std::copy_n(other.segments_, other.segment_count_, segments_);
+		segment_count_ = other.segment_count_;
+		size_ = other.size_;
+		other.segment_count_ = 0;
+		other.size_ = 0;
+	}
+
+	template <class T, class Alloc_T>
+	void segmented_vector<T, Alloc_T>::free() noexcept
+	{
+		clear();
+		shrink_to_fit();
+	}
+
+	static_assert(std::random_access_iterator<segmented_vector<int>::iterator>);
+	static_assert(std::random_access_iterator<segmented_vector<int>::constant_iterator>);
+	static_assert(std::ranges::random_access_range<const segmented_vector<int>>);
+}
@@ -0,0 +1,791 @@
+#pragma once
+#include "my_vector.h"
+
+namespace my_vector
+{
+	// Vector with room for N elements inside the object itself. It allocates only once
+	// it grows past N elements and otherwise has the interface of my_vector::vector.
+	template <class T, size_t N, class Alloc_T = std::allocator<T>>
+	class small_vector
+	{
+		static_assert(N > 0, "small_vector needs a non-zero inline capacity");
+
+		Alloc_T allocator_;
+		T* arr_;
+		size_t size_;
+		size_t capacity_;
+		alignas(T) unsigned char buffer_[N * sizeof(T)];
+
+		using allocator_traits = std::allocator_traits<Alloc_T>;
+
+		// Move assignment never has to allocate when the other heap buffer can be taken over
+		static constexpr bool propagates_on_move_assignment =
+			allocator_traits::propagate_on_container_move_assignment::value || allocator_traits::is_always_equal::value;
+
+	public:
+		using iterator = typename vector<T, Alloc_T>::iterator;
+		using constant_iterator = typename vector<T, Alloc_T>::constant_iterator;
+
+		static constexpr size_t inline_capacity = N;
+
+		explicit small_vector(size_t size, const T& default_val, const Alloc_T& allocator = Alloc_T());
+
+		explicit small_vector(size_t size, const Alloc_T& allocator = Alloc_T());
+
+		small_vector(std::initializer_list<T> list, const Alloc_T& allocator = Alloc_T());
+
+		template <std::forward_iterator It>
+		small_vector(It first, It last, const Alloc_T& allocator = Alloc_T());
+
+		template <sized_or_forward_range<T> R>
+		small_vector(from_range_t, R&& range, const Alloc_T& allocator = Alloc_T());
+
+		small_vector()noexcept;
+
+		explicit small_vector(const Alloc_T& allocator)noexcept;
+
+		small_vector(const small_vector& other);
+
+		small_vector(small_vector&& other) noexcept(std::is_nothrow_move_constructible_v<T>);
+
+		~small_vector();
+
+		small_vector& operator=(small_vector&& other) noexcept(std::is_nothrow_move_constructible_v<T> && propagates_on_move_assignment);
+
+		small_vector& operator=(const small_vector& other);
+
+		small_vector& operator=(std::initializer_list<T> list);
+
+		void clear()noexcept;
+
+		void reserve(size_t new_capacity);
+
+		void resize(size_t new_size);
+
+		void resize(size_t new_size, const T& default_val);
+
+		void shrink_to_fit();
+
+		void push_back(T&& value);
+
+		void push_back(const T& value);
+
+		template <typename... Ts>
+		T& emplace_back(Ts&&... args);
+
+		void pop_back();
+
+		template <std::forward_iterator It>
+		iterator insert(constant_iterator pos, It first, It last);
+
+		template <std::ranges::forward_range R>
+		iterator insert_range(constant_iterator pos, R&& range);
+
+		template <sized_or_forward_range<T> R>
+		void append_range(R&& range);
+
+		template <sized_or_forward_range<T> R>
+		void assign_range(R&& range);
+
+		iterator erase(constant_iterator pos);
+
+		iterator erase(constant_iterator first, constant_iterator last);
+
+		[[nodiscard]] const Alloc_T& get_allocator()const noexcept;
+
+		[[nodiscard]] const T& at(size_t index)const;
+
+		T& at(size_t index);
+
+		const T& operator[](size_t index)const noexcept;
+
+		T& operator[](size_t index)noexcept;
+
+		[[nodiscard]] const T* data()const noexcept;
+
+		T* data()noexcept;
+
+		[[nodiscard]] bool empty()const noexcept;
+
+		[[nodiscard]] bool is_inline()const noexcept;
+
+		[[nodiscard]] size_t max_size()const noexcept;
+
+		[[nodiscard]] size_t size()const noexcept;
+
+		[[nodiscard]] size_t capacity()const noexcept;
+
+		T& front();
+
+		[[nodiscard]] const T& front()const;
+
+		T& back();
+
+		[[nodiscard]] const T& back()const;
+
+		void swap(small_vector& other) noexcept(std::is_nothrow_move_constructible_v<T> && propagates_on_move_assignment);
+
+		iterator begin();
+
+		iterator end();
+
+		[[nodiscard]] constant_iterator begin()const;
+
+		[[nodiscard]] constant_iterator end()const;
+
+		[[nodiscard]] constant_iterator cbegin()const;
+
+		[[nodiscard]] constant_iterator cend()const;
+
+
+	private:
+		[[nodiscard]] T* inline_data()noexcept;
+
+		[[nodiscard]] size_t calculate_capacity(const size_t new_size) const;
+
+		// Moves the elements into a block of at least new_capacity elements
+		void reallocate(size_t new_capacity);
+
+		void steal(small_vector& other) noexcept(std::is_nothrow_move_constructible_v<T>);
+
+		template <class It>
+		void insert_n(size_t index, size_t count, It first);
+
+		template <class R>
+		static size_t range_length(R&& range);
+
+		void free()noexcept;
+	};
+
+
+	template <class T, size_t N, class Alloc_T>
+	small_vector<T, N, Alloc_T>::small_vector() noexcept
+	{
+		arr_ = inline_data();
+		size_ = 0;
+		capacity_ = N;
+	}
+
+	template <class T, size_t N, class Alloc_T>
+	small_vector<T, N, Alloc_T>::small_vector(const Alloc_T& allocator) noexcept : allocator_(allocator)
+	{
+		arr_ = inline_data();
+		size_ = 0;
+		capacity_ = N;
+	}
+
+	template <class T, size_t N, class Alloc_T>
+	small_vector<T, N, Alloc_T>::small_vector(size_t size, const Alloc_T& allocator) : small_vector(allocator)
+	{
+		reserve(size);
+		construct_default_n(arr_, size);
+		size_ = size;
+	}
+
+	template <class T, size_t N, class Alloc_T>
+	small_vector<T, N, Alloc_T>::small_vector(size_t size, const T& default_val, const Alloc_T& allocator) : small_vector(allocator)
+	{
+		reserve(size);
+		construct_fill_n(arr_, size, default_val);
+		size_ = size;
+	}
+
+	template <class T, size_t N, class Alloc_T>
+	small_vector<T, N, Alloc_T>::small_vector(std::initializer_list<T> list, const Alloc_T& allocator) : small_vector(allocator)
+	{
+		reserve(list.size());
+		construct_copy_n(list.begin(), list.size(), arr_);
+		size_ = list.size();
+	}
+
+	template <class T, size_t N, class Alloc_T>
+	template <std::forward_iterator It>
+	small_vector<T, N, Alloc_T>::small_vector(It first, It last, const Alloc_T& allocator) : small_vector(allocator)
+	{
+		const size_t count = std::distance(first, last);
+		reserve(count);
+		construct_copy_n(first, count, arr_);
+		size_ = count;
+	}
+
+	template <class T, size_t N, class Alloc_T>
+	template <sized_or_forward_range<T> R>
+	small_vector<T, N, Alloc_T>::small_vector(from_range_t, R&& range, const Alloc_T& allocator) : small_vector(allocator)
+	{
+		append_range(std::forward<R>(range));
+	}
+
+	template <class T, size_t N, class Alloc_T>
+	small_vector<T, N, Alloc_T>::small_vector(const small_vector& other)
+		: small_vector(allocator_traits::select_on_container_copy_construction(other.allocator_))
+	{
+		reserve(other.size_);
+		construct_copy_n(other.arr_, other.size_, arr_);
+		size_ = other.size_;
+	}
+
+	template <class T, size_t N, class Alloc_T>
+	small_vector<T, N, Alloc_T>::small_vector(small_vector&& other) noexcept(std::is_nothrow_move_constructible_v<T>)
+		: allocator_(std::move(other.allocator_))
+	{
+		arr_ = inline_data();
+		size_ = 0;
+		capacity_ = N;
+		steal(other);
+	}
+
+	template <class T, size_t N, class Alloc_T>
+	small_vector<T, N, Alloc_T>::~small_vector()
+	{
+		free();
+	}
+
+	template <class T, size_t N, class Alloc_T>
+	small_vector<T, N, Alloc_T>& small_vector<T, N, Alloc_T>::operator=(small_vector&& other) noexcept(std::is_nothrow_move_constructible_v<T> && propagates_on_move_assignment)
+	{
+		if (this == &other) return *this;
+
+		if constexpr (!propagates_on_move_assignment)
+		{
+			if (!other.is_inline() && !allocators_equal(allocator_, other.allocator_))
+			{
+				// our allocator cannot free the other buffer, so the elements move one by one
+				assign_range(std::ranges::subrange(std::make_move_iterator(other.begin()), std::make_move_iterator(other.end())));
+				other.clear();
+				return *this;
+			}
+		}
+
+		free();
+		if constexpr (allocator_traits::propagate_on_container_move_assignment::value)
+		{
+			allocator_ = std::move(other.allocator_);
+		}
+		steal(other);
+		return *this;
+	}
+
+	template <class T, size_t N, class Alloc_T>
+	small_vector<T, N, Alloc_T>& small_vector<T, N, Alloc_T>::operator=(const small_vector& other)
+	{
+		if (this == &other) return *this;
+
+		if constexpr (allocator_traits::propagate_on_container_copy_assignment::value)
+		{
+			if (!allocators_equal(allocator_, other.allocator_))
+			{
+				free();
+			}
+			allocator_ = other.allocator_;
+		}
+		assign_range(other);
+		return *this;
+	}
+
+	template <class T, size_t N, class Alloc_T>
+	small_vector<T, N, Alloc_T>& small_vector<T, N, Alloc_T>::operator=(std::initializer_list<T> list)
+	{
+		assign_range(list);
+		return *this;
+	}
+
+	template <class T, size_t N, class Alloc_T>
+	void small_vector<T, N, Alloc_T>::clear() noexcept
+	{
+		std::destroy_n(arr_, size_);
+		size_ = 0;
+	}
+
+	template <class T, size_t N, class Alloc_T>
+	void small_vector<T, N, Alloc_T>::reserve(size_t new_capacity)
+	{
+		if (capacity_ >= new_capacity)
+		{
+			return;
+		}
+		reallocate(new_capacity);
+	}
+
+	template <class T, size_t N, class Alloc_T>
+	void small_vector<T, N, Alloc_T>::resize(size_t new_size)
+	{
+		reserve(new_size);
+		if (new_size > size_)
+		{
+			construct_default_n(arr_ + size_, new_size - size_);
+		}
+		else if (new_size < size_)
+		{
+			std::destroy(&arr_[new_size], &arr_[size_]);
+		}
+		size_ = new_size;
+	}
+
+	template <class T, size_t N, class Alloc_T>
+	void small_vector<T, N, Alloc_T>::resize(size_t new_size, const T& default_val)
+	{
+		reserve(new_size);
+		if (new_size > size_)
+		{
+			construct_fill_n(arr_ + size_, new_size - size_, default_val);
+		}
+		else if (new_size < size_)
+		{
+			std::destroy(&arr_[new_size], &arr_[size_]);
+		}
+		size_ = new_size;
+	}
+
+	template <class T, size_t N, class Alloc_T>
+	void small_vector<T, N, Alloc_T>::shrink_to_fit()
+	{
+		if (is_inline() || size_ == capacity_)
+		{
+			return;
+		}
+
+		if (size_ <= N)
+		{
+			// fits back into the inline buffer
+			relocate_n(arr_, size_, inline_data());
+			allocator_.deallocate(arr_, capacity_);
+			arr_ = inline_data();
+			capacity_ = N;
+			return;
+		}
+		reallocate(size_);
+	}
+
+	template <class T, size_t N, class Alloc_T>
+	void small_vector<T, N, Alloc_T>::push_back(T&& value)
+	{
+		emplace_back(std::move(value));
+	}
+
+	template <class T, size_t N, class Alloc_T>
+	void small_vector<T, N, Alloc_T>::push_back(const T& value)
+	{
+		emplace_back(value);
+	}
+
+	template <class T, size_t N, class Alloc_T>
+	template <typename ... Ts>
+	T& small_vector<T, N, Alloc_T>::emplace_back(Ts&&... args)
+	{
+		if (size_ == capacity_)
+		{
+			reserve(calculate_capacity(size_ + 1));
+		}
+
+		T* temp = &arr_[size_];
+		std::construct_at(&arr_[size_++], std::forward<Ts>(args)...);
+		return *temp;
+	}
+
+	template <class T, size_t N, class Alloc_T>
+	void small_vector<T, N, Alloc_T>::pop_back()
+	{
+		if (size_ == 0)
+		{
+			throw my_vector_exception("Vector is empty");
+		}
+		std::destroy_at(&arr_[--size_]);
+	}
+
+	template <class T, size_t N, class Alloc_T>
+	template <std::forward_iterator It>
+	typename small_vector<T, N, Alloc_T>::iterator small_vector<T, N, Alloc_T>::insert(constant_iterator pos, It first, It last)
+	{
+		const size_t index = pos - cbegin();
+		insert_n(index, std::distance(first, last), first);
+		return begin() + index;
+	}
+
+	template <class T, size_t N, class Alloc_T>
+	template <std::ranges::forward_range R>
+	typename small_vector<T, N, Alloc_T>::iterator small_vector<T, N, Alloc_T>::insert_range(constant_iterator pos, R&& range)
+	{
+		const size_t index = pos - cbegin();
+		insert_n(index, range_length(range), std::ranges::begin(range));
+		return begin() + index;
+	}
+
+	template <class T, size_t N, class Alloc_T>
+	template <sized_or_forward_range<T> R>
+	void small_vector<T, N, Alloc_T>::append_range(R&& range)
+	{
+		const size_t count = range_length(range);
+		if (size_ + count > capacity_)
+		{
+			reserve(calculate_capacity(size_ + count));
+		}
+		construct_copy_n(std::ranges::begin(range), count, arr_ + size_);
+		size_ += count;
+	}
+
+	template <class T, size_t N, class Alloc_T>
+	template <sized_or_forward_range<T> R>
+	void small_vector<T, N, Alloc_T>::assign_range(R&& range)
+	{
+		const size_t count = range_length(range);
+		clear();
+		if (count > capacity_)
+		{
+			free();
+			reallocate(count);
+		}
+		construct_copy_n(std::ranges::begin(range), count, arr_);
+		size_ = count;
+	}
+
+	template <class T, size_t N, class Alloc_T>
+	typename small_vector<T, N, Alloc_T>::iterator small_vector<T, N, Alloc_T>::erase(constant_iterator pos)
+	{
+		return erase(pos, pos + 1);
+	}
+
+	template <class T, size_t N, class Alloc_T>
+	typename small_vector<T, N, Alloc_T>::iterator small_vector<T, N, Alloc_T>::erase(constant_iterator first, constant_iterator last)
+	{
+		const size_t index = first - cbegin();
+		const size_t count = last - first;
+		if (count == 0)
+		{
+			return begin() + index;
+		}
+
+		T* gap = arr_ + index;
+		const size_t tail = size_ - index - count;
+		if constexpr (is_trivially_relocatable_v<T>)
+		{
+			std::destroy_n(gap, count);
+			relocate_overlapping_n(gap + count, tail, gap);
+		}
+		else
+		{
+			std::move(gap + count, arr_ + size_, gap);
+			std::destroy_n(gap + tail, count);
+		}
+		size_ -= count;
+		return begin() + index;
+	}
+
+	template <class T, size_t N, class Alloc_T>
+	const Alloc_T& small_vector<T, N, Alloc_T>::get_allocator() const noexcept
+	{
+		return allocator_;
+	}
+
+	template <class T, size_t N, class Alloc_T>
+	const T& small_vector<T, N, Alloc_T>::at(size_t index) const
+	{
+		if (index >= size_)
+		{
+			throw my_vector_exception("index out of range");
+		}
+		return arr_[index];
+	}
+
+	template <class T, size_t N, class Alloc_T>
+	T& small_vector<T, N, Alloc_T>::at(size_t index)
+	{
+		if (index >= size_)
+		{
+			throw my_vector_exception("index out of range");
+		}
+		return arr_[index];
+	}
+
+	template <class T, size_t N, class Alloc_T>
+	const T& small_vector<T, N, Alloc_T>::operator[](size_t index) const noexcept
+	{
+		return arr_[index];
+	}
+
+	template <class T, size_t N, class Alloc_T>
+	T& small_vector<T, N, Alloc_T>::operator[](size_t index) noexcept
+	{
+		return arr_[index];
+	}
+
+	template <class T, size_t N, class Alloc_T>
+	const T* small_vector<T, N, Alloc_T>::data() const noexcept
+	{
+		return arr_;
+	}
+
+	template <class T, size_t N, class Alloc_T>
+	T* small_vector<T, N, Alloc_T>::data() noexcept
+	{
+		return arr_;
+	}
+
+	template <class T, size_t N, class Alloc_T>
+	bool small_vector<T, N, Alloc_T>::empty() const noexcept
+	{
+		return size_ == 0;
+	}
+
+	template <class T, size_t N, class Alloc_T>
+	bool small_vector<T, N, Alloc_T>::is_inline() const noexcept
+	{
+		return arr_ == reinterpret_cast<const T*>(buffer_);
+	}
+
+	template <class T, size_t N, class Alloc_T>
+	size_t small_vector<T, N, Alloc_T>::max_size() const noexcept
+	{
+		return std::allocator_traits<Alloc_T>::max_size(allocator_);
+	}
+
+	template <class T, size_t N, class Alloc_T>
+	size_t small_vector<T, N, Alloc_T>::size() const noexcept
+	{
+		return size_;
+	}
+
+	template <class T, size_t N, class Alloc_T>
+	size_t small_vector<T, N, Alloc_T>::capacity() const noexcept
+	{
+		return capacity_;
+	}
+
+	template <class T, size_t N, class Alloc_T>
+	T& small_vector<T, N, Alloc_T>::front()
+	{
+		if (size_ == 0)
+		{
+			throw my_vector_exception("Vector is empty!");
+		}
+		return arr_[0];
+	}
+
+	template <class T, size_t N, class Alloc_T>
+	const T& small_vector<T, N, Alloc_T>::front() const
+	{
+		if (size_ == 0)
+		{
+			throw my_vector_exception("Vector is empty!");
+		}
+		return arr_[0];
+	}
+
+	template <class T, size_t N, class Alloc_T>
+	T& small_vector<T, N, Alloc_T>::back()
+	{
+		if (size_ == 0)
+		{
+			throw my_vector_exception("Vector is empty!");
+		}
+		return arr_[size_ - 1];
+	}
+
+	template <class T, size_t N, class Alloc_T>
+	const T& small_vector<T, N, Alloc_T>::back() const
+	{
+		if (size_ == 0)
+		{
+			throw my_vector_exception("Vector is empty!");
+		}
+		return arr_[size_ - 1];
+	}
+
+	template <class T, size_t N, class Alloc_T>
+	void small_vector<T, N, Alloc_T>::swap(small_vector& other) noexcept(std::is_nothrow_move_constructible_v<T> && propagates_on_move_assignment)
+	{
+		if (!is_inline() && !other.is_inline())
+		{
+			std::swap(other.arr_, arr_);
+			std::swap(other.capacity_, capacity_);
+			std::swap(other.size_, size_);
+			if constexpr (allocator_traits::propagate_on_container_swap::value)
+			{
+				std::swap(other.allocator_, allocator_);
+			}
+			return;
+		}
+
+		small_vector temp(std::move(other));
+		other = std::move(*this);
+		*this = std::move(temp);
+	}
+
+	template <class T, size_t N, class Alloc_T>
+	typename small_vector<T, N, Alloc_T>::iterator small_vector<T, N, Alloc_T>::begin()
+	{
+		return iterator(arr_);
+	}
+
+	template <class T, size_t N, class Alloc_T>
+	typename small_vector<T, N, Alloc_T>::iterator small_vector<T, N, Alloc_T>::end()
+	{
+		return iterator(arr_ + size_);
+	}
+
+	template <class T, size_t N, class Alloc_T>
+	typename small_vector<T, N, Alloc_T>::constant_iterator small_vector<T, N, Alloc_T>::begin()const
+	{
+		return constant_iterator(arr_);
+	}
+
+	template <class T, size_t N, class Alloc_T>
+	typename small_vector<T, N, Alloc_T>::constant_iterator small_vector<T, N, Alloc_T>::end()const
+	{
+		return constant_iterator(arr_ + size_);
+	}
+
+	template <class T, size_t N, class Alloc_T>
+	typename small_vector<T, N, Alloc_T>::constant_iterator small_vector<T, N, Alloc_T>::cbegin()const
+	{
+		return constant_iterator(arr_);
+	}
+
+	template <class T, size_t N, class Alloc_T>
+	typename small_vector<T, N, Alloc_T>::constant_iterator small_vector<T, N, Alloc_T>::cend()const
+	{
+		return constant_iterator(arr_ + size_);
+	}
+
+	template <class T, size_t N, class Alloc_T>
+	T* small_vector<T, N, Alloc_T>::inline_data() noexcept
+	{
+		return reinterpret_cast<T*>(buffer_);
+	}
+
+	template <class T, size_t N, class Alloc_T>
+	size_t small_vector<T, N, Alloc_T>::calculate_capacity(const size_t new_size) const
+	{
+		return default_growth::grow(capacity_, new_size, max_size(), sizeof(T));
+	}
+
+	template <class T, size_t N, class Alloc_T>
+	void small_vector<T, N, Alloc_T>::reallocate(size_t new_capacity)
+	{
+		const auto [new_arr, allocated] = allocate_at_least<T>(allocator_, new_capacity);
+		relocate_n(arr_, size_, new_arr);
+		if (!is_inline())
+		{
+			allocator_.deallocate(arr_, capacity_);
+		}
+		arr_ = new_arr;
+		capacity_ = allocated;
+	}
+
+	template <class T, size_t N, class Alloc_T>
+	void small_vector<T, N, Alloc_T>::steal(small_vector& other) noexcept(std::is_nothrow_move_constructible_v<T>)
+	{
+		if (other.is_inline())
+		{
+			relocate_n(other.arr_, other.size_, inline_data());
+			arr_ = inline_data();
+			capacity_ = N;
+		}
+		else
+		{
+			arr_ = other.arr_;
+			capacity_ = other.capacity_;
+			other.arr_ = other.inline_data();
+			other.capacity_ = N;
+		}
+		size_ = other.size_;
+		other.size_ = 0;
+	}
+
+	template <class T, size_t N, class Alloc_T>
+	template <class It>
+	void small_vector<T, N, Alloc_T>::insert_n(size_t index, size_t count, It first)
+	{
+		if (count == 0)
+		{
+			return;
+		}
+
+		T* position = arr_ + index;
+		const size_t tail = size_ - index;
+		if (size_ + count > capacity_)
+		{
+			// build the inserted elements first so a throwing copy leaves *this untouched
+			const auto [new_arr, new_capacity] = allocate_at_least<T>(allocator_, calculate_capacity(size_ + count));
+			try
+			{
+				construct_copy_n(first, count, new_arr + index);
+			}
+			catch (...)
+			{
+				allocator_.deallocate(new_arr, new_capacity);
+				throw;
+			}
+			relocate_n(arr_, index, new_arr);
+			relocate_n(position, tail, new_arr + index + count);
+			if (!is_inline())
+			{
+				allocator_.deallocate(arr_, capacity_);
+			}
+			arr_ = new_arr;
+			capacity_ = new_capacity;
+		}
+		else if constexpr (is_trivially_relocatable_v<T>)
+		{
+			relocate_overlapping_n(position, tail, position + count);
+			try
+			{
+				construct_copy_n(first, count, position);
+			}
+			catch (...)
+			{
+				relocate_overlapping_n(position + count, tail, position);
+				throw;
+			}
+		}
+		else
+		{
+			T* old_end = arr_ + size_;
+			if (tail > count)
+			{
+				std::uninitialized_move(old_end - count, old_end, old_end);
+				size_ += count;
+				std::move_backward(position, old_end - count, old_end);
+				std::copy_n(first, count, position);
+				return;
+			}
+
+			It mid = std::next(first, tail);
+			construct_copy_n(mid, count - tail, old_end);
+			size_ += count - tail;
+			std::uninitialized_move(position, old_end, position + count);
+			size_ += tail;
+			std::copy_n(first, tail, position);
+			return;
+		}
+		size_ += count;
+	}
+
+	template <class T, size_t N, class Alloc_T>
+	template <class R>
+	size_t small_vector<T, N, Alloc_T>::range_length(R&& range)
+	{
+		if constexpr (std::ranges::sized_range<R>)
+		{
+			return std::ranges::size(range);
+		}
+		else
+		{
+			return std::ranges::distance(range);
+		}
+	}
+
+	template <class T, size_t N, class Alloc_T>
+	void small_vector<T, N, Alloc_T>::free() noexcept
+	{
+		std::destroy_n(arr_, size_);
+		if (!is_inline())
+		{
+			allocator_.deallocate(arr_, capacity_);
+		}
+		arr_ = inline_data();
+		size_ = 0;
+		capacity_ = N;
+	}
+
+	static_assert(std::ranges::contiguous_range<small_vector<int, 4>>);
+}
@@ -0,0 +1,559 @@
+#pragma once
+#include "my_vector_exception.h"
+#include "my_vector_fill.h"
+#include "my_vector_growth.h"
+#include "my_vector_relocation.h"
+#include "my_vector_segments.h"
+#include <array>
+#include <cstddef>
+#include <memory>
+#include <span>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+namespace my_vector
+{
+	// Structure-of-arrays vector: row i of a basic_soa_vector<Alloc_T, A, B, C> is spread over
+	// three contiguous columns of A, B and C that share one size and capacity, so a pass that
+	// reads one field streams through only that field's bytes. All columns live in a single
+	// block from Alloc_T (an allocator of std::byte), each starting on a cache line.
+	//
+	// Rows are accessed through proxy references, std::tuple<A&, B&, C&>, so row-wise code like
+	// `for (auto [a, b, c] : soa)` works; column<I>() gives a span over one field. Iterators
+	// meet the classic random access requirements, so std:: algorithms taking iterator pairs
+	// work, but not the std::ranges ones: tuple references only model the C++20 iterator
+	// concepts from C++23 on. As with vector, arguments to emplace_back must not refer into
+	// the container itself.
+	template <class Alloc_T, class... Ts>
+	class basic_soa_vector
+	{
+		static_assert(sizeof...(Ts) > 0, "soa_vector needs at least one column");
+
+		static constexpr size_t column_count = sizeof...(Ts);
+		static constexpr size_t column_alignment = 64;
+		static_assert(((alignof(Ts) <= column_alignment) && ...), "column types may be aligned to at most a cache line");
+
+		struct alignas(column_alignment) line
+		{
+			std::byte bytes[column_alignment];
+		};
+
+		using line_allocator = typename std::allocator_traits<Alloc_T>::template rebind_alloc<line>;
+		using line_traits = std::allocator_traits<line_allocator>;
+		using columns_type = std::tuple<Ts*...>;
+		// byte offset of every column in a block, and the block size last
+		using offsets_type = std::array<size_t, column_count + 1>;
+
+		line_allocator allocator_;
+		line* block_;
+		size_t lines_;
+		columns_type columns_;
+		size_t size_;
+		size_t capacity_;
+
+	public:
+		using value_type = std::tuple<Ts...>;
+		using reference = std::tuple<Ts&...>;
+		using const_reference = std::tuple<const Ts&...>;
+		using iterator = detail::indexed_iterator<basic_soa_vector, value_type, reference>;
+		using constant_iterator = detail::indexed_iterator<const basic_soa_vector, const value_type, const_reference>;
+
+		template <size_t I>
+		using column_type = std::tuple_element_t<I, value_type>;
+
+		basic_soa_vector()noexcept;
+
+		explicit basic_soa_vector(const Alloc_T& allocator)noexcept;
+
+		basic_soa_vector(const basic_soa_vector& other);
+
+		basic_soa_vector(basic_soa_vector&& other)noexcept;
+
+		~basic_soa_vector();
+
+		basic_soa_vector& operator=(const basic_soa_vector& other);
+
+		basic_soa_vector& operator=(basic_soa_vector&& other)noexcept;
+
+		void clear()noexcept;
+
+		// Moves every column into one new block holding new_capacity rows
+		void reserve(size_t new_capacity);
+
+		// New rows have every field value-initialized
+		void resize(size_t new_size);
+
+		void shrink_to_fit();
+
+		// Appends a row built from one argument per column
+		template <typename... Us>
+			requires (sizeof...(Us) == sizeof...(Ts))
+		reference emplace_back(Us&&... fields);
+
+		void push_back(const value_type& row);
+
+		void pop_back();
+
+		[[nodiscard]] const_reference at(size_t index)const;
+
+		reference at(size_t index);
+
+		const_reference operator[](size_t index)const noexcept;
+
+		reference operator[](size_t index)noexcept;
+
+		// Field I of every row
+		template <size_t I>
+		std::span<column_type<I>> column()noexcept;
+
+		template <size_t I>
+		[[nodiscard]] std::span<const column_type<I>> column()const noexcept;
+
+		[[nodiscard]] bool empty()const noexcept;
+
+		[[nodiscard]] size_t max_size()const noexcept;
+
+		[[nodiscard]] size_t size()const noexcept;
+
+		[[nodiscard]] size_t capacity()const noexcept;
+
+		void swap(basic_soa_vector& other)noexcept;
+
+		iterator begin();
+
+		iterator end();
+
+		[[nodiscard]] constant_iterator begin()const;
+
+		[[nodiscard]] constant_iterator end()const;
+
+		[[nodiscard]] constant_iterator cbegin()const;
+
+		[[nodiscard]] constant_iterator cend()const;
+
+	private:
+		static offsets_type layout(size_t capacity) noexcept;
+
+		template <size_t... I>
+		static columns_type columns_at(line* block, const offsets_type& offsets, std::index_sequence<I...>) noexcept;
+
+		// Calls visit(column pointer) for every column in order
+		template <class F>
+		void for_each_column(F&& visit);
+
+		// Switches to a new block of new_capacity rows, relocating the current rows into it
+		void reallocate(size_t new_capacity);
+
+		template <class Args, size_t... I>
+		void construct_row(size_t row, Args&& args, std::index_sequence<I...>);
+
+		template <size_t... I>
+		void destroy_fields(size_t row, size_t count, std::index_sequence<I...>) noexcept;
+
+		void destroy_rows(size_t first, size_t last) noexcept;
+
+		void free() noexcept;
+	};
+
+	template <class... Ts>
+	using soa_vector = basic_soa_vector<std::allocator<std::byte>, Ts...>;
+
+
+	template <class Alloc_T, class... Ts>
+	basic_soa_vector<Alloc_T, Ts...>::basic_soa_vector() noexcept : basic_soa_vector(Alloc_T())
+	{}
+
+	template <class Alloc_T, class... Ts>
+	basic_soa_vector<Alloc_T, Ts...>::basic_soa_vector(const Alloc_T& allocator) noexcept
+		: allocator_(allocator), block_(nullptr), lines_(0), columns_(), size_(0), capacity_(0)
+	{}
+
+	template <class Alloc_T, class... Ts>
+	basic_soa_vector<Alloc_T, Ts...>::basic_soa_vector(const basic_soa_vector& other)
+		: basic_soa_vector(Alloc_T(line_traits::select_on_container_copy_construction(other.allocator_)))
+	{
+		reserve(other.size_);
+		// column by column; if a copy throws, the columns already copied are destroyed
+		size_t copied = 0;
+		try
+		{
+			std::apply([&](const Ts*... sources)
+			{
+				std::apply([&](Ts*... dests)
+				{
+					((construct_copy_n(sources, other.size_, dests), ++copied), ...);
+				}, columns_);
+			}, other.columns_);
+		}
+		catch (...)
+		{
+			size_t column = 0;
+			for_each_column([&](auto* dest)
+			{
+				if (column++ < copied)
+				{
+					std::destroy_n(dest, other.size_);
+				}
+			});
+			free();
+			throw;
+		}
+		size_ = other.size_;
+	}
+
+	template <class Alloc_T, class... Ts>
+	basic_soa_vector<Alloc_T, Ts...>::basic_soa_vector(basic_soa_vector&& other) noexcept
+		: allocator_(std::move(other.allocator_)), block_(std::exchange(other.block_, nullptr)),
+		lines_(std::exchange(other.lines_, 0)), columns_(std::exchange(other.columns_, columns_type())),
+		size_(std::exchange(other.size_, 0)), capacity_(std::exchange(other.capacity_, 0))
+	{}
+
+	template <class Alloc_T, class... Ts>
+	basic_soa_vector<Alloc_T, Ts...>::~basic_soa_vector()
+	{
+		free();
+	}
+
+	template <class Alloc_T, class... Ts>
+	basic_soa_vector<Alloc_T, Ts...>& basic_soa_vector<Alloc_T, Ts...>::operator=(const basic_soa_vector& other)
+	{
+		if (this != &other)
+		{
+			basic_soa_vector copy(other);
+			swap(copy);
+		}
+		return *this;
+	}
+
+	template <class Alloc_T, class... Ts>
+	basic_soa_vector<Alloc_T, Ts...>& basic_soa_vector<Alloc_T, Ts...>::operator=(basic_soa_vector&& other) noexcept
+	{
+		if (this != &other)
+		{
+			basic_soa_vector moved(std::move(other));
+			swap(moved);
+		}
+		return *this;
+	}
+
+	template <class Alloc_T, class... Ts>
+	void basic_soa_vector<Alloc_T, Ts...>::clear() noexcept
+	{
+		destroy_rows(0, size_);
+		size_ = 0;
+	}
+
+	template <class Alloc_T, class... Ts>
+	void basic_soa_vector<Alloc_T, Ts...>::reserve(size_t new_capacity)
+	{
+		if (new_capacity > max_size())
+		{
+			throw my_vector_exception("Capacity is too large");
+		}
+		if (new_capacity > capacity_)
+		{
+			reallocate(new_capacity);
+		}
+	}
+
+	template <class Alloc_T, class... Ts>
+	void basic_soa_vector<Alloc_T, Ts...>::resize(size_t new_size)
+	{
+		if (new_size <= size_)
+		{
+			destroy_rows(new_size, size_);
+			size_ = new_size;
+			return;
+		}
+		reserve(new_size);
+		while (size_ < new_size)
+		{
+			// one empty argument list per column value-initializes every field
+			construct_row(size_, std::array<std::tuple<>, column_count>(), std::index_sequence_for<Ts...>());
+			++size_;
+		}
+	}
+
+	template <class Alloc_T, class... Ts>
+	void basic_soa_vector<Alloc_T, Ts...>::shrink_to_fit()
+	{
+		if (size_ == 0)
+		{
+			free();
+		}
+		else if (size_ < capacity_)
+		{
+			reallocate(size_);
+		}
+	}
+
+	template <class Alloc_T, class... Ts>
+	template <typename... Us>
+		requires (sizeof...(Us) == sizeof...(Ts))
+	typename basic_soa_vector<Alloc_T, Ts...>::reference basic_soa_vector<Alloc_T, Ts...>::emplace_back(Us&&... fields)
+	{
+		if (size_ == capacity_)
+		{
+			constexpr size_t row_bytes = (sizeof(Ts) + ...);
+			reallocate(default_growth::grow(capacity_, size_ + 1, max_size(), row_bytes));
+		}
+		construct_row(size_, std::forward_as_tuple(std::forward_as_tuple(std::forward<Us>(fields))...), std::index_sequence_for<Ts...>());
+		++size_;
+		return (*this)[size_ - 1];
+	}
+
+	template <class Alloc_T, class... Ts>
+	void basic_soa_vector<Alloc_T, Ts...>::push_back(const value_type& row)
+	{
+		std::apply([this](const Ts&... fields)
+		{
+			emplace_back(fields...);
+		}, row);
+	}
+
+	template <class Alloc_T, class... Ts>
+	void basic_soa_vector<Alloc_T, Ts...>::pop_back()
+	{
+		if (size_ == 0)
+		{
+			throw my_vector_exception("Vector is empty");
+		}
+		destroy_rows(size_ - 1, size_);
+		--size_;
+	}
+
+	template <class Alloc_T, class... Ts>
+	typename basic_soa_vector<Alloc_T, Ts...>::const_reference basic_soa_vector<Alloc_T, Ts...>::at(size_t index) const
+	{
+		if (index >= size_)
+		{
+			throw my_vector_exception("index out of range");
+		}
+		return (*this)[index];
+	}
+
+	template <class Alloc_T, class... Ts>
+	typename basic_soa_vector<Alloc_T, Ts...>::reference basic_soa_vector<Alloc_T, Ts...>::at(size_t index)
+	{
+		if (index >= size_)
+		{
+			throw my_vector_exception("index out of range");
+		}
+		return (*this)[index];
+	}
+
+	template <class Alloc_T, class... Ts>
+	typename basic_soa_vector<Alloc_T, Ts...>::const_reference basic_soa_vector<Alloc_T, Ts...>::operator[](size_t index) const noexcept
+	{
+		return std::apply([index](const Ts*... columns)
+		{
+			return const_reference(columns[index]...);
+		}, columns_);
+	}
+
+	template <class Alloc_T, class... Ts>
+	typename basic_soa_vector<Alloc_T, Ts...>::reference basic_soa_vector<Alloc_T, Ts...>::operator[](size_t index) noexcept
+	{
+		return std::apply([index](Ts*... columns)
+		{
+			return reference(columns[index]...);
+		}, columns_);
+	}
+
+	template <class Alloc_T, class... Ts>
+	template <size_t I>
+	std::span<typename basic_soa_vector<Alloc_T, Ts...>::template column_type<I>> basic_soa_vector<Alloc_T, Ts...>::column() noexcept
+	{
+		return { std::get<I>(columns_), size_ };
+	}
+
+	template <class Alloc_T, class... Ts>
+	template <size_t I>
+	std::span<const typename basic_soa_vector<Alloc_T, Ts...>::template column_type<I>> basic_soa_vector<Alloc_T, Ts...>::column() const noexcept
+	{
+		return { std::get<I>(columns_), size_ };
+	}
+
+	template <class Alloc_T, class... Ts>
+	bool basic_soa_vector<Alloc_T, Ts...>::empty() const noexcept
+	{
+		return size_ == 0;
+	}
+
+	template <class Alloc_T, class... Ts>
+	size_t basic_soa_vector<Alloc_T, Ts...>::max_size() const noexcept
+	{
+		// every column may need up to a line of padding
+		const size_t max_lines = line_traits::max_size(allocator_) - column_count;
+		return max_lines / (sizeof(Ts) + ...) * column_alignment;
+	}
+
+	template <class Alloc_T, class... Ts>
+	size_t basic_soa_vector<Alloc_T, Ts...>::size() const noexcept
+	{
+		return size_;
+	}
+
+	template <class Alloc_T, class... Ts>
+	size_t basic_soa_vector<Alloc_T, Ts...>::capacity() const noexcept
+	{
+		return capacity_;
+	}
+
+	template <class Alloc_T, class... Ts>
+	void basic_soa_vector<Alloc_T, Ts...>::swap(basic_soa_vector& other) noexcept
+	{
+		std::swap(allocator_, other.allocator_);
+		std::swap(block_, other.block_);
+		std::swap(lines_, other.lines_);
+		std::swap(columns_, other.columns_);
+		std::swap(size_, other.size_);
+		std::swap(capacity_, other.capacity_);
+	}
+
+	template <class Alloc_T, class... Ts>
+	typename basic_soa_vector<Alloc_T, Ts...>::iterator basic_soa_vector<Alloc_T, Ts...>::begin()
+	{
+		return iterator(this, 0);
+	}
+
+	template <class Alloc_T, class... Ts>
+	typename basic_soa_vector<Alloc_T, Ts...>::iterator basic_soa_vector<Alloc_T, Ts...>::end()
+	{
+		return iterator(this, size_);
+	}
+
+	template <class Alloc_T, class... Ts>
+	typename basic_soa_vector<Alloc_T, Ts...>::constant_iterator basic_soa_vector<Alloc_T, Ts...>::begin() const
+	{
+		return constant_iterator(this, 0);
+	}
+
+	template <class Alloc_T, class... Ts>
+	typename basic_soa_vector<Alloc_T, Ts...>::constant_iterator basic_soa_vector<Alloc_T, Ts...>::end() const
+	{
+		return constant_iterator(this, size_);
+	}
+
+	template <class Alloc_T, class... Ts>
+	typename basic_soa_vector<Alloc_T, Ts...>::constant_iterator basic_soa_vector<Alloc_T, Ts...>::cbegin() const
+	{
+		return begin();
+	}
+
+	template <class Alloc_T, class... Ts>
+	typename basic_soa_vector<Alloc_T, Ts...>::constant_iterator basic_soa_vector<Alloc_T, Ts...>::cend() const
+	{
+		return end();
+	}
+
+	template <class Alloc_T, class... Ts>
+	typename basic_soa_vector<Alloc_T, Ts...>::offsets_type basic_soa_vector<Alloc_T, Ts...>::layout(size_t capacity) noexcept
+	{
+		constexpr size_t sizes[] = { sizeof(Ts)... };
+		offsets_type offsets{};
+		for (size_t i = 0; i < column_count; ++i)
+		{
+			const size_t end = offsets[i] + capacity * sizes[i];
+			offsets[i + 1] = (end + column_alignment - 1) / column_alignment * column_alignment;
+		}
+		return offsets;
+	}
+
+	template <class Alloc_T, class... Ts>
+	template <size_t... I>
+	typename basic_soa_vector<Alloc_T, Ts...>::columns_type basic_soa_vector<Alloc_T, Ts...>::columns_at(
+		line* block, const offsets_type& offsets, std::index_sequence<I...>) noexcept
+	{
+		auto* bytes = reinterpret_cast<std::byte*>(block);
+		return columns_type(reinterpret_cast<Ts*>(bytes + offsets[I])...);
+	}
+
+	template <class Alloc_T, class... Ts>
+	template <class F>
+	void basic_soa_vector<Alloc_T, Ts...>::for_each_column(F&& visit)
+	{
+		std::apply([&visit](Ts*... columns)
+		{
+			(visit(columns), ...);
+		}, columns_);
+	}
+
+	template <class Alloc_T, class... Ts>
+	void basic_soa_vector<Alloc_T, Ts...>::reallocate(size_t new_capacity)
+	{
+		const offsets_type offsets = layout(new_capacity);
+		const size_t lines = offsets[column_count] / column_alignment;
+		line* block = line_traits::allocate(allocator_, lines);
+		const columns_type fresh = columns_at(block, offsets, std::index_sequence_for<Ts...>());
+
+		std::apply([&](Ts*... sources)
+		{
+			std::apply([&](Ts*... dests)
+			{
+				(relocate_n(sources, size_, dests), ...);
+			}, fresh);
+		}, columns_);
+
+		if (block_ != nullptr)
+		{
+			line_traits::deallocate(allocator_, block_, lines_);
+		}
+		block_ = block;
+		lines_ = lines;
+		columns_ = fresh;
+		capacity_ = new_capacity;
+	}
+
+	template <class Alloc_T, class... Ts>
+	template <class Args, size_t... I>
+	void basic_soa_vector<Alloc_T, Ts...>::construct_row(size_t row, Args&& args, std::index_sequence<I...>)
+	{
+		// args holds one tuple of constructor arguments per column
+		size_t built = 0;
+		try
+		{
+			((std::apply([&](auto&&... field_args)
+			{
+				std::construct_at(std::get<I>(columns_) + row, std::forward<decltype(field_args)>(field_args)...);
+			}, std::get<I>(std::forward<Args>(args))), ++built), ...);
+		}
+		catch (...)
+		{
+			destroy_fields(row, built, std::index_sequence<I...>());
+			throw;
+		}
+	}
+
+	template <class Alloc_T, class... Ts>
+	template <size_t... I>
+	void basic_soa_vector<Alloc_T, Ts...>::destroy_fields(size_t row, size_t count, std::index_sequence<I...>) noexcept
+	{
+		((I < count ? std::destroy_at(std::get<I>(columns_) + row) : void()), ...);
+	}
+
+	template <class Alloc_T, class... Ts>
+	void basic_soa_vector<Alloc_T, Ts...>::destroy_rows(size_t first, size_t last) noexcept
+	{
+		for_each_column([first, last](auto* column)
+		{
+			std::destroy(column + first, column + last);
+		});
+	}
+
+	template <class Alloc_T, class... Ts>
+	void basic_soa_vector<Alloc_T, Ts...>::free() noexcept
+	{
+		destroy_rows(0, size_);
+		if (block_ != nullptr)
+		{
+			line_traits::deallocate(allocator_, block_, lines_);
+		}
+		block_ = nullptr;
+		lines_ = 0;
+		columns_ = columns_type();
+		size_ = 0;
+		capacity_ = 0;
+	}
+}
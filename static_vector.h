@@ -0,0 +1,622 @@
+#pragma once
+#include "my_vector.h"
+
+namespace my_vector
+{
+	// Vector with a fixed capacity of N elements stored inside the object. It never allocates:
+	// growing past N throws, or fails softly through the try_ functions. With a trivially
+	// copyable T the whole object is trivially copyable, so it can be memcpy'd, e.g. into
+	// shared memory.
+	template <class T, size_t N>
+	class static_vector
+	{
+		alignas(T) unsigned char buffer_[N == 0 ? 1 : N * sizeof(T)];
+		size_t size_;
+
+		// Copying the object bytes copies the elements too
+		static constexpr bool trivial_copy = std::is_trivially_copyable_v<T>;
+
+	public:
+		using iterator = typename vector<T>::iterator;
+		using constant_iterator = typename vector<T>::constant_iterator;
+
+		explicit static_vector(size_t size, const T& default_val);
+
+		explicit static_vector(size_t size);
+
+		static_vector(std::initializer_list<T> list);
+
+		template <std::forward_iterator It>
+		static_vector(It first, It last);
+
+		template <sized_or_forward_range<T> R>
+		static_vector(from_range_t, R&& range);
+
+		static_vector()noexcept;
+
+		static_vector(const static_vector& other) requires trivial_copy = default;
+
+		static_vector(const static_vector& other);
+
+		static_vector(static_vector&& other) noexcept requires trivial_copy = default;
+
+		static_vector(static_vector&& other) noexcept(std::is_nothrow_move_constructible_v<T>);
+
+		~static_vector() requires std::is_trivially_destructible_v<T> = default;
+
+		~static_vector();
+
+		static_vector& operator=(const static_vector& other) requires trivial_copy = default;
+
+		static_vector& operator=(const static_vector& other);
+
+		static_vector& operator=(static_vector&& other) noexcept requires trivial_copy = default;
+
+		static_vector& operator=(static_vector&& other) noexcept(std::is_nothrow_move_constructible_v<T> && std::is_nothrow_move_assignable_v<T>);
+
+		static_vector& operator=(std::initializer_list<T> list);
+
+		void clear()noexcept;
+
+		// Throws if new_capacity exceeds N; there is nothing else to do
+		void reserve(size_t new_capacity);
+
+		void resize(size_t new_size);
+
+		void resize(size_t new_size, const T& default_val);
+
+		void push_back(T&& value);
+
+		void push_back(const T& value);
+
+		template <typename... Ts>
+		T& emplace_back(Ts&&... args);
+
+		// Append unless the vector is full: return the new element, or nullptr when full
+		template <typename... Ts>
+		T* try_emplace_back(Ts&&... args);
+
+		T* try_push_back(T&& value);
+
+		T* try_push_back(const T& value);
+
+		void pop_back();
+
+		template <std::forward_iterator It>
+		iterator insert(constant_iterator pos, It first, It last);
+
+		template <sized_or_forward_range<T> R>
+		void append_range(R&& range);
+
+		template <sized_or_forward_range<T> R>
+		void assign_range(R&& range);
+
+		iterator erase(constant_iterator pos);
+
+		iterator erase(constant_iterator first, constant_iterator last);
+
+		[[nodiscard]] const T& at(size_t index)const;
+
+		T& at(size_t index);
+
+		const T& operator[](size_t index)const noexcept;
+
+		T& operator[](size_t index)noexcept;
+
+		[[nodiscard]] const T* data()const noexcept;
+
+		T* data()noexcept;
+
+		[[nodiscard]] bool empty()const noexcept;
+
+		[[nodiscard]] bool full()const noexcept;
+
+		[[nodiscard]] static constexpr size_t max_size()noexcept;
+
+		[[nodiscard]] size_t size()const noexcept;
+
+		[[nodiscard]] static constexpr size_t capacity()noexcept;
+
+		T& front();
+
+		[[nodiscard]] const T& front()const;
+
+		T& back();
+
+		[[nodiscard]] const T& back()const;
+
+		void swap(static_vector& other) noexcept(std::is_nothrow_move_constructible_v<T> && std::is_nothrow_swappable_v<T>);
+
+		iterator begin();
+
+		iterator end();
+
+		[[nodiscard]] constant_iterator begin()const;
+
+		[[nodiscard]] constant_iterator end()const;
+
+		[[nodiscard]] constant_iterator cbegin()const;
+
+		[[nodiscard]] constant_iterator cend()const;
+
+	private:
+		// Throws unless count more elements fit
+		void check_room(size_t count) const;
+
+		template <class It>
+		void assign_n(size_t count, It first);
+	};
+
+
+	template <class T, size_t N>
+	static_vector<T, N>::static_vector() noexcept : size_(0)
+	{}
+
+	template <class T, size_t N>
+	static_vector<T, N>::static_vector(size_t size) : static_vector()
+	{
+		check_room(size);
+		construct_default_n(data(), size);
+		size_ = size;
+	}
+
+	template <class T, size_t N>
+	static_vector<T, N>::static_vector(size_t size, const T& default_val) : static_vector()
+	{
+		check_room(size);
+		construct_fill_n(data(), size, default_val);
+		size_ = size;
+	}
+
+	template <class T, size_t N>
+	static_vector<T, N>::static_vector(std::initializer_list<T> list) : static_vector()
+	{
+		assign_n(list.size(), list.begin());
+	}
+
+	template <class T, size_t N>
+	template <std::forward_iterator It>
+	static_vector<T, N>::static_vector(It first, It last) : static_vector()
+	{
+		assign_n(std::distance(first, last), first);
+	}
+
+	template <class T, size_t N>
+	template <sized_or_forward_range<T> R>
+	static_vector<T, N>::static_vector(from_range_t, R&& range) : static_vector()
+	{
+		append_range(std::forward<R>(range));
+	}
+
+	template <class T, size_t N>
+	static_vector<T, N>::static_vector(const static_vector& other) : static_vector()
+	{
+		construct_copy_n(other.data(), other.size_, data());
+		size_ = other.size_;
+	}
+
+	template <class T, size_t N>
+	static_vector<T, N>::static_vector(static_vector&& other) noexcept(std::is_nothrow_move_constructible_v<T>) : static_vector()
+	{
+		construct_copy_n(std::make_move_iterator(other.data()), other.size_, data());
+		size_ = other.size_;
+	}
+
+	template <class T, size_t N>
+	static_vector<T, N>::~static_vector()
+	{
+		std::destroy_n(data(), size_);
+	}
+
+	template <class T, size_t N>
+	static_vector<T, N>& static_vector<T, N>::operator=(const static_vector& other)
+	{
+		if (this != &other)
+		{
+			assign_n(other.size_, other.data());
+		}
+		return *this;
+	}
+
+	template <class T, size_t N>
+	static_vector<T, N>& static_vector<T, N>::operator=(static_vector&& other) noexcept(std::is_nothrow_move_constructible_v<T> && std::is_nothrow_move_assignable_v<T>)
+	{
+		if (this != &other)
+		{
+			assign_n(other.size_, std::make_move_iterator(other.data()));
+		}
+		return *this;
+	}
+
+	template <class T, size_t N>
+	static_vector<T, N>& static_vector<T, N>::operator=(std::initializer_list<T> list)
+	{
+		assign_n(list.size(), list.begin());
+		return *this;
+	}
+
+	template <class T, size_t N>
+	void static_vector<T, N>::clear() noexcept
+	{
+		std::destroy_n(data(), size_);
+		size_ = 0;
+	}
+
+	template <class T, size_t N>
+	void static_vector<T, N>::reserve(size_t new_capacity)
+	{
+		if (new_capacity > N)
+		{
+			throw my_vector_exception("static_vector capacity exceeded");
+		}
+	}
+
+	template <class T, size_t N>
+	void static_vector<T, N>::resize(size_t new_size)
+	{
+		reserve(new_size);
+		if (new_size > size_)
+		{
+			construct_default_n(data() + size_, new_size - size_);
+		}
+		else
+		{
+			std::destroy(data() + new_size, data() + size_);
+		}
+		size_ = new_size;
+	}
+
+	template <class T, size_t N>
+	void static_vector<T, N>::resize(size_t new_size, const T& default_val)
+	{
+		reserve(new_size);
+		if (new_size > size_)
+		{
+			construct_fill_n(data() + size_, new_size - size_, default_val);
+		}
+		else
+		{
+			std::destroy(data() + new_size, data() + size_);
+		}
+		size_ = new_size;
+	}
+
+	template <class T, size_t N>
+	void static_vector<T, N>::push_back(T&& value)
+	{
+		emplace_back(std::move(value));
+	}
+
+	template <class T, size_t N>
+	void static_vector<T, N>::push_back(const T& value)
+	{
+		emplace_back(value);
+	}
+
+	template <class T, size_t N>
+	template <typename... Ts>
+	T& static_vector<T, N>::emplace_back(Ts&&... args)
+	{
+		check_room(1);
+		T* element = std::construct_at(data() + size_, std::forward<Ts>(args)...);
+		++size_;
+		return *element;
+	}
+
+	template <class T, size_t N>
+	template <typename... Ts>
+	T* static_vector<T, N>::try_emplace_back(Ts&&... args)
+	{
+		if (size_ == N)
+		{
+			return nullptr;
+		}
+		T* element = std::construct_at(data() + size_, std::forward<Ts>(args)...);
+		++size_;
+		return element;
+	}
+
+	template <class T, size_t N>
+	T* static_vector<T, N>::try_push_back(T&& value)
+	{
+		return try_emplace_back(std::move(value));
+	}
+
+	template <class T, size_t N>
+	T* static_vector<T, N>::try_push_back(const T& value)
+	{
+		return try_emplace_back(value);
+	}
+
+	template <class T, size_t N>
+	void static_vector<T, N>::pop_back()
+	{
+		if (size_ == 0)
+		{
+			throw my_vector_exception("Vector is empty");
+		}
+		std::destroy_at(data() + --size_);
+	}
+
+	template <class T, size_t N>
+	template <std::forward_iterator It>
+	typename static_vector<T, N>::iterator static_vector<T, N>::insert(constant_iterator pos, It first, It last)
+	{
+		const size_t index = pos - cbegin();
+		const size_t count = std::distance(first, last);
+		check_room(count);
+		if constexpr (is_trivially_relocatable_v<T>)
+		{
+			T* position = data() + index;
+			const size_t tail = size_ - index;
+			relocate_overlapping_n(position, tail, position + count);
+			try
+			{
+				construct_copy_n(first, count, position);
+			}
+			catch (...)
+			{
+				relocate_overlapping_n(position + count, tail, position);
+				throw;
+			}
+			size_ += count;
+		}
+		else
+		{
+			// append, then rotate the new elements into place
+			construct_copy_n(first, count, data() + size_);
+			size_ += count;
+			std::rotate(data() + index, data() + size_ - count, data() + size_);
+		}
+		return begin() + index;
+	}
+
+	template <class T, size_t N>
+	template <sized_or_forward_range<T> R>
+	void static_vector<T, N>::append_range(R&& range)
+	{
+		const size_t count = std::ranges::distance(range);
+		check_room(count);
+		construct_copy_n(std::ranges::begin(range), count, data() + size_);
+		size_ += count;
+	}
+
+	template <class T, size_t N>
+	template <sized_or_forward_range<T> R>
+	void static_vector<T, N>::assign_range(R&& range)
+	{
+		assign_n(std::ranges::distance(range), std::ranges::begin(range));
+	}
+
+	template <class T, size_t N>
+	typename static_vector<T, N>::iterator static_vector<T, N>::erase(constant_iterator pos)
+	{
+		return erase(pos, pos + 1);
+	}
+
+	template <class T, size_t N>
+	typename static_vector<T, N>::iterator static_vector<T, N>::erase(constant_iterator first, constant_iterator last)
+	{
+		const size_t index = first - cbegin();
+		const size_t count = last - first;
+		T* gap = data() + index;
+		const size_t tail = size_ - index - count;
+		if constexpr (is_trivially_relocatable_v<T>)
+		{
+			std::destroy_n(gap, count);
+			relocate_overlapping_n(gap + count, tail, gap);
+		}
+		else
+		{
+			std::move(gap + count, data() + size_, gap);
+			std::destroy_n(gap + tail, count);
+		}
+		size_ -= count;
+		return begin() + index;
+	}
+
+	template <class T, size_t N>
+	const T& static_vector<T, N>::at(size_t index) const
+	{
+		if (index >= size_)
+		{
+			throw my_vector_exception("index out of range");
+		}
+		return data()[index];
+	}
+
+	template <class T, size_t N>
+	T& static_vector<T, N>::at(size_t index)
+	{
+		if (index >= size_)
+		{
+			throw my_vector_exception("index out of range");
+		}
+		return data()[index];
+	}
+
+	template <class T, size_t N>
+	const T& static_vector<T, N>::operator[](size_t index) const noexcept
+	{
+		return data()[index];
+	}
+
+	template <class T, size_t N>
+	T& static_vector<T, N>::operator[](size_t index) noexcept
+	{
+		return data()[index];
+	}
+
+	template <class T, size_t N>
+	const T* static_vector<T, N>::data() const noexcept
+	{
+		return std::launder(reinterpret_cast<const T*>(buffer_));
+	}
+
+	template <class T, size_t N>
+	T* static_vector<T, N>::data() noexcept
+	{
+		return std::launder(reinterpret_cast<T*>(buffer_));
+	}
+
+	template <class T, size_t N>
+	bool static_vector<T, N>::empty() const noexcept
+	{
+		return size_ == 0;
+	}
+
+	template <class T, size_t N>
+	bool static_vector<T, N>::full() const noexcept
+	{
+		return size_ == N;
+	}
+
+	template <class T, size_t N>
+	constexpr size_t static_vector<T, N>::max_size() noexcept
+	{
+		return N;
+	}
+
+	template <class T, size_t N>
+	size_t static_vector<T, N>::size() const noexcept
+	{
+		return size_;
+	}
+
+	template <class T, size_t N>
+	constexpr size_t static_vector<T, N>::capacity() noexcept
+	{
+		return N;
+	}
+
+	template <class T, size_t N>
+	T& static_vector<T, N>::front()
+	{
+		if (size_ == 0)
+		{
+			throw my_vector_exception("Vector is empty!");
+		}
+		return data()[0];
+	}
+
+	template <class T, size_t N>
+	const T& static_vector<T, N>::front() const
+	{
+		if (size_ == 0)
+		{
+			throw my_vector_exception("Vector is empty!");
+		}
+		return data()[0];
+	}
+
+	template <class T, size_t N>
+	T& static_vector<T, N>::back()
+	{
+		if (size_ == 0)
+		{
+			throw my_vector_exception("Vector is empty!");
+		}
+		return data()[size_ - 1];
+	}
+
+	template <class T, size_t N>
+	const T& static_vector<T, N>::back() const
+	{
+		if (size_ == 0)
+		{
+			throw my_vector_exception("Vector is empty!");
+		}
+		return data()[size_ - 1];
+	}
+
+	template <class T, size_t N>
+	void static_vector<T, N>::swap(static_vector& other) noexcept(std::is_nothrow_move_constructible_v<T> && std::is_nothrow_swappable_v<T>)
+	{
+		if constexpr (is_trivially_relocatable_v<T>)
+		{
+			// swapping the bytes of the occupied prefix swaps the elements
+			const size_t bytes = (size_ < other.size_ ? other.size_ : size_) * sizeof(T);
+			std::swap_ranges(buffer_, buffer_ + bytes, other.buffer_);
+			std::swap(size_, other.size_);
+			return;
+		}
+		static_vector& shorter = size_ < other.size_ ? *this : other;
+		static_vector& longer = size_ < other.size_ ? other : *this;
+		std::swap_ranges(shorter.data(), shorter.data() + shorter.size_, longer.data());
+		// the elements only the longer one has move across
+		const size_t extra = longer.size_ - shorter.size_;
+		construct_copy_n(std::make_move_iterator(longer.data() + shorter.size_), extra, shorter.data() + shorter.size_);
+		std::destroy_n(longer.data() + shorter.size_, extra);
+		std::swap(size_, other.size_);
+	}
+
+	template <class T, size_t N>
+	typename static_vector<T, N>::iterator static_vector<T, N>::begin()
+	{
+		return iterator(data());
+	}
+
+	template <class T, size_t N>
+	typename static_vector<T, N>::iterator static_vector<T, N>::end()
+	{
+		return iterator(data() + size_);
+	}
+
+	template <class T, size_t N>
+	typename static_vector<T, N>::constant_iterator static_vector<T, N>::begin() const
+	{
+		return constant_iterator(data());
+	}
+
+	template <class T, size_t N>
+	typename static_vector<T, N>::constant_iterator static_vector<T, N>::end() const
+	{
+		return constant_iterator(data() + size_);
+	}
+
+	template <class T, size_t N>
+	typename static_vector<T, N>::constant_iterator static_vector<T, N>::cbegin() const
+	{
+		return begin();
+	}
+
+	template <class T, size_t N>
+	typename static_vector<T, N>::constant_iterator static_vector<T, N>::cend() const
+	{
+		return end();
+	}
+
+	template <class T, size_t N>
+	void static_vector<T, N>::check_room(size_t count) const
+	{
+		if (count > N - size_)
+		{
+			throw my_vector_exception("static_vector capacity exceeded");
+		}
+	}
+
+	template <class T, size_t N>
+	template <class It>
+	void static_vector<T, N>::assign_n(size_t count, It first)
+	{
+		if (count > N)
+		{
+			throw my_vector_exception("static_vector capacity exceeded");
+		}
+		if (count <= size_)
+		{
+			copy_assign_n(first, count, data());
+			std::destroy(data() + count, data() + size_);
+		}
+		else
+		{
+			first = copy_assign_n(first, size_, data());
+			construct_copy_n(first, count - size_, data() + size_);
+		}
+		size_ = count;
+	}
+
+	static_assert(std::is_trivially_copyable_v<static_vector<int, 16>>);
+	static_assert(!std::is_trivially_copyable_v<static_vector<std::unique_ptr<int>, 16>>);
+	static_assert(std::ranges::contiguous_range<static_vector<int, 16>>);
+}
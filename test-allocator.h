@@ -25,6 +25,10 @@ public:
 	}
 
 	test_allocator() = default;
+
+	template <class U>
+	test_allocator(const test_allocator<U>&)
+	{}
 	T* allocate(std::size_t n)
 	{
 		allocated_count += n;
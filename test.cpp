@@ -2,51 +2,118 @@
 #include "test-allocator.h"
 #include "test-object.h"
 
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdio>
+#include <cstring>
+#include <limits>
+#include <list>
+#include <ranges>
+#include <span>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <thread>
 #include <vector>
 #include "my_vector.h"
+#include "bit_vector.h"
+#include "concurrent_vector.h"
+#include "cow_vector.h"
+#include "my_vector_arena_allocator.h"
+#include "my_vector_default_init_allocator.h"
+#include "my_vector_io.h"
+#include "my_vector_malloc_allocator.h"
+#include "my_vector_mmap_allocator.h"
+#include "my_vector_parallel.h"
+#include "my_vector_simd.h"
+#include "my_vector_stats.h"
+#include "mmap_vector.h"
+#include "segmented_vector.h"
+#include "soa_vector.h"
+#include "small_vector.h"
+#include "static_vector.h"
 
-
+// test_object only owns a pointer, so moving its bytes is a valid move.
+template <>
+struct my_vector::is_trivially_relocatable<test_object> : std::true_type
+{};
 
 namespace vector_tests
 {
 	using my_vector::vector;
 	using allocator_to = test_allocator<test_object>;
 	using vector_to = vector<test_object, allocator_to>;
-	TEST(DefaultCtorTest, EmptyVectorSizeCapacityZero)
+	// The container suites run against every vector flavour with the same interface.
+	// small_vector's inline capacity is kept below the sizes used, so both allocate alike.
+	using small_vector_to = my_vector::small_vector<test_object, 4, allocator_to>;
+	using container_types = ::testing::Types<vector_to, small_vector_to>;
+
+	template <class Container>
+	constexpr size_t inline_capacity_v = 0;
+	template <class T, size_t N, class Alloc_T>
+	constexpr size_t inline_capacity_v<my_vector::small_vector<T, N, Alloc_T>> = N;
+
+	template <class Container>
+	class DefaultCtorTest : public ::testing::Test
+	{};
+	template <class Container>
+	class ParametrizedCtorTest : public ::testing::Test
+	{};
+	template <class Container>
+	class ParametrizedCtorTestWithDefaultValue : public ::testing::Test
+	{};
+	template <class Container>
+	class CopyCtorTest : public ::testing::Test
+	{};
+	template <class Container>
+	class InitializerListCtorTest : public ::testing::Test
+	{};
+	template <class Container>
+	class MoveCtorTest : public ::testing::Test
+	{};
+	TYPED_TEST_SUITE(DefaultCtorTest, container_types);
+	TYPED_TEST_SUITE(ParametrizedCtorTest, container_types);
+	TYPED_TEST_SUITE(ParametrizedCtorTestWithDefaultValue, container_types);
+	TYPED_TEST_SUITE(CopyCtorTest, container_types);
+	TYPED_TEST_SUITE(InitializerListCtorTest, container_types);
+	TYPED_TEST_SUITE(MoveCtorTest, container_types);
+
+	TYPED_TEST(DefaultCtorTest, EmptyVectorSizeZeroInlineCapacity)
 	{
 		test_object::nullify();
 		allocator_to::nullify_alloc_count();
 
-		const vector_to empty;
+		const TypeParam empty;
 
-		EXPECT_EQ(empty.capacity(), 0);
+		EXPECT_EQ(empty.capacity(), inline_capacity_v<TypeParam>);
 		EXPECT_EQ(empty.size(), 0);
 		EXPECT_EQ(empty.empty(), true);
 	}
-	TEST(DefaultCtorTest, EmptyVectorNoAllocationsNoConstruction)
+	TYPED_TEST(DefaultCtorTest, EmptyVectorNoAllocationsNoConstruction)
 	{
 		test_object::nullify();
 		allocator_to::nullify_alloc_count();
 
-		const vector_to empty;
+		const TypeParam empty;
 		const allocator_to& allocator = empty.get_allocator();
 
 		EXPECT_EQ(allocator.get_allocated(), 0);
 		EXPECT_EQ(test_object::get_constructors_calls_count(), 0);
 		EXPECT_EQ(test_object::get_destructor_calls_count(), 0);
 	}
-	TEST(ParametrizedCtorTest, CorrectSizeCapacity)
+	TYPED_TEST(ParametrizedCtorTest, CorrectSizeCapacity)
 	{
 		test_object::nullify();
 		allocator_to::nullify_alloc_count();
 
 		constexpr size_t size = 10;
-		const vector_to vec(size);
+		const TypeParam vec(size);
 
 		EXPECT_EQ(vec.size(), size);
 		EXPECT_EQ(vec.capacity(), size);
 	}
-	TEST(ParametrizedCtorTest, CorrectAllocationsConstructionsAmount)
+	TYPED_TEST(ParametrizedCtorTest, CorrectAllocationsConstructionsAmount)
 	{
 		test_object::nullify();
 		allocator_to::nullify_alloc_count();
@@ -54,7 +121,7 @@ namespace vector_tests
 		constexpr size_t size = 10;
 
 		{
-			const vector_to vec(size);
+			const TypeParam vec(size);
 
 			EXPECT_EQ(allocator_to::get_allocated(), size);
 			EXPECT_EQ(test_object::get_constructors_calls_count(), size);
@@ -63,7 +130,7 @@ namespace vector_tests
 		EXPECT_EQ(allocator_to::get_deallocated(), size);
 		EXPECT_EQ(test_object::get_destructor_calls_count(), size);
 	}
-	TEST(ParametrizedCtorTestWithDefaultValue, CorrectData)
+	TYPED_TEST(ParametrizedCtorTestWithDefaultValue, CorrectData)
 	{
 		test_object::nullify();
 		allocator_to::nullify_alloc_count();
@@ -71,7 +138,7 @@ namespace vector_tests
 		constexpr size_t size = 10;
 		{
 			const test_object prototype(10);
-			const vector_to vec(size, prototype);
+			const TypeParam vec(size, prototype);
 
 			EXPECT_EQ(vec.size(), size);
 			EXPECT_EQ(vec.capacity(), size);
@@ -82,7 +149,7 @@ namespace vector_tests
 			}
 		}
 	}
-	TEST(ParametrizedCtorTestWithDefaultValue, CorrectAllocationsConstructionsAmount)
+	TYPED_TEST(ParametrizedCtorTestWithDefaultValue, CorrectAllocationsConstructionsAmount)
 	{
 		test_object::nullify();
 		allocator_to::nullify_alloc_count();
@@ -91,7 +158,7 @@ namespace vector_tests
 
 		{
 			const test_object prototype(10);
-			const vector_to vec(size, prototype);
+			const TypeParam vec(size, prototype);
 
 			EXPECT_EQ(allocator_to::get_allocated(), size);
 			EXPECT_EQ(test_object::get_constructors_calls_count(), size + 1);
@@ -101,15 +168,15 @@ namespace vector_tests
 		EXPECT_EQ(allocator_to::get_deallocated(), size);
 		EXPECT_EQ(test_object::get_destructor_calls_count(), size + 1);
 	}
-	TEST(CopyCtorTest, DataRefersToDifferentArray)
+	TYPED_TEST(CopyCtorTest, DataRefersToDifferentArray)
 	{
 		test_object::nullify();
 		allocator_to::nullify_alloc_count();
 
 		constexpr size_t size = 10;
 		{
-			const vector_to vec(size);
-			const vector_to copy = vec;
+			const TypeParam vec(size);
+			const TypeParam copy = vec;
 
 			const test_object* ptr_first = vec.data();
 			const test_object* ptr_second = copy.data();
@@ -119,14 +186,14 @@ namespace vector_tests
 			ASSERT_NE(ptr_first, ptr_second);
 		}
 	}
-	TEST(CopyCtorTest, CopyVectorEqualData)
+	TYPED_TEST(CopyCtorTest, CopyVectorEqualData)
 	{
 		test_object::nullify();
 		allocator_to::nullify_alloc_count();
 
 		{
-			const vector_to vec = { test_object(1), test_object(2), test_object(3), test_object(5) };
-			const vector_to copy = vec;
+			const TypeParam vec = { test_object(1), test_object(2), test_object(3), test_object(5) };
+			const TypeParam copy = vec;
 
 			const size_t size = vec.size();
 			const size_t size_copy = copy.size();
@@ -145,15 +212,15 @@ namespace vector_tests
 			}
 		}
 	}
-	TEST(CopyCtorTest, CorrectAllocationsConstructionsAmount)
+	TYPED_TEST(CopyCtorTest, CorrectAllocationsConstructionsAmount)
 	{
 		test_object::nullify();
 		allocator_to::nullify_alloc_count();
 
 		const size_t size = 5;
 		{
-			const vector_to vec(size);
-			const vector_to copy(vec);
+			const TypeParam vec(size);
+			const TypeParam copy(vec);
 
 			//EXPECT_EQ(copy.size(), vec.size());
 			EXPECT_EQ(test_object::get_constructors_calls_count(), size * 2);
@@ -167,14 +234,14 @@ namespace vector_tests
 		EXPECT_EQ(allocator_to::get_deallocated(), size * 2);
 		EXPECT_EQ(test_object::get_destructor_calls_count(), size * 2);
 	}
-	TEST(InitializerListCtorTest, CorrectData)
+	TYPED_TEST(InitializerListCtorTest, CorrectData)
 	{
 		test_object::nullify();
 		allocator_to::nullify_alloc_count();
 
 		{
 			const auto list = { test_object(1), test_object(2) ,test_object(3) ,test_object(4),test_object(5) };
-			vector_to vec = list;
+			TypeParam vec = list;
 
 			const size_t size_list = list.size();
 			const size_t vec_list = vec.size();
@@ -189,14 +256,14 @@ namespace vector_tests
 			}
 		}
 	}
-	TEST(InitializerListCtorTest, CorrectAllocationsConstructionsAmount)
+	TYPED_TEST(InitializerListCtorTest, CorrectAllocationsConstructionsAmount)
 	{
 		test_object::nullify();
 		allocator_to::nullify_alloc_count();
 
 		const size_t size = 5;
 		{
-			vector_to vec = { test_object(1), test_object(2) ,test_object(3) ,test_object(4),test_object(5) };
+			TypeParam vec = { test_object(1), test_object(2) ,test_object(3) ,test_object(4),test_object(5) };
 
 
 			EXPECT_EQ(test_object::get_constructors_calls_count(), size * 2);
@@ -210,7 +277,7 @@ namespace vector_tests
 		EXPECT_EQ(allocator_to::get_deallocated(), size);
 		EXPECT_EQ(test_object::get_destructor_calls_count(), size * 2);
 	}
-	TEST(MoveCtorTest, CorrectData)
+	TYPED_TEST(MoveCtorTest, CorrectData)
 	{
 		test_object::nullify();
 		allocator_to::nullify_alloc_count();
@@ -218,9 +285,9 @@ namespace vector_tests
 		{
 			const auto list = { test_object(1), test_object(2) ,test_object(3) ,test_object(4),test_object(5) };
 
-			vector_to vec = list;
+			TypeParam vec = list;
 			const size_t vec_size = vec.size();
-			vector_to dest(std::move(vec));
+			TypeParam dest(std::move(vec));
 
 
 			ASSERT_EQ(vec_size, dest.size());
@@ -233,15 +300,15 @@ namespace vector_tests
 			}
 		}
 	}
-	TEST(MoveCtorTest, CorrectAllocationsConstructionsAmount)
+	TYPED_TEST(MoveCtorTest, CorrectAllocationsConstructionsAmount)
 	{
 		test_object::nullify();
 		allocator_to::nullify_alloc_count();
 
 		constexpr size_t size = 5;
 		{
-			vector_to vec(size);
-			vector_to dest(std::move(vec));
+			TypeParam vec(size);
+			TypeParam dest(std::move(vec));
 
 
 			EXPECT_EQ(test_object::get_constructors_calls_count(), size);
@@ -255,5 +322,2215 @@ namespace vector_tests
 		EXPECT_EQ(allocator_to::get_deallocated(), size);
 		EXPECT_EQ(test_object::get_destructor_calls_count(), size);
 	}
+	TEST(RelocationTraitTest, DefaultsFollowTriviallyCopyable)
+	{
+		struct pod
+		{
+			int a;
+			double b;
+		};
+
+		static_assert(my_vector::is_trivially_relocatable_v<int>);
+		static_assert(my_vector::is_trivially_relocatable_v<double>);
+		static_assert(my_vector::is_trivially_relocatable_v<pod>);
+		static_assert(my_vector::is_trivially_relocatable_v<test_object>);
+		static_assert(!my_vector::is_trivially_relocatable_v<std::string>);
+	}
+	TEST(ReserveTest, RelocationNoMovesNoDestruction)
+	{
+		test_object::nullify();
+		allocator_to::nullify_alloc_count();
+
+		constexpr size_t size = 5;
+		constexpr size_t new_capacity = 20;
+		{
+			vector_to vec = { test_object(1), test_object(2), test_object(3), test_object(4), test_object(5) };
+			const test_object* old_data = vec.data();
+			int* first_id = vec[0].get_id();
+			test_object::nullify();
+
+			vec.reserve(new_capacity);
+
+			EXPECT_EQ(test_object::get_moves_count(), 0);
+			EXPECT_EQ(test_object::get_copy_count(), 0);
+			EXPECT_EQ(test_object::get_constructors_calls_count(), 0);
+			EXPECT_EQ(test_object::get_destructor_calls_count(), 0);
+			EXPECT_EQ(vec.capacity(), new_capacity);
+			EXPECT_NE(vec.data(), old_data);
+			EXPECT_EQ(vec[0].get_id(), first_id);
+			for (size_t i = 0; i < size; ++i)
+			{
+				ASSERT_EQ(*vec[i].get_id(), static_cast<int>(i) + 1);
+			}
+		}
+
+		EXPECT_EQ(allocator_to::get_allocated(), size + new_capacity);
+		EXPECT_EQ(allocator_to::get_deallocated(), size + new_capacity);
+		EXPECT_EQ(test_object::get_destructor_calls_count(), size);
+	}
+	TEST(ShrinkToFitTest, RelocationNoMovesNoDestruction)
+	{
+		test_object::nullify();
+		allocator_to::nullify_alloc_count();
+
+		constexpr size_t size = 5;
+		{
+			vector_to vec(size);
+			vec.reserve(size * 3);
+			test_object::nullify();
+
+			vec.shrink_to_fit();
+
+			EXPECT_EQ(test_object::get_moves_count(), 0);
+			EXPECT_EQ(test_object::get_constructors_calls_count(), 0);
+			EXPECT_EQ(test_object::get_destructor_calls_count(), 0);
+			EXPECT_EQ(vec.size(), size);
+			EXPECT_EQ(vec.capacity(), size);
+		}
+
+		EXPECT_EQ(test_object::get_destructor_calls_count(), size);
+		EXPECT_EQ(allocator_to::get_allocated(), allocator_to::get_deallocated());
+	}
+	TEST(ReserveTest, NonRelocatableElementsMoved)
+	{
+		vector<std::string> vec = { "first", "second", "a string long enough to live on the heap" };
+
+		vec.reserve(10);
+
+		EXPECT_EQ(vec.capacity(), 10);
+		EXPECT_EQ(vec[0], "first");
+		EXPECT_EQ(vec[1], "second");
+		EXPECT_EQ(vec[2], "a string long enough to live on the heap");
+	}
+	template <size_t Size>
+	struct fill_record
+	{
+		unsigned char bytes[Size];
+
+		bool operator==(const fill_record&) const = default;
+	};
+
+	template <class T>
+	T make_fill_value(int seed)
+	{
+		T value{};
+		auto* bytes = reinterpret_cast<unsigned char*>(&value);
+		for (size_t i = 0; i < sizeof(T); ++i)
+		{
+			bytes[i] = static_cast<unsigned char>(seed + i * 7 + 1);
+		}
+		return value;
+	}
+
+	template <class T>
+	void check_fill_resize()
+	{
+		const T value = make_fill_value<T>(3);
+		const T other = make_fill_value<T>(11);
+
+		// odd prefix sizes leave the filled range misaligned to vector width
+		for (size_t prefix : { 0, 1, 3, 5 })
+		{
+			for (size_t count : { 0, 1, 2, 7, 33, 100, 1000 })
+			{
+				vector<T> vec(prefix, other);
+				vec.resize(prefix + count, value);
+
+				ASSERT_EQ(vec.size(), prefix + count);
+				for (size_t i = 0; i < prefix; ++i)
+				{
+					ASSERT_EQ(vec[i], other);
+				}
+				for (size_t i = prefix; i < vec.size(); ++i)
+				{
+					ASSERT_EQ(vec[i], value);
+				}
+			}
+		}
+	}
+	TEST(BulkConstructionTest, FillValueAllElementSizes)
+	{
+		check_fill_resize<char>();
+		check_fill_resize<short>();
+		check_fill_resize<int>();
+		check_fill_resize<double>();
+		check_fill_resize<fill_record<3>>();
+		check_fill_resize<fill_record<12>>();
+		check_fill_resize<fill_record<16>>();
+		check_fill_resize<fill_record<32>>();
+		check_fill_resize<fill_record<64>>();
+	}
+	TEST(BulkConstructionTest, LargeFillValue)
+	{
+		constexpr size_t size = size_t{ 3 } << 20;
+		const vector<int> vec(size, 42);
+
+		for (size_t i = 0; i < size; ++i)
+		{
+			ASSERT_EQ(vec[i], 42);
+		}
+	}
+	TEST(BulkConstructionTest, DefaultConstructionZeroes)
+	{
+		constexpr size_t size = 1000;
+		vector<double> doubles(size, 1.5);
+		doubles.resize(size / 2);
+		doubles.resize(size);
+		const vector<int*> pointers(size);
+
+		for (size_t i = size / 2; i < size; ++i)
+		{
+			ASSERT_EQ(doubles[i], 0.0);
+		}
+		for (size_t i = 0; i < size; ++i)
+		{
+			ASSERT_EQ(pointers[i], nullptr);
+		}
+		static_assert(my_vector::is_zero_initializable_v<int*>);
+		static_assert(!my_vector::is_zero_initializable_v<int fill_record<4>::*>);
+		static_assert(!my_vector::is_zero_initializable_v<test_object>);
+	}
+
+	template <class T>
+	class zeroing_allocator
+	{
+		std::allocator<T> allocator_;
+	public:
+		using value_type = T;
+		static size_t zeroed_count;
+
+		zeroing_allocator() = default;
+
+		T* allocate(size_t n)
+		{
+			return allocator_.allocate(n);
+		}
+
+		T* allocate_zeroed(size_t n)
+		{
+			++zeroed_count;
+			T* result = allocator_.allocate(n);
+			std::memset(result, 0, n * sizeof(T));
+			return result;
+		}
+
+		void deallocate(T* p, size_t n)
+		{
+			allocator_.deallocate(p, n);
+		}
+	};
+	template <class T>
+	size_t zeroing_allocator<T>::zeroed_count = 0;
+
+	TEST(BulkConstructionTest, ZeroedAllocationUsedForValueInitialization)
+	{
+		zeroing_allocator<long>::zeroed_count = 0;
+
+		const vector<long, zeroing_allocator<long>> vec(100);
+
+		EXPECT_EQ(zeroing_allocator<long>::zeroed_count, 1);
+		for (size_t i = 0; i < vec.size(); ++i)
+		{
+			ASSERT_EQ(vec[i], 0);
+		}
+	}
+	TEST(OverwriteGrowthTest, ResizeForOverwriteLeavesBytesUnwritten)
+	{
+		vector<uint8_t> buffer(64, 0xAB);
+		buffer.clear();
+		buffer.resize_for_overwrite(64);
+
+		EXPECT_EQ(buffer.size(), 64);
+		EXPECT_EQ(buffer.capacity(), 64);
+		for (size_t i = 0; i < buffer.size(); ++i)
+		{
+			ASSERT_EQ(buffer[i], 0xAB);
+		}
+
+		// class types are still default constructed
+		test_object::nullify();
+		{
+			vector<test_object> objects;
+			objects.resize_for_overwrite(5);
+			EXPECT_EQ(test_object::get_current_allocated_objects(), 5);
+			objects.resize_for_overwrite(2);
+			EXPECT_EQ(test_object::get_current_allocated_objects(), 2);
+		}
+		EXPECT_EQ(test_object::get_current_allocated_objects(), 0);
+	}
+	TEST(OverwriteGrowthTest, ReserveAndAppendCommitsWrittenPrefix)
+	{
+		vector<char> buffer;
+		const std::string message = "hello";
+		const size_t appended = buffer.reserve_and_append(16, [&](char* dest, size_t count)
+		{
+			EXPECT_EQ(count, 16);
+			std::copy(message.begin(), message.end(), dest);
+			return message.size();
+		});
+
+		EXPECT_EQ(appended, 5);
+		EXPECT_EQ(std::string(buffer.begin(), buffer.end()), "hello");
+		EXPECT_GE(buffer.capacity(), 16);
+
+		EXPECT_THROW(buffer.reserve_and_append(100, [](char*, size_t) -> size_t
+		{
+			throw std::runtime_error("read failed");
+		}), std::runtime_error);
+		EXPECT_EQ(buffer.size(), 5);
+		EXPECT_EQ(buffer.reserve_and_append(8, [](char*, size_t) { return size_t{ 0 }; }), 0);
+		EXPECT_EQ(buffer.size(), 5);
+
+		// a writer claiming more than it was offered, or a count that wraps the size, is refused
+		EXPECT_THROW(buffer.reserve_and_append(8, [](char*, size_t count) { return count + 1; }), my_vector::my_vector_exception);
+		EXPECT_EQ(buffer.size(), 5);
+		const size_t capacity = buffer.capacity();
+		EXPECT_THROW(buffer.reserve_and_append(SIZE_MAX - 2, [](char*, size_t) { return size_t{ 0 }; }), my_vector::my_vector_exception);
+		EXPECT_EQ(buffer.size(), 5);
+		EXPECT_EQ(buffer.capacity(), capacity);
+	}
+	TEST(OverwriteGrowthTest, DefaultInitAllocatorSkipsZeroing)
+	{
+		using allocator = my_vector::default_init_allocator<uint8_t, zeroing_allocator<uint8_t>>;
+		static_assert(std::is_same_v<std::allocator_traits<allocator>::rebind_alloc<int>,
+			my_vector::default_init_allocator<int, zeroing_allocator<int>>>);
+		zeroing_allocator<uint8_t>::zeroed_count = 0;
+
+		vector<uint8_t, allocator> buffer(100);
+		EXPECT_EQ(zeroing_allocator<uint8_t>::zeroed_count, 0);
+		std::fill(buffer.begin(), buffer.end(), 0xCD);
+		buffer.resize(50);
+		buffer.resize(100);
+		for (size_t i = 0; i < buffer.size(); ++i)
+		{
+			ASSERT_EQ(buffer[i], 0xCD);
+		}
+	}
+	TEST(IteratorTest, RandomAccessArithmetic)
+	{
+		vector<int> vec = { 10, 20, 30, 40, 50 };
+
+		vector<int>::iterator it = vec.begin();
+		it += 3;
+		EXPECT_EQ(*it, 40);
+		EXPECT_EQ(it[-1], 30);
+		EXPECT_EQ(*(it - 2), 20);
+		EXPECT_EQ(*(1 + it), 50);
+		--it;
+		EXPECT_EQ(*it--, 30);
+		EXPECT_EQ(*it, 20);
+		EXPECT_EQ(vec.end() - vec.begin(), 5);
+		EXPECT_LT(vec.begin(), vec.end());
+		EXPECT_GE(vec.end(), it);
+		EXPECT_EQ(std::to_address(vec.begin()), vec.data());
+		EXPECT_EQ(std::to_address(vec.cend()), vec.data() + vec.size());
+	}
+	TEST(IteratorTest, IteratorConvertsToConstantIterator)
+	{
+		vector<int> vec = { 1, 2, 3 };
+
+		const vector<int>::constant_iterator first = vec.begin();
+		vector<int>::constant_iterator last = vec.end();
+
+		EXPECT_EQ(first, vec.cbegin());
+		EXPECT_TRUE(vec.begin() == first);
+		EXPECT_EQ(last - first, 3);
+		EXPECT_EQ(*--last, 3);
+	}
+	TEST(IteratorTest, StandardAlgorithms)
+	{
+		vector<int> vec = { 5, 3, 9, 1, 7, 3, 8 };
+
+		std::sort(vec.begin(), vec.end());
+		EXPECT_TRUE(std::is_sorted(vec.cbegin(), vec.cend()));
+		EXPECT_EQ(*std::lower_bound(vec.cbegin(), vec.cend(), 4), 5);
+
+		std::ranges::sort(vec, std::greater<>());
+		EXPECT_EQ(vec.front(), 9);
+		EXPECT_EQ(vec.back(), 1);
+
+		std::reverse(vec.begin(), vec.end());
+		EXPECT_EQ(std::ranges::distance(vec), 7);
+		EXPECT_EQ(*std::ranges::max_element(vec), 9);
+		EXPECT_EQ(std::ranges::data(vec), vec.data());
+	}
+	TEST(RangeCtorTest, IteratorPairAndRanges)
+	{
+		const std::list<int> list = { 1, 2, 3, 4 };
+
+		const vector<int> from_iterators(list.begin(), list.end());
+		const vector<int> from_view(my_vector::from_range, std::views::iota(0, 100));
+
+		EXPECT_EQ(from_iterators.size(), 4);
+		EXPECT_EQ(from_iterators.capacity(), 4);
+		EXPECT_TRUE(std::ranges::equal(from_iterators, list));
+		EXPECT_EQ(from_view.size(), 100);
+		EXPECT_EQ(from_view.capacity(), 100);
+		EXPECT_EQ(from_view[99], 99);
+	}
+	TEST(AppendRangeTest, SingleAllocationForBatch)
+	{
+		test_object::nullify();
+		allocator_to::nullify_alloc_count();
+
+		constexpr size_t size = 3;
+		constexpr size_t batch_size = 100;
+		{
+			vector_to vec(size);
+			const std::vector<test_object> batch(batch_size, test_object(7));
+			allocator_to::nullify_alloc_count();
+			test_object::nullify();
+
+			vec.append_range(batch);
+
+			EXPECT_EQ(vec.size(), size + batch_size);
+			EXPECT_EQ(allocator_to::get_allocated(), size + batch_size);
+			EXPECT_EQ(test_object::get_copy_count(), batch_size);
+			EXPECT_EQ(test_object::get_moves_count(), 0);
+			EXPECT_EQ(*vec.back().get_id(), 7);
+		}
+	}
+	TEST(InsertTest, MiddleWithinCapacity)
+	{
+		test_object::nullify();
+		allocator_to::nullify_alloc_count();
+		{
+			vector_to vec = { test_object(1), test_object(2), test_object(5) };
+			vec.reserve(10);
+			const std::vector<test_object> inserted = { test_object(3), test_object(4) };
+			allocator_to::nullify_alloc_count();
+			test_object::nullify();
+
+			const auto it = vec.insert(vec.begin() + 2, inserted.begin(), inserted.end());
+
+			EXPECT_EQ(it - vec.begin(), 2);
+			EXPECT_EQ(allocator_to::get_allocated(), 0);
+			EXPECT_EQ(test_object::get_moves_count(), 0);
+			EXPECT_EQ(test_object::get_copy_count(), 2);
+			ASSERT_EQ(vec.size(), 5);
+			for (size_t i = 0; i < vec.size(); ++i)
+			{
+				ASSERT_EQ(*vec[i].get_id(), static_cast<int>(i) + 1);
+			}
+		}
+	}
+	TEST(InsertTest, ReallocatesOnce)
+	{
+		vector<int> vec = { 1, 2, 3 };
+		const std::list<int> inserted = { 10, 11, 12, 13, 14, 15 };
+
+		vec.insert(vec.begin() + 1, inserted.begin(), inserted.end());
+
+		EXPECT_EQ(vec.size(), 9);
+		EXPECT_EQ(vec.capacity(), 9);
+		const vector<int> expected = { 1, 10, 11, 12, 13, 14, 15, 2, 3 };
+		EXPECT_TRUE(std::ranges::equal(vec, expected));
+	}
+	// Counts deallocate calls, which must never be handed a null pointer
+	template <class T>
+	struct deallocation_counting_allocator
+	{
+		using value_type = T;
+		static size_t deallocations;
+		static size_t null_deallocations;
+
+		deallocation_counting_allocator() = default;
+
+		template <class U>
+		deallocation_counting_allocator(const deallocation_counting_allocator<U>&) noexcept
+		{}
+
+		T* allocate(size_t n)
+		{
+			return std::allocator<T>().allocate(n);
+		}
+
+		void deallocate(T* p, size_t n)
+		{
+			++deallocations;
+			null_deallocations += p == nullptr ? 1 : 0;
+			std::allocator<T>().deallocate(p, n);
+		}
+
+		bool operator==(const deallocation_counting_allocator&) const = default;
+	};
+	template <class T>
+	size_t deallocation_counting_allocator<T>::deallocations = 0;
+	template <class T>
+	size_t deallocation_counting_allocator<T>::null_deallocations = 0;
+
+	TEST(InsertTest, IntoEmptyVectorReleasesNothing)
+	{
+		using allocator = deallocation_counting_allocator<int>;
+		{
+			vector<int, allocator, my_vector::counting_stats> vec;
+			const std::array<int, 3> inserted = { 1, 2, 3 };
+			vec.insert(vec.begin(), inserted.begin(), inserted.end());
+			EXPECT_TRUE(std::ranges::equal(vec, inserted));
+			EXPECT_EQ(allocator::deallocations, 0);
+			EXPECT_EQ(vec.stats().reallocations, 0);
+		}
+		EXPECT_EQ(allocator::deallocations, 1);
+		EXPECT_EQ(allocator::null_deallocations, 0);
+	}
+	TEST(InsertTest, NonRelocatableElements)
+	{
+		const std::vector<std::string> inserted = { "x", "y" };
+		for (size_t position = 0; position <= 4; ++position)
+		{
+			for (size_t extra = 0; extra <= 2; extra += 2)
+			{
+				vector<std::string> vec = { "a", "b", "c", "d" };
+				vec.reserve(vec.size() + extra);
+				std::vector<std::string> expected = { "a", "b", "c", "d" };
+
+				vec.insert_range(vec.begin() + position, inserted);
+				expected.insert(expected.begin() + position, inserted.begin(), inserted.end());
+
+				ASSERT_TRUE(std::ranges::equal(vec, expected));
+			}
+		}
+	}
+	TEST(AssignRangeTest, ReusesStorage)
+	{
+		vector<int> vec = { 1, 2, 3, 4, 5 };
+		const int* data = vec.data();
+
+		vec.assign_range(std::views::iota(10, 13));
+
+		EXPECT_EQ(vec.data(), data);
+		EXPECT_EQ(vec.size(), 3);
+		EXPECT_EQ(vec[2], 12);
+
+		vec.assign_range(std::views::iota(0, 50));
+		EXPECT_EQ(vec.size(), 50);
+		EXPECT_EQ(vec.capacity(), 50);
+		EXPECT_EQ(vec[49], 49);
+	}
+	TEST(AssignTest, SteadyStateCopyAssignmentAllocatesNothing)
+	{
+		constexpr size_t size = 64;
+		const vector_to frame(size);
+		const vector_to smaller(size / 2);
+		vector_to target;
+		target = frame;
+		EXPECT_EQ(target.capacity(), size);
+
+		test_object::nullify();
+		allocator_to::nullify_alloc_count();
+		for (int i = 0; i < 100; ++i)
+		{
+			target = frame;
+		}
+		EXPECT_EQ(allocator_to::get_allocated(), 0);
+		EXPECT_EQ(allocator_to::get_deallocated(), 0);
+		// the elements are assigned over, never rebuilt
+		EXPECT_EQ(test_object::get_constructors_calls_count(), 0);
+		EXPECT_EQ(test_object::get_destructor_calls_count(), 0);
+		EXPECT_EQ(test_object::get_copy_count(), 100 * size);
+
+		// shrinking and growing within capacity touch only the difference
+		target = smaller;
+		EXPECT_EQ(test_object::get_destructor_calls_count(), size / 2);
+		target = frame;
+		EXPECT_EQ(test_object::get_constructors_calls_count(), size / 2);
+		EXPECT_EQ(allocator_to::get_allocated(), 0);
+		EXPECT_EQ(target.size(), size);
+	}
+	TEST(AssignTest, AssignValueAndIteratorRange)
+	{
+		allocator_to::nullify_alloc_count();
+		vector<int, test_allocator<int>> vec = { 1, 2, 3 };
+		vec.assign(10, 7);
+		EXPECT_EQ(vec.size(), 10);
+		EXPECT_EQ(vec.capacity(), 10);
+		EXPECT_EQ(std::count(vec.begin(), vec.end(), 7), 10);
+
+		test_allocator<int>::nullify_alloc_count();
+		const int* data = vec.data();
+		const std::list<int> source = { 4, 5, 6, 7, 8 };
+		vec.assign(source.begin(), source.end());
+		EXPECT_TRUE(std::ranges::equal(vec, source));
+		vec.assign(3, vec[4]);
+		EXPECT_TRUE(std::ranges::equal(vec, std::vector<int>{ 8, 8, 8 }));
+		vec = { 9, 8, 7, 6 };
+		EXPECT_TRUE(std::ranges::equal(vec, std::vector<int>{ 9, 8, 7, 6 }));
+		EXPECT_EQ(vec.data(), data);
+		EXPECT_EQ(test_allocator<int>::get_allocated(), 0);
+
+		// a value aliasing an element survives reallocation
+		vec.assign(50, vec[0]);
+		EXPECT_EQ(vec.size(), 50);
+		EXPECT_EQ(std::count(vec.begin(), vec.end(), 9), 50);
+	}
+	TEST(EraseTest, RangeShiftsTail)
+	{
+		test_object::nullify();
+		{
+			vector_to vec = { test_object(1), test_object(2), test_object(3), test_object(4), test_object(5) };
+			test_object::nullify();
+
+			const auto it = vec.erase(vec.begin() + 1, vec.begin() + 3);
+
+			EXPECT_EQ(*it->get_id(), 4);
+			EXPECT_EQ(test_object::get_destructor_calls_count(), 2);
+			EXPECT_EQ(test_object::get_moves_count(), 0);
+			ASSERT_EQ(vec.size(), 3);
+			EXPECT_EQ(*vec[0].get_id(), 1);
+			EXPECT_EQ(*vec[2].get_id(), 5);
+
+			vec.erase(vec.end() - 1);
+			EXPECT_EQ(vec.size(), 2);
+		}
+		EXPECT_EQ(test_object::get_destructor_calls_count(), 5);
+	}
+	TEST(EraseTest, NonRelocatableElements)
+	{
+		vector<std::string> vec = { "a", "b", "c", "d", "e" };
+
+		vec.erase(vec.begin(), vec.begin() + 2);
+		vec.erase(vec.begin() + 1);
+
+		const vector<std::string> expected = { "c", "e" };
+		EXPECT_TRUE(std::ranges::equal(vec, expected));
+	}
+	TEST(EraseTest, EraseIfCompactsInOnePass)
+	{
+		test_object::nullify();
+		{
+			vector_to vec;
+			for (int i = 0; i < 10; ++i)
+			{
+				vec.emplace_back(i);
+			}
+			allocator_to::nullify_alloc_count();
+			test_object::nullify();
+
+			EXPECT_EQ(vec.erase_if([](const test_object& object) { return *object.get_id() % 3 == 0; }), 4);
+
+			const std::vector<int> expected = { 1, 2, 4, 5, 7, 8 };
+			EXPECT_TRUE(std::ranges::equal(vec, expected, {}, [](const test_object& object) { return *object.get_id(); }));
+			EXPECT_EQ(test_object::get_destructor_calls_count(), 4);
+			EXPECT_EQ(test_object::get_moves_count(), 0);
+			EXPECT_EQ(allocator_to::get_allocated(), 0);
+		}
+		EXPECT_EQ(test_object::get_destructor_calls_count(), 10);
+
+		vector<std::string> strings = { "a", "bb", "c", "dd", "ee", "f" };
+		EXPECT_EQ(strings.erase_if([](const std::string& text) { return text.size() == 2; }), 3);
+		EXPECT_TRUE(std::ranges::equal(strings, std::vector<std::string>{ "a", "c", "f" }));
+	}
+	TEST(EraseTest, EraseIfKeepsUnvisitedElementsWhenPredThrows)
+	{
+		// rejects 0, 2 and 4, then throws at 5: 1, 3 and everything from 5 on must remain in order
+		const auto pred = [](int value)
+		{
+			if (value == 5)
+			{
+				throw std::runtime_error("pred failed");
+			}
+			return value % 2 == 0;
+		};
+		const std::vector<int> expected = { 1, 3, 5, 6, 7 };
+
+		vector<int> ints;
+		vector<std::string> strings;
+		vector_to objects;
+		for (int i = 0; i < 8; ++i)
+		{
+			ints.push_back(i);
+			strings.push_back(std::to_string(i));
+			objects.emplace_back(i);
+		}
+
+		EXPECT_THROW(ints.erase_if(pred), std::runtime_error);
+		EXPECT_TRUE(std::ranges::equal(ints, expected));
+
+		EXPECT_THROW(strings.erase_if([&](const std::string& text) { return pred(std::stoi(text)); }), std::runtime_error);
+		EXPECT_TRUE(std::ranges::equal(strings, expected, {}, [](const std::string& text) { return std::stoi(text); }));
+
+		EXPECT_THROW(objects.erase_if([&](const test_object& object) { return pred(*object.get_id()); }), std::runtime_error);
+		EXPECT_TRUE(std::ranges::equal(objects, expected, {}, [](const test_object& object) { return *object.get_id(); }));
+	}
+	TEST(EraseTest, EraseValueMatchesStdErase)
+	{
+		// arithmetic types without simd kernels take the erase_if path
+		vector<uint64_t> words = { 1, 2, 3, 2 };
+		EXPECT_EQ(words.erase_value(2), 2);
+		EXPECT_TRUE(std::ranges::equal(words, std::vector<uint64_t>{ 1, 3 }));
+		vector<int64_t> longs = { -1, 4, -1 };
+		EXPECT_EQ(longs.erase_value(-1), 2);
+		EXPECT_TRUE(std::ranges::equal(longs, std::vector<int64_t>{ 4 }));
+
+		vector<std::string> strings = { "x", "y", "x" };
+		EXPECT_EQ(strings.erase_value("x"), 2);
+		EXPECT_TRUE(std::ranges::equal(strings, std::vector<std::string>{ "y" }));
+	}
+	TEST(EraseTest, UnorderedEraseFillsFromBack)
+	{
+		test_object::nullify();
+		{
+			vector_to vec;
+			for (int i = 0; i < 8; ++i)
+			{
+				vec.emplace_back(i);
+			}
+			test_object::nullify();
+
+			vec.unordered_erase(1);
+			EXPECT_EQ(*vec[1].get_id(), 7);
+			vec.unordered_erase(vec.size() - 1);
+			EXPECT_EQ(vec.size(), 6);
+			EXPECT_THROW(vec.unordered_erase(6), my_vector::my_vector_exception);
+
+			// 0 7 2 3 4 5 -> drop the evens; the holes at 0 and 2 take 5 and 3
+			EXPECT_EQ(vec.unordered_erase_if([](const test_object& object) { return *object.get_id() % 2 == 0; }), 3);
+			std::vector<int> ids;
+			for (const test_object& object : vec)
+			{
+				ids.push_back(*object.get_id());
+			}
+			EXPECT_EQ(ids, (std::vector<int>{ 5, 7, 3 }));
+			EXPECT_EQ(test_object::get_destructor_calls_count(), 5);
+			EXPECT_EQ(test_object::get_moves_count(), 0);
+		}
+		EXPECT_EQ(test_object::get_destructor_calls_count(), 8);
 
+		for (size_t size = 0; size < 20; ++size)
+		{
+			vector<std::string> strings;
+			for (size_t i = 0; i < size; ++i)
+			{
+				strings.push_back(std::to_string(i % 4));
+			}
+			const size_t erased = strings.unordered_erase_if([](const std::string& text) { return text != "1"; });
+			EXPECT_EQ(erased + strings.size(), size);
+			EXPECT_EQ(strings.size(), (size + 2) / 4);
+			EXPECT_TRUE(std::ranges::all_of(strings, [](const std::string& text) { return text == "1"; }));
+		}
+	}
+	template <class T>
+	class rounding_allocator
+	{
+		std::allocator<T> allocator_;
+	public:
+		using value_type = T;
+		static constexpr size_t granularity = 16;
+		static size_t allocations;
+
+		rounding_allocator() = default;
+
+		T* allocate(size_t n)
+		{
+			return allocate_at_least(n).ptr;
+		}
+
+		my_vector::allocation_result<T*> allocate_at_least(size_t n)
+		{
+			++allocations;
+			const size_t count = (n + granularity - 1) / granularity * granularity;
+			return { allocator_.allocate(count), count };
+		}
+
+		void deallocate(T* p, size_t n)
+		{
+			ASSERT_EQ(n % granularity, 0);
+			allocator_.deallocate(p, n);
+		}
+	};
+	template <class T>
+	size_t rounding_allocator<T>::allocations = 0;
+
+	// Hands out fixed-size blocks, so any growth up to the block size happens in place
+	template <class T>
+	class expanding_allocator
+	{
+		std::allocator<T> allocator_;
+	public:
+		using value_type = T;
+		static constexpr size_t block_size = 64;
+		static size_t allocations;
+		static size_t expansions;
+
+		expanding_allocator() = default;
+
+		T* allocate(size_t n)
+		{
+			++allocations;
+			return allocator_.allocate(std::max(n, block_size));
+		}
+
+		bool try_expand(T*, size_t n, size_t new_n)
+		{
+			if (n > block_size || new_n > block_size)
+			{
+				return false;
+			}
+			++expansions;
+			return true;
+		}
+
+		void deallocate(T* p, size_t n)
+		{
+			allocator_.deallocate(p, std::max(n, block_size));
+		}
+	};
+	template <class T>
+	size_t expanding_allocator<T>::allocations = 0;
+	template <class T>
+	size_t expanding_allocator<T>::expansions = 0;
+
+	TEST(AllocateAtLeastTest, RealCapacityRecorded)
+	{
+		using allocator = rounding_allocator<int>;
+		allocator::allocations = 0;
+
+		vector<int, allocator> vec(3, 1);
+		EXPECT_EQ(vec.capacity(), allocator::granularity);
+
+		for (int i = 0; i < 13; ++i)
+		{
+			vec.push_back(i);
+		}
+		EXPECT_EQ(allocator::allocations, 1);
+		EXPECT_EQ(vec.size(), allocator::granularity);
+
+		vec.push_back(0);
+		EXPECT_EQ(allocator::allocations, 2);
+		EXPECT_EQ(vec.capacity() % allocator::granularity, 0);
+	}
+	TEST(InPlaceGrowthTest, TryExpandKeepsElementsInPlace)
+	{
+		using allocator = expanding_allocator<std::string>;
+		allocator::allocations = allocator::expansions = 0;
+
+		vector<std::string, allocator> vec = { "a", "b" };
+		const std::string* data = vec.data();
+		for (size_t i = 0; i < 40; ++i)
+		{
+			vec.emplace_back(i, 'x');
+		}
+
+		EXPECT_EQ(vec.data(), data);
+		EXPECT_EQ(allocator::allocations, 1);
+		EXPECT_GT(allocator::expansions, 0);
+		EXPECT_EQ(vec[0], "a");
+		EXPECT_EQ(vec.back(), std::string(39, 'x'));
+
+		vec.reserve(allocator::block_size + 1);
+		EXPECT_NE(vec.data(), data);
+		EXPECT_EQ(allocator::allocations, 2);
+		EXPECT_EQ(vec[1], "b");
+	}
+	TEST(InPlaceGrowthTest, MallocAllocatorReallocates)
+	{
+		vector<long, my_vector::malloc_allocator<long>> vec;
+		constexpr long count = 100000;
+		for (long i = 0; i < count; ++i)
+		{
+			vec.push_back(i);
+		}
+		EXPECT_GE(vec.capacity(), vec.size());
+		vec.shrink_to_fit();
+		EXPECT_EQ(vec.capacity(), vec.size());
+		vec.reserve(count * 4);
+		EXPECT_GE(vec.capacity(), static_cast<size_t>(count) * 4);
+
+		for (long i = 0; i < count; ++i)
+		{
+			ASSERT_EQ(vec[i], i);
+		}
+	}
+	TEST(SmallVectorTest, WithinInlineCapacityNoAllocations)
+	{
+		test_object::nullify();
+		allocator_to::nullify_alloc_count();
+		{
+			small_vector_to vec;
+			for (int i = 0; i < 4; ++i)
+			{
+				vec.emplace_back(i);
+			}
+			vec.pop_back();
+			vec.push_back(test_object(3));
+
+			EXPECT_TRUE(vec.is_inline());
+			EXPECT_EQ(vec.size(), 4);
+			EXPECT_EQ(vec.capacity(), 4);
+			EXPECT_EQ(*vec[3].get_id(), 3);
+
+			const small_vector_to copy = vec;
+			small_vector_to moved(std::move(vec));
+			EXPECT_EQ(copy[2], moved[2]);
+		}
+		EXPECT_EQ(allocator_to::get_allocated(), 0);
+		EXPECT_EQ(allocator_to::get_deallocated(), 0);
+		EXPECT_EQ(test_object::get_current_allocated_objects(), 0);
+	}
+	TEST(SmallVectorTest, SpillsToHeapAndShrinksBack)
+	{
+		test_object::nullify();
+		allocator_to::nullify_alloc_count();
+		{
+			small_vector_to vec;
+			for (int i = 0; i < 5; ++i)
+			{
+				vec.emplace_back(i);
+			}
+			EXPECT_FALSE(vec.is_inline());
+			EXPECT_EQ(allocator_to::get_allocated(), 6);
+			EXPECT_EQ(test_object::get_moves_count(), 0);
+
+			vec.erase(vec.begin(), vec.begin() + 2);
+			vec.shrink_to_fit();
+			EXPECT_TRUE(vec.is_inline());
+			EXPECT_EQ(allocator_to::get_deallocated(), 6);
+			ASSERT_EQ(vec.size(), 3);
+			EXPECT_EQ(*vec.front().get_id(), 2);
+			EXPECT_EQ(*vec.back().get_id(), 4);
+		}
+		EXPECT_EQ(test_object::get_current_allocated_objects(), 0);
+	}
+	TEST(SmallVectorTest, SwapInlineAndHeap)
+	{
+		my_vector::small_vector<std::string, 2> inline_vec = { "a", "b" };
+		my_vector::small_vector<std::string, 2> heap_vec = { "c", "d", "e" };
+
+		inline_vec.swap(heap_vec);
+
+		EXPECT_FALSE(inline_vec.is_inline());
+		EXPECT_TRUE(heap_vec.is_inline());
+		EXPECT_EQ(inline_vec.size(), 3);
+		EXPECT_EQ(inline_vec[2], "e");
+		EXPECT_EQ(heap_vec[1], "b");
+
+		heap_vec.insert(heap_vec.begin() + 1, inline_vec.begin(), inline_vec.end());
+		const std::vector<std::string> expected = { "a", "c", "d", "e", "b" };
+		EXPECT_TRUE(std::ranges::equal(heap_vec, expected));
+	}
+	template <class T, bool Propagate>
+	class tagged_allocator
+	{
+		template <class U, bool P>
+		friend class tagged_allocator;
+
+		std::allocator<T> allocator_;
+	public:
+		using value_type = T;
+		using propagate_on_container_copy_assignment = std::bool_constant<Propagate>;
+		using propagate_on_container_move_assignment = std::bool_constant<Propagate>;
+		using propagate_on_container_swap = std::bool_constant<Propagate>;
+		static constexpr int copy_construction_tag = 1000;
+		int tag;
+
+		explicit tagged_allocator(int tag) : tag(tag)
+		{}
+
+		template <class U>
+		tagged_allocator(const tagged_allocator<U, Propagate>& other) : tag(other.tag)
+		{}
+
+		tagged_allocator select_on_container_copy_construction() const
+		{
+			return tagged_allocator(tag + copy_construction_tag);
+		}
+
+		T* allocate(size_t n)
+		{
+			return allocator_.allocate(n);
+		}
+
+		void deallocate(T* p, size_t n)
+		{
+			allocator_.deallocate(p, n);
+		}
+
+		bool operator==(const tagged_allocator& other) const
+		{
+			return tag == other.tag;
+		}
+	};
+
+	TEST(AllocatorPropagationTest, CopyConstructionSelectsAllocator)
+	{
+		using allocator = tagged_allocator<int, false>;
+		const vector<int, allocator> vec({ 1, 2, 3 }, allocator(1));
+
+		const vector<int, allocator> copy = vec;
+
+		EXPECT_EQ(copy.get_allocator().tag, 1 + allocator::copy_construction_tag);
+		EXPECT_TRUE(std::ranges::equal(copy, vec));
+	}
+	TEST(AllocatorPropagationTest, CopyAssignmentPropagates)
+	{
+		using propagating = tagged_allocator<int, true>;
+		using sticky = tagged_allocator<int, false>;
+		const vector<int, propagating> propagating_source({ 1, 2 }, propagating(1));
+		const vector<int, sticky> sticky_source({ 1, 2 }, sticky(1));
+		vector<int, propagating> propagating_dest({ 5 }, propagating(2));
+		vector<int, sticky> sticky_dest({ 5 }, sticky(2));
+
+		propagating_dest = propagating_source;
+		sticky_dest = sticky_source;
+
+		EXPECT_EQ(propagating_dest.get_allocator().tag, 1);
+		EXPECT_EQ(sticky_dest.get_allocator().tag, 2);
+		EXPECT_TRUE(std::ranges::equal(sticky_dest, sticky_source));
+	}
+	TEST(AllocatorPropagationTest, MoveAssignmentWithUnequalAllocatorsMovesElements)
+	{
+		using allocator = tagged_allocator<std::string, false>;
+		vector<std::string, allocator> source({ "a", "b", "c" }, allocator(1));
+		vector<std::string, allocator> dest(allocator(2));
+		vector<std::string, allocator> same_tag(allocator(1));
+		const std::string* source_data = source.data();
+
+		dest = std::move(source);
+		EXPECT_EQ(dest.get_allocator().tag, 2);
+		EXPECT_NE(dest.data(), source_data);
+		EXPECT_EQ(dest.size(), 3);
+		EXPECT_EQ(dest[2], "c");
+
+		same_tag = std::move(dest);
+		EXPECT_EQ(same_tag.get_allocator().tag, 1);
+		EXPECT_EQ(same_tag[0], "a");
+	}
+	TEST(ArenaAllocatorTest, VectorsCarvedFromOneArena)
+	{
+		test_object::nullify();
+		allocator_to::nullify_alloc_count();
+
+		alignas(std::max_align_t) unsigned char buffer[4096];
+		my_vector::monotonic_arena arena(buffer, sizeof(buffer));
+		using allocator = my_vector::monotonic_arena_allocator<int>;
+		{
+			vector<int, allocator> vec{ allocator(arena) };
+			vec.reserve(4);
+			const int* data = vec.data();
+			for (int i = 0; i < 100; ++i)
+			{
+				vec.push_back(i);
+			}
+
+			// the last block in an arena grows in place
+			EXPECT_EQ(vec.data(), data);
+			EXPECT_GE(static_cast<const void*>(data), static_cast<const void*>(buffer));
+			EXPECT_LT(static_cast<const void*>(data), static_cast<const void*>(buffer + sizeof(buffer)));
+
+			vector<int, allocator> other({ 1, 2, 3 }, allocator(arena));
+			other = vec;
+			EXPECT_EQ(other.size(), 100);
+			EXPECT_EQ(other[99], 99);
+		}
+		const size_t used = arena.bytes_allocated();
+		EXPECT_GE(used, 200 * sizeof(int));
+
+		arena.release();
+		EXPECT_EQ(arena.bytes_allocated(), 0);
+
+		vector<std::string, my_vector::monotonic_arena_allocator<std::string>> strings{ my_vector::monotonic_arena_allocator<std::string>(arena) };
+		for (int i = 0; i < 2000; ++i)
+		{
+			strings.emplace_back(20, 'a');
+		}
+		EXPECT_EQ(strings[1999], std::string(20, 'a'));
+	}
+	TEST(PoolAllocatorTest, FreedBlocksAreReused)
+	{
+		my_vector::pool_resource pool;
+		using allocator = my_vector::pool_allocator<double>;
+
+		const double* first_data;
+		{
+			vector<double, allocator> vec(10, 1.5, allocator(pool));
+			first_data = vec.data();
+		}
+		vector<double, allocator> vec(12, 2.5, allocator(pool));
+		EXPECT_EQ(vec.data(), first_data);
+
+		vector<double, allocator> large(my_vector::pool_resource::max_pooled_size, 0.5, allocator(pool));
+		for (int i = 0; i < 1000; ++i)
+		{
+			vec.push_back(i);
+		}
+		EXPECT_EQ(vec.size(), 1012);
+		EXPECT_EQ(vec[11], 2.5);
+		EXPECT_EQ(vec[1011], 999);
+		EXPECT_EQ(large.back(), 0.5);
+	}
+	template <my_vector::huge_pages Pages>
+	void check_mmap_allocator()
+	{
+		constexpr my_vector::mmap_options options{ .pages = Pages, .threshold = size_t{ 1 } << 16 };
+		using allocator = my_vector::mmap_allocator<uint64_t, options>;
+
+		vector<uint64_t, allocator> small(16, 3);
+		vector<uint64_t, allocator> large(size_t{ 1 } << 17);
+		EXPECT_GE(large.capacity(), large.size());
+		for (size_t i = 0; i < large.size(); ++i)
+		{
+			ASSERT_EQ(large[i], 0);
+			large[i] = i;
+		}
+
+		// grows through mremap, then back below the threshold
+		const size_t size = large.size();
+		for (size_t i = 0; i < size; ++i)
+		{
+			large.push_back(size + i);
+		}
+		for (size_t i = 0; i < large.size(); ++i)
+		{
+			ASSERT_EQ(large[i], i);
+		}
+		for (size_t i = 0; i < 1000; ++i)
+		{
+			small.push_back(i);
+		}
+		EXPECT_EQ(small[15], 3);
+		EXPECT_EQ(small.back(), 999);
+
+		large.resize(100);
+		large.shrink_to_fit();
+		EXPECT_EQ(large.capacity(), 100);
+		EXPECT_EQ(large[99], 99);
+	}
+	TEST(MmapAllocatorTest, NormalPages)
+	{
+		check_mmap_allocator<my_vector::huge_pages::none>();
+	}
+	TEST(MmapAllocatorTest, TransparentHugePages)
+	{
+		check_mmap_allocator<my_vector::huge_pages::transparent>();
+	}
+	TEST(MmapAllocatorTest, ExplicitHugePagesFallBack)
+	{
+		check_mmap_allocator<my_vector::huge_pages::explicit_hugetlb>();
+	}
+	TEST(MmapAllocatorTest, PopulatedMappingIsAligned)
+	{
+		constexpr my_vector::mmap_options options{ .populate = true };
+		using allocator = my_vector::mmap_allocator<char, options>;
+
+		const vector<char, allocator> vec(size_t{ 3 } << 20, 'x');
+
+		EXPECT_EQ(reinterpret_cast<std::uintptr_t>(vec.data()) % allocator::huge_page_size, 0);
+		EXPECT_EQ(vec.capacity(), size_t{ 4 } << 20);
+		EXPECT_EQ(vec.back(), 'x');
+	}
+	class MmapVectorTest : public ::testing::Test
+	{
+	protected:
+		std::string path_;
+
+		void SetUp() override
+		{
+			path_ = ::testing::TempDir() + "mmap_vector_" + std::to_string(::getpid()) + ".bin";
+			std::remove(path_.c_str());
+		}
+
+		void TearDown() override
+		{
+			std::remove(path_.c_str());
+		}
+	};
+	TEST_F(MmapVectorTest, ContentsSurviveReopening)
+	{
+		struct record
+		{
+			int64_t key;
+			double value;
+		};
+		{
+			my_vector::mmap_vector<record> table(path_);
+			EXPECT_TRUE(table.empty());
+			for (int64_t i = 0; i < 10000; ++i)
+			{
+				table.push_back({ i, static_cast<double>(i) / 2 });
+			}
+			EXPECT_GE(table.capacity(), table.size());
+			table.flush();
+		}
+
+		const my_vector::mmap_vector<record> table(path_, my_vector::mmap_vector<record>::open_mode::open_existing);
+		ASSERT_EQ(table.size(), 10000);
+		EXPECT_EQ(table.front().key, 0);
+		EXPECT_EQ(table.back().value, 9999 / 2.0);
+		int64_t expected = 0;
+		for (const record& element : table)
+		{
+			ASSERT_EQ(element.key, expected++);
+		}
+	}
+	TEST_F(MmapVectorTest, GrowthKeepsElementsAndShrinks)
+	{
+		my_vector::mmap_vector<int> vec(path_);
+		vec.resize(5, 7);
+		vec.push_back(vec[0]);
+		vec.reserve(100000);
+		vec.emplace_back(9);
+		EXPECT_GE(vec.capacity(), 100000);
+
+		vec.shrink_to_fit();
+		EXPECT_LT(vec.capacity(), 2000);
+		ASSERT_EQ(vec.size(), 7);
+		EXPECT_EQ(vec[5], 7);
+		EXPECT_EQ(vec.back(), 9);
+
+		vec.pop_back();
+		vec.resize(3);
+		EXPECT_EQ(vec.size(), 3);
+		EXPECT_THROW(vec.at(3), my_vector::my_vector_exception);
+
+		// byte lengths that overflow size_t are refused instead of wrapping to a small mapping
+		EXPECT_EQ(vec.max_size(), (SIZE_MAX - my_vector::mmap_vector_header::data_offset) / sizeof(int));
+		EXPECT_THROW(vec.reserve(SIZE_MAX / 4 + 1), my_vector::my_vector_exception);
+		EXPECT_THROW(vec.resize(vec.max_size() + 1), my_vector::my_vector_exception);
+		EXPECT_EQ(vec.size(), 3);
+		EXPECT_LT(vec.capacity(), 2000);
+	}
+	TEST_F(MmapVectorTest, MovedFromIsEmpty)
+	{
+		my_vector::mmap_vector<int> vec(path_);
+		vec.push_back(1);
+		my_vector::mmap_vector<int> moved(std::move(vec));
+		EXPECT_EQ(vec.size(), 0);
+		vec.clear();
+		EXPECT_TRUE(vec.empty());
+
+		my_vector::mmap_vector<int> assigned(path_ + ".other");
+		assigned = std::move(moved);
+		moved.clear();
+		EXPECT_EQ(moved.size(), 0);
+		ASSERT_EQ(assigned.size(), 1);
+		EXPECT_EQ(assigned[0], 1);
+		std::remove((path_ + ".other").c_str());
+	}
+	TEST_F(MmapVectorTest, MismatchedFilesRejected)
+	{
+		{
+			my_vector::mmap_vector<int> vec(path_);
+			vec.push_back(1);
+		}
+
+		using open_mode = my_vector::mmap_vector<double>::open_mode;
+		EXPECT_THROW(my_vector::mmap_vector<double>{ path_ }, my_vector::my_vector_exception);
+		EXPECT_THROW(my_vector::mmap_vector<int>(path_ + ".missing", my_vector::mmap_vector<int>::open_mode::open_existing),
+			my_vector::my_vector_exception);
+
+		const my_vector::mmap_vector<double> replaced(path_, open_mode::truncate);
+		EXPECT_TRUE(replaced.empty());
+	}
+
+	TEST(SerializationTest, FileDescriptorRoundTrip)
+	{
+		int fds[2];
+		ASSERT_EQ(::pipe(fds), 0);
+		const vector<int> written{ 3, 1, 4, 1, 5, 9, 2, 6 };
+		my_vector::write_to(fds[1], written);
+		::close(fds[1]);
+
+		vector<int> read{ 42 };
+		my_vector::read_from(fds[0], read);
+		::close(fds[0]);
+		EXPECT_TRUE(std::ranges::equal(read, written));
+	}
+	TEST(SerializationTest, StreamRoundTripWithCodec)
+	{
+		std::stringstream stream;
+		const vector<std::string> written{ "", "short", std::string(1000, 'z') };
+		my_vector::write_to(stream, written);
+		const vector<double> numbers(100, 0.25);
+		my_vector::write_to(stream, numbers);
+
+		vector<std::string> read_strings;
+		my_vector::read_from(stream, read_strings);
+		vector<double> read_numbers;
+		my_vector::read_from(stream, read_numbers);
+		EXPECT_TRUE(std::ranges::equal(read_strings, written));
+		EXPECT_TRUE(std::ranges::equal(read_numbers, numbers));
+	}
+	TEST(SerializationTest, ChunkedReaderBatches)
+	{
+		int fds[2];
+		ASSERT_EQ(::pipe(fds), 0);
+		vector<int> written;
+		for (int i = 0; i < 1000; ++i)
+		{
+			written.push_back(i);
+		}
+		my_vector::write_to(fds[1], written);
+		::close(fds[1]);
+
+		my_vector::chunked_reader<int> reader(fds[0], 256);
+		vector<int> batch;
+		int expected = 0;
+		size_t batches = 0;
+		while (const size_t count = reader.next(batch))
+		{
+			EXPECT_EQ(count, batch.size());
+			EXPECT_LE(batch.capacity(), 256);
+			for (const int value : batch)
+			{
+				ASSERT_EQ(value, expected++);
+			}
+			++batches;
+		}
+		::close(fds[0]);
+		EXPECT_EQ(batches, 4);
+		EXPECT_EQ(expected, 1000);
+		EXPECT_EQ(reader.remaining(), 0);
+	}
+	TEST(SerializationTest, MismatchedInputRejected)
+	{
+		std::stringstream stream;
+		my_vector::write_to(stream, vector<int>{ 1, 2, 3 });
+		const std::string bytes = stream.str();
+
+		vector<int64_t> wrong_type;
+		std::istringstream wrong_type_input(bytes);
+		EXPECT_THROW(my_vector::read_from(wrong_type_input, wrong_type), my_vector::my_vector_exception);
+
+		std::string corrupted = bytes;
+		corrupted[0] ^= 0x20;
+		vector<int> ints;
+		std::istringstream corrupted_input(corrupted);
+		EXPECT_THROW(my_vector::read_from(corrupted_input, ints), my_vector::my_vector_exception);
+
+		std::istringstream truncated_input(bytes.substr(0, bytes.size() - 1));
+		EXPECT_THROW(my_vector::read_from(truncated_input, ints), my_vector::my_vector_exception);
+	}
+	TEST(SerializationTest, CorruptCountDoesNotAllocateUpFront)
+	{
+		// a valid header claiming 2^40 ints, followed by just one
+		std::stringstream stream;
+		my_vector::write_to(stream, vector<int>{ 7 });
+		std::string bytes = stream.str();
+		const uint64_t huge_count = uint64_t{ 1 } << 40;
+		std::memcpy(bytes.data() + offsetof(my_vector::serialized_header, count), &huge_count, sizeof(huge_count));
+
+		vector<int> ints;
+		std::istringstream stream_input(bytes);
+		EXPECT_THROW(my_vector::read_from(stream_input, ints), my_vector::my_vector_exception);
+		EXPECT_LE(ints.capacity() * sizeof(int), size_t{ 1 } << 16);
+		EXPECT_TRUE(ints.empty());
+
+		int fds[2];
+		ASSERT_EQ(::pipe(fds), 0);
+		ASSERT_EQ(::write(fds[1], bytes.data(), bytes.size()), static_cast<ssize_t>(bytes.size()));
+		::close(fds[1]);
+		EXPECT_THROW(my_vector::read_from(fds[0], ints), my_vector::my_vector_exception);
+		::close(fds[0]);
+		EXPECT_LE(ints.capacity() * sizeof(int), size_t{ 1 } << 16);
+
+		// a regular file is checked against its length before anything is reserved
+		FILE* file = std::tmpfile();
+		ASSERT_NE(file, nullptr);
+		ASSERT_EQ(std::fwrite(bytes.data(), 1, bytes.size(), file), bytes.size());
+		std::fflush(file);
+		::lseek(::fileno(file), 0, SEEK_SET);
+		vector<int> from_file;
+		EXPECT_THROW(my_vector::read_from(::fileno(file), from_file), my_vector::my_vector_exception);
+		EXPECT_EQ(from_file.capacity(), 0);
+
+		// a byte size that overflows size_t is refused outright
+		const uint64_t overflowing_count = std::numeric_limits<uint64_t>::max() / 2;
+		std::memcpy(bytes.data() + offsetof(my_vector::serialized_header, count), &overflowing_count, sizeof(overflowing_count));
+		std::istringstream overflowing_input(bytes);
+		EXPECT_THROW(my_vector::read_from(overflowing_input, ints), my_vector::my_vector_exception);
+
+		// intact input larger than the first step still reads back whole, from a stream and a file
+		vector<int> written;
+		for (int i = 0; i < 100000; ++i)
+		{
+			written.push_back(i);
+		}
+		std::stringstream large;
+		my_vector::write_to(large, written);
+		my_vector::read_from(large, ints);
+		EXPECT_TRUE(std::ranges::equal(ints, written));
+
+		ASSERT_EQ(::ftruncate(::fileno(file), 0), 0);
+		::lseek(::fileno(file), 0, SEEK_SET);
+		my_vector::write_to(::fileno(file), written);
+		::lseek(::fileno(file), 0, SEEK_SET);
+		my_vector::read_from(::fileno(file), from_file);
+		EXPECT_TRUE(std::ranges::equal(from_file, written));
+		std::fclose(file);
+	}
+
+	TEST(StatsTest, CountsPerInstance)
+	{
+		vector<int, std::allocator<int>, my_vector::counting_stats> vec;
+		uint64_t reallocations = 0;
+		uint64_t relocated = 0;
+		for (int i = 0; i < 100; ++i)
+		{
+			if (vec.size() == vec.capacity() && !vec.empty())
+			{
+				++reallocations;
+				relocated += vec.size();
+			}
+			vec.push_back(i);
+		}
+		const size_t grown_capacity = vec.capacity();
+		vec.resize(10);
+		vec.shrink_to_fit();
+
+		const my_vector::vector_stats stats = vec.stats();
+		EXPECT_EQ(stats.reallocations, reallocations + 1);
+		EXPECT_EQ(stats.elements_relocated, relocated + 10);
+		EXPECT_EQ(stats.peak_size, 100);
+		EXPECT_EQ(stats.peak_capacity, grown_capacity);
+		EXPECT_EQ(stats.live_bytes(), vec.capacity() * sizeof(int));
+		EXPECT_EQ(stats.slack_bytes, 0);
+
+		vec.pop_back();
+		EXPECT_EQ(vec.stats().slack_bytes, sizeof(int));
+
+		// stats stay with the instance
+		const auto copy = vec;
+		EXPECT_EQ(copy.stats().reallocations, 0);
+		EXPECT_EQ(copy.stats().bytes_allocated, copy.capacity() * sizeof(int));
+	}
+	struct stats_test_tag
+	{
+		static constexpr const char* name = "StatsTest.RegistryAggregatesThreads";
+	};
+	TEST(StatsTest, RegistryAggregatesThreads)
+	{
+		using tracked = vector<int, std::allocator<int>, my_vector::registered_stats<stats_test_tag>>;
+		constexpr int threads = 4;
+		constexpr int rounds = 50;
+		constexpr int elements = 1000;
+
+		uint64_t reallocations_per_vector = 0;
+		{
+			tracked probe;
+			for (int i = 0; i < elements; ++i)
+			{
+				probe.push_back(i);
+			}
+			reallocations_per_vector = probe.stats().reallocations;
+		}
+
+		std::vector<std::thread> workers;
+		for (int t = 0; t < threads; ++t)
+		{
+			workers.emplace_back([]
+			{
+				for (int round = 0; round < rounds; ++round)
+				{
+					tracked vec;
+					for (int i = 0; i < elements; ++i)
+					{
+						vec.push_back(i);
+					}
+				}
+			});
+		}
+		for (std::thread& worker : workers)
+		{
+			worker.join();
+		}
+
+		bool found = false;
+		my_vector::stats_registry::global().for_each([&](const std::string& name, const my_vector::vector_stats& stats)
+		{
+			if (name != stats_test_tag::name)
+			{
+				return;
+			}
+			found = true;
+			EXPECT_EQ(stats.reallocations, reallocations_per_vector * (threads * rounds + 1));
+			EXPECT_EQ(stats.live_bytes(), 0);
+			EXPECT_EQ(stats.slack_bytes, 0);
+			EXPECT_EQ(stats.peak_size, elements);
+			EXPECT_GE(stats.peak_capacity, elements);
+		});
+		EXPECT_TRUE(found);
+	}
+
+	TEST(ConcurrentVectorTest, ReferencesStayValid)
+	{
+		my_vector::concurrent_vector<std::string> vec;
+		std::vector<std::string*> addresses;
+		for (int i = 0; i < 1000; ++i)
+		{
+			addresses.push_back(&vec.emplace_back(std::to_string(i)));
+		}
+		ASSERT_EQ(vec.size(), 1000);
+		EXPECT_GE(vec.capacity(), 1000);
+		for (int i = 0; i < 1000; ++i)
+		{
+			ASSERT_EQ(addresses[i], &vec[i]);
+			ASSERT_EQ(*addresses[i], std::to_string(i));
+		}
+		EXPECT_EQ(std::distance(vec.begin(), vec.end()), 1000);
+		EXPECT_EQ(*(vec.cbegin() + 999), "999");
+		EXPECT_THROW(vec.at(1000), my_vector::my_vector_exception);
+	}
+	TEST(ConcurrentVectorTest, ConcurrentAppendsAndReads)
+	{
+		constexpr uint64_t writers = 8;
+		constexpr uint64_t per_writer = 20000;
+		my_vector::concurrent_vector<uint64_t> vec;
+		std::atomic<bool> done{ false };
+
+		// published elements must always be fully written, even while the vector grows
+		std::thread reader([&]
+		{
+			while (!done.load())
+			{
+				const size_t size = vec.size();
+				for (size_t i = size > 64 ? size - 64 : 0; i < size; ++i)
+				{
+					ASSERT_NE(vec[i], 0);
+				}
+			}
+		});
+
+		std::vector<std::thread> threads;
+		for (uint64_t writer = 0; writer < writers; ++writer)
+		{
+			threads.emplace_back([&, writer]
+			{
+				for (uint64_t i = 0; i < per_writer; ++i)
+				{
+					ASSERT_EQ(vec.emplace_back((writer + 1) << 32 | i) >> 32, writer + 1);
+				}
+			});
+		}
+		for (std::thread& thread : threads)
+		{
+			thread.join();
+		}
+		done.store(true);
+		reader.join();
+
+		ASSERT_EQ(vec.size(), writers * per_writer);
+		std::vector<uint64_t> next(writers, 0);
+		for (const uint64_t value : vec)
+		{
+			const uint64_t writer = (value >> 32) - 1;
+			ASSERT_LT(writer, writers);
+			// each writer's elements appear in the order it appended them
+			ASSERT_EQ(value & 0xffffffff, next[writer]++);
+		}
+	}
+
+	TEST(SegmentedVectorTest, GrowthNeverMovesElements)
+	{
+		my_vector::segmented_vector<test_object, allocator_to> vec;
+		std::vector<const test_object*> addresses;
+		test_object::nullify();
+		for (int i = 0; i < 1000; ++i)
+		{
+			addresses.push_back(&vec.emplace_back(i));
+		}
+		EXPECT_EQ(test_object::get_moves_count(), 0);
+		EXPECT_EQ(test_object::get_copy_count(), 0);
+		EXPECT_GE(vec.capacity(), vec.size());
+		for (int i = 0; i < 1000; ++i)
+		{
+			ASSERT_EQ(addresses[i], &vec[i]);
+			ASSERT_EQ(*vec[i].get_id(), i);
+		}
+
+		vec.resize(10);
+		vec.shrink_to_fit();
+		EXPECT_EQ(vec.capacity(), 16);
+		EXPECT_EQ(addresses[9], &vec.back());
+		EXPECT_THROW(vec.at(10), my_vector::my_vector_exception);
+	}
+	TEST(SegmentedVectorTest, RandomAccessIteration)
+	{
+		my_vector::segmented_vector<int> vec;
+		for (int i = 0; i < 100; ++i)
+		{
+			vec.push_back(99 - i);
+		}
+		std::sort(vec.begin(), vec.end());
+		EXPECT_TRUE(std::is_sorted(vec.cbegin(), vec.cend()));
+		EXPECT_EQ(vec.end() - vec.begin(), 100);
+		EXPECT_EQ(vec.begin()[50], 50);
+		EXPECT_EQ(*std::lower_bound(vec.begin(), vec.end(), 42), 42);
+
+		const my_vector::segmented_vector<int> copy = vec;
+		EXPECT_TRUE(std::ranges::equal(copy, vec));
+		my_vector::segmented_vector<int> moved = std::move(vec);
+		EXPECT_TRUE(vec.empty());
+		EXPECT_EQ(moved.size(), 100);
+		moved.swap(vec);
+		EXPECT_EQ(vec.back(), 99);
+	}
+
+	TEST(ParallelTest, FillReduceAndForEach)
+	{
+		my_vector::par::thread_pool pool(4);
+		vector<int64_t> vec(1000003);
+		my_vector::par::fill(pool, vec, int64_t{ 3 });
+		EXPECT_EQ(my_vector::par::reduce(pool, vec, int64_t{ 0 }), 3 * 1000003);
+
+		my_vector::par::for_each(pool, vec, [](int64_t& value) { value *= 2; });
+		EXPECT_EQ(std::ranges::count(vec, 6), 1000003);
+		EXPECT_EQ(my_vector::par::reduce(pool, vec, int64_t{ 1 }, [](int64_t a, int64_t b) { return a > b ? a : b; }), 6);
+
+		// algorithms may be nested inside pool tasks
+		vector<int64_t> sums(8, 0);
+		my_vector::par::for_each(pool, sums, [&](int64_t& sum)
+		{
+			sum = my_vector::par::reduce(pool, vec, int64_t{ 0 });
+		});
+		EXPECT_EQ(std::ranges::count(sums, 6 * 1000003), 8);
+	}
+	TEST(ParallelTest, ConstructionAndTransform)
+	{
+		my_vector::par::thread_pool pool(4);
+		vector<double> values;
+		my_vector::par::resize(pool, values, 500000, 1.5);
+		my_vector::par::resize(pool, values, 600000);
+		ASSERT_EQ(values.size(), 600000);
+		EXPECT_EQ(values[499999], 1.5);
+		EXPECT_EQ(values[500000], 0.0);
+
+		vector<int> numbers(100000);
+		for (size_t i = 0; i < numbers.size(); ++i)
+		{
+			numbers[i] = static_cast<int>(i);
+		}
+		vector<std::string> strings{ "stale" };
+		my_vector::par::transform(pool, numbers, strings, [](int n) { return std::to_string(n); });
+		ASSERT_EQ(strings.size(), numbers.size());
+		EXPECT_EQ(strings[0], "0");
+		EXPECT_EQ(strings[99999], "99999");
+	}
+	TEST(ParallelTest, ThrowingTransformLeavesOutputEmpty)
+	{
+		static std::atomic<int> live{ 0 };
+		struct counted
+		{
+			explicit counted(int) { ++live; }
+			counted(const counted&) { ++live; }
+			~counted() { --live; }
+		};
+
+		my_vector::par::thread_pool pool(4);
+		vector<int> numbers(200000, 1);
+		numbers[150000] = -1;
+		vector<counted> out;
+		EXPECT_THROW(my_vector::par::transform(pool, numbers, out, [](int n)
+		{
+			if (n < 0)
+			{
+				throw my_vector::my_vector_exception("negative");
+			}
+			return counted(n);
+		}), my_vector::my_vector_exception);
+		EXPECT_TRUE(out.empty());
+		EXPECT_EQ(live.load(), 0);
+	}
+	TEST(ParallelTest, SortMatchesSequentialSort)
+	{
+		my_vector::par::thread_pool pool(3);
+		vector<uint32_t> vec;
+		uint32_t state = 12345;
+		for (int i = 0; i < 300001; ++i)
+		{
+			state = state * 1664525u + 1013904223u;
+			vec.push_back(state >> 8);
+		}
+		vector<uint32_t> expected = vec;
+		std::sort(expected.begin(), expected.end(), std::greater<>());
+
+		my_vector::par::sort(pool, vec, std::greater<>());
+		EXPECT_TRUE(std::ranges::equal(vec, expected));
+	}
+
+	template <class T>
+	class SimdTest : public ::testing::Test
+	{
+	protected:
+		// Small integral values, so floating-point sums and dot products are exact and
+		// every instruction set must agree with the scalar reference
+		static vector<T> make_values(size_t count, uint32_t seed)
+		{
+			vector<T> values;
+			for (size_t i = 0; i < count; ++i)
+			{
+				seed = seed * 1664525u + 1013904223u;
+				values.push_back(static_cast<T>(static_cast<int>(seed >> 24) - 100));
+			}
+			return values;
+		}
+
+		// Runs check once per instruction set this machine supports
+		template <class F>
+		static void for_each_instruction_set(F check)
+		{
+			using my_vector::simd::instruction_set;
+			const instruction_set detected = my_vector::simd::detected_instruction_set();
+			for (auto set : { instruction_set::scalar, instruction_set::sse4_2, instruction_set::avx2, instruction_set::avx512 })
+			{
+				if (set <= detected)
+				{
+					my_vector::simd::limit_instruction_set(set);
+					SCOPED_TRACE(static_cast<int>(set));
+					check();
+				}
+			}
+			my_vector::simd::limit_instruction_set(detected);
+		}
+	};
+	using simd_types = ::testing::Types<int32_t, float, double>;
+	TYPED_TEST_SUITE(SimdTest, simd_types);
+
+	TYPED_TEST(SimdTest, SearchAndReductionsMatchScalarLoops)
+	{
+		using T = TypeParam;
+		for (const size_t count : { 0, 1, 7, 16, 33, 1003 })
+		{
+			const vector<T> left = this->make_values(count, 7);
+			const vector<T> right = this->make_values(count, 11);
+			const T missing = static_cast<T>(1000);
+			const T last = count > 0 ? left[count - 1] : T();
+
+			T sum = T();
+			T dot = T();
+			for (size_t i = 0; i < count; ++i)
+			{
+				sum += left[i];
+				dot += left[i] * right[i];
+			}
+
+			this->for_each_instruction_set([&]
+			{
+				EXPECT_EQ(my_vector::simd::find(left, missing), left.end());
+				EXPECT_FALSE(my_vector::simd::contains(left, missing));
+				EXPECT_EQ(my_vector::simd::count(left, missing), 0);
+				EXPECT_EQ(my_vector::simd::sum(left), sum);
+				EXPECT_EQ(my_vector::simd::dot(left, right), dot);
+				if (count > 0)
+				{
+					EXPECT_EQ(my_vector::simd::find(left, last), std::find(left.begin(), left.end(), last));
+					EXPECT_TRUE(my_vector::simd::contains(left, last));
+					EXPECT_EQ(my_vector::simd::count(left, last), static_cast<size_t>(std::count(left.begin(), left.end(), last)));
+					EXPECT_EQ(my_vector::simd::min(left), *std::min_element(left.begin(), left.end()));
+					EXPECT_EQ(my_vector::simd::max(left), *std::max_element(left.begin(), left.end()));
+				}
+				else
+				{
+					EXPECT_THROW(my_vector::simd::minmax(left), my_vector::my_vector_exception);
+				}
+			});
+		}
+	}
+	TYPED_TEST(SimdTest, ElementwiseOperationsMatchScalarLoops)
+	{
+		using T = TypeParam;
+		const vector<T> left = this->make_values(101, 3);
+		const vector<T> right = this->make_values(101, 5);
+		this->for_each_instruction_set([&]
+		{
+			vector<T> sums = left;
+			my_vector::simd::add(sums, right);
+			vector<T> scaled = left;
+			my_vector::simd::scale(scaled, static_cast<T>(-3));
+			for (size_t i = 0; i < left.size(); ++i)
+			{
+				EXPECT_EQ(sums[i], static_cast<T>(left[i] + right[i]));
+				EXPECT_EQ(scaled[i], static_cast<T>(left[i] * -3));
+			}
+
+			vector<T> shorter(100);
+			EXPECT_THROW(my_vector::simd::add(shorter, right), my_vector::my_vector_exception);
+			EXPECT_THROW(my_vector::simd::dot(shorter, right), my_vector::my_vector_exception);
+		});
+	}
+	TYPED_TEST(SimdTest, RemoveMatchesStdRemove)
+	{
+		using T = TypeParam;
+		// lengths around the SSE, AVX2 and AVX-512 widths exercise both the compress and the tail loop
+		for (size_t size = 0; size < 70; ++size)
+		{
+			vector<T> values;
+			for (size_t i = 0; i < size; ++i)
+			{
+				values.push_back(static_cast<T>(i * 7 % 5));
+			}
+			std::vector<T> expected(values.begin(), values.end());
+			const size_t erased = std::erase(expected, static_cast<T>(3));
+
+			this->for_each_instruction_set([&]
+			{
+				vector<T> removed = values;
+				const auto end = my_vector::simd::remove(removed, static_cast<T>(3));
+				EXPECT_TRUE(std::equal(removed.begin(), end, expected.begin(), expected.end()));
+
+				vector<T> erased_from = values;
+				EXPECT_EQ(erased_from.erase_value(static_cast<T>(3)), erased);
+				EXPECT_TRUE(std::ranges::equal(erased_from, expected));
+			});
+		}
+
+		const vector<T> values = this->make_values(1003, 7);
+		std::vector<T> expected(values.begin(), values.end());
+		std::erase(expected, values[0]);
+		this->for_each_instruction_set([&]
+		{
+			vector<T> erased_from = values;
+			erased_from.erase_value(values[0]);
+			EXPECT_TRUE(std::ranges::equal(erased_from, expected));
+		});
+	}
+	TEST(SimdArithmeticTest, TypesWithoutKernelsUseScalarLoops)
+	{
+		const auto check = []<class T>(T)
+		{
+			const vector<T> left = { 5, 3, 9, 3, 1 };
+			const vector<T> right = { 1, 2, 3, 4, 5 };
+			EXPECT_EQ(my_vector::simd::find(left, T{ 3 }), left.begin() + 1);
+			EXPECT_EQ(my_vector::simd::count(left, T{ 3 }), 2);
+			EXPECT_FALSE(my_vector::simd::contains(left, T{ 4 }));
+			EXPECT_EQ(my_vector::simd::sum(left), T{ 21 });
+			EXPECT_EQ(my_vector::simd::min(left), T{ 1 });
+			EXPECT_EQ(my_vector::simd::max(left), T{ 9 });
+			EXPECT_EQ(my_vector::simd::dot(left, right), T{ 55 });
+
+			vector<T> values = left;
+			my_vector::simd::add(values, right);
+			my_vector::simd::scale(values, T{ 2 });
+			EXPECT_TRUE(std::ranges::equal(values, std::vector<T>{ 12, 10, 24, 14, 12 }));
+			values.erase(my_vector::simd::remove(values, T{ 12 }), values.end());
+			EXPECT_TRUE(std::ranges::equal(values, std::vector<T>{ 10, 24, 14 }));
+		};
+		check(uint64_t{});
+		check(int64_t{});
+		check(int16_t{});
+	}
+	TEST(SimdArithmeticTest, IntegerArithmeticWraps)
+	{
+		const vector<int32_t> values(64, std::numeric_limits<int32_t>::max());
+		EXPECT_EQ(my_vector::simd::sum(values), -64);
+		EXPECT_EQ(my_vector::simd::dot(values, values), 64);
+	}
+	// Capacities a vector with growth policy Growth_T passes through while count elements are pushed
+	template <class Growth_T>
+	std::vector<size_t> capacity_steps(size_t count)
+	{
+		my_vector::vector<int, std::allocator<int>, my_vector::no_stats, Growth_T> vec;
+		std::vector<size_t> steps;
+		for (size_t i = 0; i < count; ++i)
+		{
+			vec.push_back(static_cast<int>(i));
+			if (steps.empty() || steps.back() != vec.capacity())
+			{
+				steps.push_back(vec.capacity());
+			}
+		}
+		return steps;
+	}
+	TEST(GrowthPolicyTest, GeometricAndAdditive)
+	{
+		EXPECT_EQ(capacity_steps<my_vector::default_growth>(20), (std::vector<size_t>{ 1, 2, 3, 4, 6, 9, 13, 19, 28 }));
+		EXPECT_EQ(capacity_steps<my_vector::factor_growth<2>>(20), (std::vector<size_t>{ 1, 2, 4, 8, 16, 32 }));
+		EXPECT_EQ(capacity_steps<my_vector::additive_growth<8>>(20), (std::vector<size_t>{ 8, 16, 24 }));
+
+		// insert of many elements still jumps straight to the size needed
+		const std::vector<int> many(100, 7);
+		my_vector::vector<int, std::allocator<int>, my_vector::no_stats, my_vector::additive_growth<8>> vec(3);
+		vec.insert(vec.end(), many.begin(), many.end());
+		EXPECT_EQ(vec.capacity(), 103);
+	}
+	TEST(GrowthPolicyTest, PageRoundedAndCapped)
+	{
+		for (const size_t capacity : capacity_steps<my_vector::page_rounded_growth<4096>>(10000))
+		{
+			EXPECT_TRUE(capacity * sizeof(int) < 4096 || capacity * sizeof(int) % 4096 == 0) << capacity;
+		}
+
+		// 1.5x up to 1024 ints (4 KiB), then 1024 more at a time
+		const std::vector<size_t> capped = capacity_steps<my_vector::capped_geometric_growth<4096>>(5000);
+		ASSERT_GE(capped.size(), 4);
+		const size_t* tail = capped.data() + capped.size() - 4;
+		EXPECT_EQ(tail[0], 2048);
+		EXPECT_EQ(tail[1], 3072);
+		EXPECT_EQ(tail[2], 4096);
+		EXPECT_EQ(tail[3], 5120);
+		EXPECT_EQ(std::ranges::count(capped, 1024), 1);
+	}
+	TEST(CowVectorTest, CopiesShareUntilMutated)
+	{
+		my_vector::cow_vector<std::string> original{ "a", "b", "c" };
+		const my_vector::cow_vector<std::string> snapshot = original;
+		EXPECT_EQ(original.use_count(), 2);
+		EXPECT_EQ(std::as_const(original).data(), snapshot.data());
+
+		original.push_back("d");
+		EXPECT_EQ(original.use_count(), 1);
+		EXPECT_EQ(snapshot.use_count(), 1);
+		EXPECT_NE(std::as_const(original).data(), snapshot.data());
+		ASSERT_EQ(snapshot.size(), 3);
+		EXPECT_EQ(snapshot[2], "c");
+		EXPECT_EQ(original[3], "d");
+
+		// a sole owner mutates in place
+		const std::string* before = std::as_const(original).data();
+		original[0] = "z";
+		EXPECT_EQ(std::as_const(original).data(), before);
+		EXPECT_EQ(snapshot[0], "a");
+
+		my_vector::cow_vector<std::string> cleared = snapshot;
+		cleared.clear();
+		EXPECT_TRUE(cleared.empty());
+		EXPECT_EQ(cleared.use_count(), 0);
+		EXPECT_EQ(snapshot.use_count(), 1);
+		EXPECT_THROW(cleared.pop_back(), my_vector::my_vector_exception);
+	}
+	TEST(CowVectorTest, CopiesAreFreeUntilAWrite)
+	{
+		test_object::nullify();
+		test_allocator<test_object>::nullify_alloc_count();
+		{
+			vector_to items;
+			items.reserve(2);
+			items.emplace_back(1);
+			items.emplace_back(2);
+			my_vector::cow_vector<test_object, allocator_to> first(std::move(items));
+			my_vector::cow_vector<test_object, allocator_to> second = first;
+			my_vector::cow_vector<test_object, allocator_to> third = second;
+			EXPECT_EQ(first.use_count(), 3);
+			EXPECT_EQ(test_object::get_copy_count(), 0);
+			EXPECT_EQ(test_allocator<test_object>::get_allocated(), 2);
+
+			third.emplace_back(3);
+			EXPECT_EQ(test_object::get_copy_count(), 2);
+			EXPECT_EQ(first.use_count(), 2);
+			EXPECT_EQ(first.size(), 2);
+			EXPECT_EQ(*third.back().get_id(), 3);
+		}
+		EXPECT_EQ(test_allocator<test_object>::get_allocated(), test_allocator<test_object>::get_deallocated());
+		EXPECT_EQ(test_object::get_current_allocated_objects(), 0);
+	}
+	TEST(CowVectorTest, ThreadsShareAndDetachCopies)
+	{
+		my_vector::cow_vector<int> shared(1000, 1);
+		std::atomic<long> total{ 0 };
+		std::vector<std::thread> threads;
+		for (int t = 0; t < 4; ++t)
+		{
+			threads.emplace_back([&shared, &total, t]
+			{
+				for (int round = 0; round < 200; ++round)
+				{
+					my_vector::cow_vector<int> copy = shared;
+					long sum = 0;
+					for (const int value : std::as_const(copy))
+					{
+						sum += value;
+					}
+					if (round % 10 == 0)
+					{
+						copy[0] = t;
+						sum += copy[0] - 1;
+					}
+					total += sum;
+				}
+			});
+		}
+		for (std::thread& thread : threads)
+		{
+			thread.join();
+		}
+		EXPECT_EQ(total.load(), 4 * 200 * 1000 + (0 + 1 + 2 + 3 - 4) * 20);
+		EXPECT_EQ(shared.use_count(), 1);
+		EXPECT_EQ(shared[0], 1);
+	}
+	TEST(SoaVectorTest, ColumnsStayContiguousThroughGrowth)
+	{
+		my_vector::soa_vector<int, double, char> soa;
+		for (int i = 0; i < 1000; ++i)
+		{
+			soa.emplace_back(i, i * 0.5, static_cast<char>('a' + i % 26));
+		}
+		ASSERT_EQ(soa.size(), 1000);
+		const std::span<const int> ids = std::as_const(soa).column<0>();
+		const std::span<double> weights = soa.column<1>();
+		ASSERT_EQ(ids.size(), 1000);
+		EXPECT_EQ(reinterpret_cast<std::uintptr_t>(ids.data()) % 64, 0);
+		EXPECT_EQ(reinterpret_cast<std::uintptr_t>(weights.data()) % 64, 0);
+		EXPECT_EQ(reinterpret_cast<std::uintptr_t>(soa.column<2>().data()) % 64, 0);
+		for (int i = 0; i < 1000; ++i)
+		{
+			EXPECT_EQ(ids[i], i);
+			EXPECT_EQ(weights[i], i * 0.5);
+		}
+
+		// row-wise code goes through proxy references
+		for (auto [id, weight, letter] : soa)
+		{
+			weight += id;
+			letter = 'z';
+		}
+		EXPECT_EQ(std::get<1>(soa[10]), 15.0);
+		EXPECT_EQ(std::get<2>(soa.at(999)), 'z');
+		const auto found = std::find_if(soa.cbegin(), soa.cend(), [](const auto& row) { return std::get<0>(row) == 500; });
+		EXPECT_EQ(found - soa.cbegin(), 500);
+		EXPECT_THROW(soa.at(1000), my_vector::my_vector_exception);
+	}
+	TEST(SoaVectorTest, CopyResizeAndPop)
+	{
+		my_vector::soa_vector<std::string, int> soa;
+		soa.push_back({ "first", 1 });
+		soa.emplace_back("second", 2);
+		my_vector::soa_vector<std::string, int> copy = soa;
+		std::get<0>(copy[0]) = "changed";
+		EXPECT_EQ(std::get<0>(soa[0]), "first");
+
+		copy.resize(5);
+		EXPECT_EQ(copy.size(), 5);
+		EXPECT_EQ(std::get<0>(copy[4]), "");
+		EXPECT_EQ(std::get<1>(copy[4]), 0);
+		copy.pop_back();
+		copy.shrink_to_fit();
+		EXPECT_EQ(copy.capacity(), 4);
+		EXPECT_EQ(std::get<0>(copy[1]), "second");
+
+		soa = std::move(copy);
+		EXPECT_EQ(soa.size(), 4);
+		EXPECT_TRUE(copy.empty());
+		soa.clear();
+		EXPECT_THROW(soa.pop_back(), my_vector::my_vector_exception);
+	}
+	TEST(SoaVectorTest, ThrowingFieldLeavesNoPartialRow)
+	{
+		test_object::nullify();
+		{
+			my_vector::soa_vector<test_object, std::vector<int>> soa;
+			soa.emplace_back(test_object(1), std::vector<int>{ 1 });
+			EXPECT_THROW(soa.emplace_back(test_object(2), std::numeric_limits<size_t>::max()), std::length_error);
+			EXPECT_EQ(soa.size(), 1);
+		}
+		EXPECT_EQ(test_object::get_current_allocated_objects(), 0);
+	}
+	TEST(BitVectorTest, MatchesUnpackedBools)
+	{
+		// random edits mirrored on an unpacked vector<bool>
+		my_vector::bit_vector<> bits;
+		my_vector::vector<bool> bools;
+		uint64_t state = 7;
+		for (int step = 0; step < 3000; ++step)
+		{
+			state = state * 6364136223846793005ULL + 1442695040888963407ULL;
+			const size_t roll = state >> 33;
+			if (roll % 10 < 6 || bools.empty())
+			{
+				bits.push_back(roll % 3 == 0);
+				bools.push_back(roll % 3 == 0);
+			}
+			else if (roll % 10 < 8)
+			{
+				const size_t index = roll % bools.size();
+				bits[index] = !bits[index];
+				bools[index] = !bools[index];
+			}
+			else if (roll % 10 == 8)
+			{
+				const size_t new_size = roll % 300;
+				bits.resize(new_size, roll % 2 == 0);
+				bools.resize(new_size, roll % 2 == 0);
+			}
+			else
+			{
+				bits.pop_back();
+				bools.pop_back();
+			}
+		}
+		ASSERT_EQ(bits.size(), bools.size());
+		EXPECT_TRUE(std::equal(bits.begin(), bits.end(), bools.begin(), bools.end()));
+		EXPECT_EQ(bits.count(), static_cast<size_t>(std::count(bools.begin(), bools.end(), true)));
+
+		std::vector<size_t> expected;
+		for (size_t i = 0; i < bools.size(); ++i)
+		{
+			if (bools[i])
+			{
+				expected.push_back(i);
+			}
+		}
+		std::vector<size_t> found;
+		for (size_t i = bits.find_first(); i != bits.npos; i = bits.find_next(i))
+		{
+			found.push_back(i);
+		}
+		EXPECT_EQ(found, expected);
+
+		bits.flip();
+		EXPECT_EQ(bits.count(), bools.size() - expected.size());
+		bits.assign(true);
+		EXPECT_TRUE(bits.all());
+	}
+	TEST(BitVectorTest, WordwiseOperators)
+	{
+		my_vector::bit_vector<> left(130);
+		my_vector::bit_vector<> right(130, true);
+		for (size_t i = 0; i < 130; i += 3)
+		{
+			left[i] = true;
+		}
+		right[0] = false;
+		right[129] = false;
+
+		const my_vector::bit_vector<> both = left & right;
+		const my_vector::bit_vector<> either = left | right;
+		const my_vector::bit_vector<> one = left ^ right;
+		for (size_t i = 0; i < 130; ++i)
+		{
+			EXPECT_EQ(both[i], left[i] && right[i]);
+			EXPECT_EQ(either[i], left[i] || right[i]);
+			EXPECT_EQ(one[i], left[i] != right[i]);
+		}
+		EXPECT_EQ(~~left, left);
+		EXPECT_EQ((~right).count(), 2);
+		EXPECT_TRUE(my_vector::bit_vector<>(left).subtract(left).none());
+		EXPECT_EQ(both.find_next(0), 3);
+		EXPECT_EQ(both.find_next(129), both.npos);
+
+		my_vector::bit_vector<> shorter{ true, false, true };
+		EXPECT_EQ(shorter.count(), 2);
+		EXPECT_THROW(left &= shorter, my_vector::my_vector_exception);
+		EXPECT_THROW(shorter.at(3), my_vector::my_vector_exception);
+		shorter.clear();
+		EXPECT_FALSE(shorter.any());
+		EXPECT_EQ(shorter.find_first(), shorter.npos);
+		EXPECT_THROW(shorter.pop_back(), my_vector::my_vector_exception);
+	}
+	// Tables computed in constant evaluation; a failure here is a compile error
+	constexpr my_vector::vector<int> primes_below(int limit)
+	{
+		my_vector::vector<bool> composite(limit, false);
+		my_vector::vector<int> primes;
+		for (int i = 2; i < limit; ++i)
+		{
+			if (!composite[i])
+			{
+				primes.push_back(i);
+				for (int multiple = i * i; multiple < limit; multiple += i)
+				{
+					composite[multiple] = true;
+				}
+			}
+		}
+		return primes;
+	}
+
+	constexpr int edited_sum()
+	{
+		my_vector::vector<int> vec(10, 1);
+		vec.reserve(100);
+		const std::array<int, 3> extra{ 5, 6, 7 };
+		vec.insert(vec.cbegin() + 2, extra.begin(), extra.end());
+		vec.erase(vec.cbegin(), vec.cbegin() + 2);
+		vec.push_back(9);
+		vec.erase_value(9);
+		vec.resize(20);
+		vec.shrink_to_fit();
+		my_vector::vector<int> copy = vec;
+		copy.pop_back();
+		vec = std::move(copy);
+		int sum = 0;
+		for (const int value : vec)
+		{
+			sum += value;
+		}
+		return sum + static_cast<int>(vec.size() * 100);
+	}
+
+	constexpr size_t string_lengths()
+	{
+		my_vector::vector<std::string> words{ "alpha", "beta" };
+		words.emplace_back(3, 'x');
+		const std::array<std::string, 2> front{ "a", "bb" };
+		words.insert(words.cbegin(), front.begin(), front.end());
+		words.erase(words.cbegin() + 1);
+		size_t total = 0;
+		for (const std::string& word : words)
+		{
+			total += word.size();
+		}
+		return total * 10 + words.size();
+	}
+
+	static_assert(primes_below(30).size() == 10);
+	static_assert(primes_below(30).back() == 29);
+	static_assert(edited_sum() == 5 + 6 + 7 + 8 + 1900);
+	static_assert(string_lengths() == 134);
+
+	constexpr auto build_primes = [] { return primes_below(100); };
+	constexpr auto primes_table = my_vector::to_array<build_primes>();
+	static_assert(primes_table.size() == 25);
+	static_assert(primes_table[24] == 97);
+
+	TEST(ConstexprVectorTest, StaticTableIsBakedIn)
+	{
+		constexpr std::span<const int, 25> primes = my_vector::static_span<build_primes>;
+		EXPECT_TRUE(std::equal(primes.begin(), primes.end(), primes_table.begin()));
+		EXPECT_EQ(primes.data(), my_vector::static_table<build_primes>.data());
+		const my_vector::vector<int> runtime = primes_below(100);
+		EXPECT_TRUE(std::equal(runtime.begin(), runtime.end(), primes.begin(), primes.end()));
+	}
+	TEST(StaticVectorTest, InlineStorageAndBoundedGrowth)
+	{
+		test_object::nullify();
+		{
+			my_vector::static_vector<test_object, 4> vec;
+			vec.emplace_back(1);
+			vec.push_back(test_object(2));
+			ASSERT_NE(vec.try_emplace_back(3), nullptr);
+			EXPECT_EQ(*vec.back().get_id(), 3);
+			vec.resize(4);
+			EXPECT_TRUE(vec.full());
+
+			// a full vector refuses softly or loudly, and stays as it was
+			EXPECT_EQ(vec.try_emplace_back(5), nullptr);
+			EXPECT_THROW(vec.emplace_back(5), my_vector::my_vector_exception);
+			EXPECT_THROW(vec.resize(5), my_vector::my_vector_exception);
+			EXPECT_EQ(vec.size(), 4);
+			EXPECT_EQ(test_object::get_current_allocated_objects(), 4);
+
+			const std::array<test_object, 1> extra{ test_object(9) };
+			vec.erase(vec.cbegin());
+			vec.insert(vec.cbegin() + 1, extra.begin(), extra.end());
+			EXPECT_EQ(*vec[0].get_id(), 2);
+			EXPECT_EQ(*vec[1].get_id(), 9);
+			EXPECT_EQ(*vec.at(2).get_id(), 3);
+			EXPECT_THROW(vec.at(4), my_vector::my_vector_exception);
+
+			my_vector::static_vector<test_object, 4> copy = vec;
+			copy.pop_back();
+			copy.swap(vec);
+			EXPECT_EQ(copy.size(), 4);
+			EXPECT_EQ(vec.size(), 3);
+			vec = copy;
+			EXPECT_TRUE(std::equal(vec.begin(), vec.end(), copy.begin(), copy.end()));
+		}
+		EXPECT_EQ(test_object::get_current_allocated_objects(), 0);
+	}
+	TEST(StaticVectorTest, TriviallyCopyableWithTrivialElements)
+	{
+		using routes = my_vector::static_vector<uint32_t, 16>;
+		static_assert(std::is_trivially_copyable_v<routes>);
+		static_assert(!std::is_trivially_copyable_v<my_vector::static_vector<std::string, 16>>);
+		static_assert(sizeof(routes) == 16 * sizeof(uint32_t) + sizeof(size_t));
+
+		routes table = { 10, 20, 30 };
+		alignas(routes) unsigned char shared[sizeof(routes)];
+		std::memcpy(shared, &table, sizeof(routes));
+		routes restored;
+		std::memcpy(&restored, shared, sizeof(routes));
+
+		ASSERT_EQ(restored.size(), 3);
+		EXPECT_EQ(restored[2], 30);
+		EXPECT_TRUE(std::ranges::equal(restored, table));
+	}
 }